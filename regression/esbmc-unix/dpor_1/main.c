@@ -0,0 +1,33 @@
+#include <assert.h>
+#include <pthread.h>
+
+int a, b, c;
+int flag, data;
+
+void *producer(void *arg)
+{
+  a = 1;
+  b = 2;
+  // Published before the data it guards
+  flag = 1;
+  data = 42;
+  return NULL;
+}
+
+void *consumer(void *arg)
+{
+  c = 3;
+  if (flag)
+    assert(data == 42);
+  return NULL;
+}
+
+int main()
+{
+  pthread_t t1, t2;
+  pthread_create(&t1, NULL, producer, NULL);
+  pthread_create(&t2, NULL, consumer, NULL);
+  pthread_join(t1, NULL);
+  pthread_join(t2, NULL);
+  return 0;
+}
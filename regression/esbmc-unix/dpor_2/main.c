@@ -0,0 +1,42 @@
+#include <assert.h>
+#include <pthread.h>
+
+// Every thread only touches globals of its own, so all orders of their
+// accesses are equivalent and one of them is enough
+int x1, y1, x2, y2, x3, y3;
+
+void *t1(void *arg)
+{
+  x1 = 1;
+  y1 = x1 + 1;
+  assert(y1 == 2);
+  return NULL;
+}
+
+void *t2(void *arg)
+{
+  x2 = 2;
+  y2 = x2 + 1;
+  assert(y2 == 3);
+  return NULL;
+}
+
+void *t3(void *arg)
+{
+  x3 = 3;
+  y3 = x3 + 1;
+  assert(y3 == 4);
+  return NULL;
+}
+
+int main()
+{
+  pthread_t a, b, c;
+  pthread_create(&a, NULL, t1, NULL);
+  pthread_create(&b, NULL, t2, NULL);
+  pthread_create(&c, NULL, t3, NULL);
+  pthread_join(a, NULL);
+  pthread_join(b, NULL);
+  pthread_join(c, NULL);
+  return 0;
+}
@@ -0,0 +1,24 @@
+#include <assert.h>
+#include <pthread.h>
+
+int x;
+
+void *increment(void *arg)
+{
+  // Each thread only reaches x through its argument
+  int *p = arg;
+  int tmp = *p;
+  *p = tmp + 1;
+  return NULL;
+}
+
+int main()
+{
+  pthread_t t1, t2;
+  pthread_create(&t1, NULL, increment, &x);
+  pthread_create(&t2, NULL, increment, &x);
+  pthread_join(t1, NULL);
+  pthread_join(t2, NULL);
+  assert(x == 2);
+  return 0;
+}
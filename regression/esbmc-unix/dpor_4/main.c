@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <pthread.h>
+
+pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+int got1, got2;
+
+// The threads share nothing but the mutex, and keep it once they have it
+void *first(void *arg)
+{
+  got1 = pthread_mutex_trylock(&m) == 0;
+  return NULL;
+}
+
+void *second(void *arg)
+{
+  got2 = pthread_mutex_trylock(&m) == 0;
+  return NULL;
+}
+
+int main()
+{
+  pthread_t t1, t2;
+  pthread_create(&t1, NULL, first, NULL);
+  pthread_create(&t2, NULL, second, NULL);
+  pthread_join(t1, NULL);
+  pthread_join(t2, NULL);
+  assert(got1);
+  return 0;
+}
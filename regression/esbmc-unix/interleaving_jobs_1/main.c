@@ -0,0 +1,25 @@
+#include <assert.h>
+#include <pthread.h>
+
+int x;
+
+void *inc(void *arg)
+{
+  int tmp = x;
+  x = tmp + 1;
+  return NULL;
+}
+
+int main()
+{
+  pthread_t t1, t2, t3;
+  pthread_create(&t1, NULL, inc, NULL);
+  pthread_create(&t2, NULL, inc, NULL);
+  pthread_create(&t3, NULL, inc, NULL);
+  pthread_join(t1, NULL);
+  pthread_join(t2, NULL);
+  pthread_join(t3, NULL);
+  // Lost updates are only found in some of the interleavings
+  assert(x == 3);
+  return 0;
+}
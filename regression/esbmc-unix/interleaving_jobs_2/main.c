@@ -0,0 +1,28 @@
+#include <assert.h>
+#include <pthread.h>
+
+int x;
+pthread_mutex_t m;
+
+void *inc(void *arg)
+{
+  pthread_mutex_lock(&m);
+  int tmp = x;
+  x = tmp + 1;
+  pthread_mutex_unlock(&m);
+  return NULL;
+}
+
+int main()
+{
+  pthread_t t1, t2, t3;
+  pthread_mutex_init(&m, NULL);
+  pthread_create(&t1, NULL, inc, NULL);
+  pthread_create(&t2, NULL, inc, NULL);
+  pthread_create(&t3, NULL, inc, NULL);
+  pthread_join(t1, NULL);
+  pthread_join(t2, NULL);
+  pthread_join(t3, NULL);
+  assert(x == 3);
+  return 0;
+}
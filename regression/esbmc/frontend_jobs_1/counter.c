@@ -0,0 +1,8 @@
+#include "counter.h"
+
+struct counter c;
+
+void increment(int n)
+{
+  c.value += n;
+}
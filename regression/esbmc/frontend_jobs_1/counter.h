@@ -0,0 +1,8 @@
+struct counter
+{
+  int value;
+};
+
+extern struct counter c;
+void increment(int n);
+int get(void);
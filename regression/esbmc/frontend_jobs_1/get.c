@@ -0,0 +1,6 @@
+#include "counter.h"
+
+int get(void)
+{
+  return c.value;
+}
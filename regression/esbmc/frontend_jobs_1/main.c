@@ -0,0 +1,11 @@
+#include <assert.h>
+#include "counter.h"
+
+int main()
+{
+  increment(2);
+  assert(get() == 2);
+  increment(3);
+  assert(get() == 4);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#include "shapes.h"
+
+struct grid g;
+
+void fill_grid(struct grid *g)
+{
+  g->total = 0;
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+    {
+      g->cells[i][j] = 3 * i + j;
+      g->total += g->cells[i][j];
+    }
+}
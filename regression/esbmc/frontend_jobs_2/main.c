@@ -0,0 +1,14 @@
+#include <assert.h>
+#include "shapes.h"
+
+int main()
+{
+  assert(square.n == 4 && square.closed);
+  assert(perimeter(&square) == 8);
+  assert(sum_primes(6) == 41);
+
+  fill_grid(&g);
+  assert(g.cells[2][1] == 7);
+  assert(g.total == 36);
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include "shapes.h"
+
+struct polygon square = {
+  .closed = 1,
+  .n = 4,
+  .vertices = {{'a', 0, 0}, {'b', 2, 0}, {'c', 2, 2}, {'d', 0, 2}}};
+
+static int dist(struct point a, struct point b)
+{
+  int dx = a.x > b.x ? a.x - b.x : b.x - a.x;
+  int dy = a.y > b.y ? a.y - b.y : b.y - a.y;
+  return dx + dy;
+}
+
+int perimeter(const struct polygon *p)
+{
+  int total = 0;
+  for (unsigned i = 0; i < p->n; i++)
+    total += dist(p->vertices[i], p->vertices[(i + 1) % p->n]);
+  return total;
+}
@@ -0,0 +1,11 @@
+#include "shapes.h"
+
+const int primes[6] = {2, 3, 5, 7, 11, 13};
+
+int sum_primes(int n)
+{
+  int total = 0;
+  for (int i = 0; i < n; i++)
+    total += primes[i];
+  return total;
+}
@@ -0,0 +1,26 @@
+struct point
+{
+  char tag;
+  int x, y;
+};
+
+struct polygon
+{
+  unsigned closed : 1;
+  unsigned n : 7;
+  struct point vertices[4];
+};
+
+struct grid
+{
+  short cells[3][3];
+  long total;
+};
+
+extern struct polygon square;
+extern const int primes[6];
+extern struct grid g;
+
+int perimeter(const struct polygon *p);
+int sum_primes(int n);
+void fill_grid(struct grid *g);
@@ -0,0 +1,9 @@
+#include <assert.h>
+
+int twice(int x);
+
+int main()
+{
+  assert(twice(2) == 4);
+  return 0;
+}
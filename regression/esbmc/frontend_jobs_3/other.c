@@ -0,0 +1,6 @@
+struct pair
+{
+  int a[2];
+};
+
+struct pair p = {{1, 2}};
@@ -0,0 +1,10 @@
+#include <assert.h>
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x > 0 && x < 100);
+  __ESBMC_assert(x * 2 > x, "doubling a positive number");
+  assert(__VERIFIER_nondet_int() != 42);
+  return 0;
+}
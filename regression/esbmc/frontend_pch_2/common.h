@@ -0,0 +1,6 @@
+#define LIMIT 10
+
+static inline int clamp(int x)
+{
+  return x > LIMIT ? LIMIT : x;
+}
@@ -0,0 +1,8 @@
+#include <assert.h>
+
+int main()
+{
+  int x = nondet_int();
+  assert(clamp(x) <= LIMIT);
+  return 0;
+}
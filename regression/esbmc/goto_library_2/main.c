@@ -0,0 +1,14 @@
+#include <assert.h>
+
+/* Only strcat is declared here; the strcpy and strlen it calls have to be
+ * pulled out of the C library along with it. */
+char *strcat(char *dst, const char *src);
+
+int main()
+{
+  char buf[8] = "ab";
+  strcat(buf, "cd");
+  assert(buf[2] == 'c' && buf[3] == 'd' && buf[4] == 0);
+  assert(buf[1] == 'c');
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define N 16
+
+int main()
+{
+  char *p[N];
+  for (int i = 0; i < N; i++)
+    p[i] = malloc(4);
+
+  // Live objects never overlap
+  unsigned i, j;
+  __ESBMC_assume(i < N && j < N && i != j);
+  uintptr_t a = (uintptr_t)p[i], b = (uintptr_t)p[j];
+  assert(a + 4 <= b || b + 4 <= a);
+  return 0;
+}
@@ -0,0 +1,15 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+int main()
+{
+  char *p = malloc(4);
+  uintptr_t a = (uintptr_t)p;
+  free(p);
+
+  // The space of a free'd object can be handed out again
+  char *q = malloc(4);
+  assert((uintptr_t)q != a);
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Three of these fill most of a 16-bit address space
+#define SIZE 20000
+
+int main()
+{
+  char *a = malloc(SIZE);
+  char *b = malloc(SIZE);
+  // Freed out of allocation order: c can't take its space with
+  // --linear-address-space, but there is still room above b
+  free(a);
+  char *c = malloc(SIZE);
+
+  // Live objects never overlap
+  uintptr_t bs = (uintptr_t)b, cs = (uintptr_t)c;
+  assert(cs + SIZE <= bs || bs + SIZE <= cs);
+
+  // Reachable only if the layout above is feasible
+  b[0] = 1;
+  c[0] = 2;
+  assert(b[0] == c[0]);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  __ESBMC_assume(x > 0 && x < 100);
+  __ESBMC_assume(y > 0 && y < 100);
+
+  assert(x + y > 0);
+  assert(x != 42);
+  assert(x * y < 10000);
+  assert(y != 7);
+  assert(x - y < 100);
+  return 0;
+}
@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  assert(x != 42);
+  assert(x != 42);
+  return 0;
+}
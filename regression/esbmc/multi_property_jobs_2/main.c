@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int main()
+{
+  int arr[1];
+  arr[3] = 10;
+  for (int i = 0; i < 10; i++)
+  {
+    assert(1 == 0);
+  }
+}
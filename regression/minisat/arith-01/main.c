@@ -0,0 +1,12 @@
+#include <assert.h>
+
+unsigned nondet_uint();
+
+int main()
+{
+  unsigned x = nondet_uint();
+  unsigned y = nondet_uint();
+  __ESBMC_assume(y != 0);
+  assert(x / y * y + x % y == x);
+  return 0;
+}
@@ -0,0 +1,12 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  __ESBMC_assume(x > 0 && x < 1000 && y > 0 && y < 1000);
+  assert(x * y != 391);
+  return 0;
+}
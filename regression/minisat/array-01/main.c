@@ -0,0 +1,15 @@
+#include <assert.h>
+
+int nondet_int();
+unsigned nondet_uint();
+
+int main()
+{
+  int a[8];
+  unsigned i = nondet_uint() % 8;
+  unsigned j = nondet_uint() % 8;
+  a[i] = nondet_int();
+  a[j] = 5;
+  assert(a[i] == 5);
+  return 0;
+}
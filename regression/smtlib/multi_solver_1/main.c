@@ -0,0 +1,11 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  if (x > 10 && x < 20)
+    assert(x * 3 != 45);
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int x = nondet_uint();
+  unsigned int y = nondet_uint();
+  __ESBMC_assume(x > 1 && y > 1 && x < 1000 && y < 1000);
+  // 389 is prime
+  assert(x * y != 389);
+  return 0;
+}
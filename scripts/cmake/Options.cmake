@@ -37,6 +37,7 @@ option(ENABLE_MATHSAT "Use MathSAT solver (default: OFF)" OFF)
 option(ENABLE_YICES "Use Yices solver (default: OFF)" OFF)
 option(ENABLE_CVC4 "Use CVC4 solver (default: OFF)" OFF)
 option(ENABLE_BITWUZLA "Use Bitwuzla solver (default: OFF)" OFF)
+option(ENABLE_MINISAT "Use MiniSat on the built-in bit-blaster (default: OFF)" OFF)
 
 #############################
 # OTHERS
@@ -341,7 +341,7 @@ int configure_and_run_cpp(
     record_include(it.c_str());
 
   if (is_cpp)
-    record_include(esbmct::abstract_cpp_includes().c_str());
+    record_include(esbmct::extract_abstract_cpp_includes().c_str());
   record_include("/usr/include");
   record_builtin_macros();
 
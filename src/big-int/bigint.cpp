@@ -268,6 +268,14 @@ digit_div(onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql)
   }
 }
 
+// Free the digit vector if this owns it on the heap (size > 0 and not
+// inline_digit). Leaves digit and size alone for the caller to reset.
+inline void BigInt::release()
+{
+  if (size > 0 && !is_inline())
+    delete[] digit;
+}
+
 // Newly allocate uninitialized space for specified number of digits.
 inline void BigInt::allocate(unsigned digits)
 {
@@ -282,8 +290,7 @@ inline void BigInt::reallocate(unsigned digits)
 {
   if (digits > size)
   {
-    if (size)
-      delete[] digit;
+    release();
     size = adjust_size(digits);
     digit = new onedig_t[size];
   }
@@ -295,14 +302,14 @@ inline void BigInt::resize(unsigned digits)
   if (digits > size)
   {
     onedig_t *old_digit = digit;
-    unsigned old_size = size;
+    bool old_on_heap = size > 0 && !is_inline();
     size = adjust_size(digits);
     digit = new onedig_t[size];
 
     if (old_digit != nullptr)
     {
       memcpy(digit, old_digit, length * sizeof(onedig_t));
-      if (old_size)
+      if (old_on_heap)
         delete[] old_digit;
     }
   }
@@ -342,6 +349,18 @@ inline void digit_set(ullong_t ul, onedig_t d[small], unsigned &l)
   }
 }
 
+// Read back a string of at most small onedig_t.
+inline ullong_t digit_get(onedig_t const *d, unsigned l)
+{
+  ullong_t ul = 0;
+  for (int i = l; --i >= 0;)
+  {
+    ul <<= single_bits;
+    ul |= d[i];
+  }
+  return ul;
+}
+
 void BigInt::assign(ullong_t ul)
 {
   positive = true;
@@ -365,7 +384,7 @@ void BigInt::assign(llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (size > 0 && !is_inline())
   {
     memset(digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
     delete[] digit;
@@ -378,55 +397,57 @@ BigInt::BigInt(onedig_t *dig, unsigned len, bool pos)
 }
 
 BigInt::BigInt()
-  : size(adjust_size(small)),
-    length(0),
-    digit(new onedig_t[size]),
-    positive(true)
+  : size(inline_size), length(0), digit(inline_digit), positive(true)
 {
 }
 
 BigInt::BigInt(signed long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned long int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(ullong_t(n));
 }
 
 BigInt::BigInt(int n)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(llong_t(n));
 }
 
 BigInt::BigInt(unsigned u)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(ullong_t(u));
 }
 
 BigInt::BigInt(llong_t l)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(l);
 }
 
 BigInt::BigInt(ullong_t ul)
-  : size(adjust_size(small)), length(0), digit(new onedig_t[size])
+  : size(inline_size), length(0), digit(inline_digit)
 {
   assign(ul);
 }
 
 BigInt::BigInt(BigInt const &y)
-  : size(adjust_size(y.length)),
+  : size(inline_size),
     length(y.length),
-    digit(new onedig_t[size]),
+    digit(inline_digit),
     positive(y.positive)
 {
+  if (length > inline_size)
+  {
+    size = adjust_size(length);
+    digit = new onedig_t[size];
+  }
   memcpy(digit, y.digit, length * sizeof(onedig_t));
 }
 
@@ -436,18 +457,21 @@ BigInt::BigInt(BigInt &&y) : BigInt()
 }
 
 BigInt::BigInt(char const *s, onedig_t b)
-  : size(adjust_size(small)),
-    length(0),
-    digit(new onedig_t[size]),
-    positive(true)
+  : size(inline_size), length(0), digit(inline_digit), positive(true)
 {
   scan(s, b);
 }
 
 BigInt &BigInt::operator=(BigInt const &y)
 {
-  BigInt copy(y);
-  swap(copy);
+  if (this != &y)
+  {
+    // Keeps the current digit vector if it is large enough.
+    reallocate(y.length);
+    memcpy(digit, y.digit, y.length * sizeof(onedig_t));
+    length = y.length;
+    positive = y.positive;
+  }
   return *this;
 }
 
@@ -707,7 +731,24 @@ int BigInt::compare(ullong_t b) const
 
 int BigInt::compare(llong_t b) const
 {
-  return compare(BigInt(b));
+  if (b >= 0)
+    return compare(ullong_t(b));
+
+  if (positive)
+    return 1;
+
+  // Both are negative, the greater magnitude is the smaller number.
+  onedig_t dig[small];
+  unsigned len;
+  digit_set(ullong_t(0) - ullong_t(b), dig, len);
+
+  if (length < len)
+    return 1;
+
+  if (length > len)
+    return -1;
+
+  return -digit_cmp(digit, dig, len);
 }
 
 int BigInt::compare(BigInt const &b) const
@@ -723,6 +764,32 @@ int BigInt::compare(BigInt const &b) const
 // Auxiliary method for all adding and subtracting.
 void BigInt::add(onedig_t const *dig, unsigned len, bool pos)
 {
+  // Fast path: both magnitudes fit into an ullong_t and so does the
+  // result. Not part of original BigInt.
+  if (length <= small && len <= small)
+  {
+    ullong_t a = digit_get(digit, length);
+    ullong_t b = digit_get(dig, len);
+    if (positive != pos)
+    {
+      if (a >= b)
+        digit_set(a - b, digit, length);
+      else
+      {
+        digit_set(b - a, digit, length);
+        positive = pos;
+      }
+      if (length == 0)
+        positive = true;
+      return;
+    }
+    if (a + b >= a)
+    {
+      digit_set(a + b, digit, length);
+      return;
+    }
+  }
+
   // Make sure the result fits into this, even with carry.
   resize((length > len ? length : len) + 1);
 
@@ -773,6 +840,16 @@ void BigInt::add(onedig_t const *dig, unsigned len, bool pos)
 // Auxiliary method for multiplication.
 void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
 {
+  // Fast path: single digit operands can't overflow an ullong_t.
+  // Not part of original BigInt.
+  if (length <= 1 && len <= 1)
+  {
+    ullong_t p = digit_get(digit, length) * digit_get(dig, len);
+    digit_set(p, digit, length);
+    positive = length == 0 || positive == pos;
+    return;
+  }
+
   if (len < 2)
   {
     // Handle small dig/len operand efficiently.
@@ -815,7 +892,7 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
   else
   {
     // Get a new string of digits for the result.
-    unsigned old_size = size;
+    bool old_on_heap = size > 0 && !is_inline();
     size = adjust_size(length + len);
     onedig_t *r = new onedig_t[size];
 
@@ -827,7 +904,7 @@ void BigInt::mul(onedig_t const *dig, unsigned len, bool pos)
       digit_mul(dig, len, digit, length, r);
 
     // Replace digit string of this with result.
-    if (old_size)
+    if (old_on_heap)
       delete[] digit;
     digit = r;
     length += len;
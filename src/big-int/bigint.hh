@@ -101,12 +101,32 @@ public:
     small = sizeof(ullong_t) / sizeof(onedig_t)
   };
 
+  // Number of digits kept inside the object itself. Anything up to a
+  // product of two ullong_t fits without touching the heap.
+  // Not part of original BigInt.
+  enum
+  {
+    inline_size = 2 * small
+  };
+
 private:
   unsigned size;   // Length of digit vector.
   unsigned length; // Used places in digit vector.
   onedig_t *digit; // Least significant first.
   bool positive;   // Signed magnitude representation.
 
+  // Storage used by digit as long as the number is short enough.
+  onedig_t inline_digit[inline_size];
+
+  bool is_inline() const
+  {
+    return digit == inline_digit;
+  }
+
+  // Free the digit vector if this owns it on the heap (size > 0 and not
+  // inline_digit). Leaves digit and size alone for the caller to reset.
+  inline void release();
+
   // Create or resize this.
   inline void allocate(unsigned digits);
   inline void reallocate(unsigned digits);
@@ -326,10 +346,18 @@ public:
 
   void swap(BigInt &other)
   {
+    // Inline digits stay in their object, only their contents move.
+    bool was_inline = is_inline();
+    bool other_was_inline = other.is_inline();
+    std::swap(other.inline_digit, inline_digit);
     std::swap(other.size, size);
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+    if (was_inline)
+      other.digit = other.inline_digit;
+    if (other_was_inline)
+      digit = inline_digit;
   }
 
 private:
@@ -33,6 +33,9 @@ const struct group_opt_templ c2goto_options[] = {
      {"output",
       boost::program_options::value<std::string>()->value_name("<filename>"),
       "output VCCs in SMT lib format to given file"},
+     {"goto-library",
+      NULL,
+      "write an indexed library, as embedded for the internal C library"},
      {"include,I",
       boost::program_options::value<std::vector<std::string>>()->value_name(
         "path"),
@@ -89,7 +92,22 @@ public:
     std::ofstream out(
       cmdline.getval("output"), std::ios::out | std::ios::binary);
 
-    if (write_goto_binary(out, context, goto_functions))
+    if (cmdline.isset("goto-library"))
+    {
+      // We might use either pthread_mutex_lock or the checked variant; so if
+      // one version is used, pull in the other too. Same for the others.
+      const std::multimap<irep_idt, irep_idt> hacks = {
+        {"pthread_mutex_lock", "pthread_mutex_lock_check"},
+        {"pthread_cond_wait", "pthread_cond_wait_check"},
+        {"pthread_join", "pthread_join_noswitch"}};
+
+      if (write_goto_library(out, context, hacks))
+      {
+        log_error("Failed to write C library to binary obj");
+        return 1;
+      }
+    }
+    else if (write_goto_binary(out, context, goto_functions))
     {
       log_error("Failed to write C library to binary obj");
       return 1;
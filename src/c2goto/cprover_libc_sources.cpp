@@ -16,9 +16,9 @@ extern "C"
 
 /* This class represents the extracted internal libc. It uses the headers
  * generated by the build system to dump the bundled libc/libm files in a
- * temporary directory. The headers contain invocations of the form
- * ESBMC_FLAIL(body, size, name) for each bundled file,
- * see scripts/flail.py --macro. */
+ * temporary directory and to serve the libc headers from memory. The headers
+ * contain invocations of the form ESBMC_FLAIL(body, size, name) for each
+ * bundled file, see scripts/flail.py --macro. */
 static class
 {
   file_operations::tmp_path base;
@@ -44,25 +44,15 @@ static class
   }
 
 public:
+  /* The headers are only needed by clang, which reads them from memory, see
+   * file_operations::virtual_dir(). */
   const std::string &header_dir()
   {
     if (headers == "")
     {
-      using namespace boost::filesystem;
-      headers = base_path() + "/headers";
-      create_directory(headers);
-      create_directory(headers + "/__esbmc");
-      create_directory(headers + "/bits");
-      create_directory(headers + "/sys");
-      create_directory(headers + "/sys/_types");
-      create_directory(headers + "/sys/_pthread");
-      create_directory(headers + "/ubuntu20.04");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/linux");
-      create_directory(headers + "/ubuntu20.04/kernel_5.15.0-76/include/asm");
+      headers = file_operations::virtual_dir("libc-headers");
 #define ESBMC_FLAIL(body, size, ...)                                           \
-  std::ofstream(headers + "/" #__VA_ARGS__).write(body, size);
+  file_operations::add_virtual_file(headers + "/" #__VA_ARGS__, body, size);
 #include <headers/libc_hdr.h>
 #undef ESBMC_FLAIL
     }
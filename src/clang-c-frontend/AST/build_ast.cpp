@@ -11,15 +11,22 @@ CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
 #include <clang/Frontend/CompilerInvocation.h>
 #include <clang/Frontend/FrontendActions.h>
 #include <clang/Frontend/TextDiagnosticPrinter.h>
+#include <clang/Frontend/Utils.h>
 #include <clang/Lex/PreprocessorOptions.h>
+#include <clang/Serialization/ASTWriter.h>
+#include <clang/Serialization/PCHContainerOperations.h>
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Option/ArgList.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
+#include <llvm/Support/VirtualFileSystem.h>
 CC_DIAGNOSTIC_POP()
 
 #include <clang-c-frontend/AST/build_ast.h>
 #include <clang-c-frontend/AST/esbmc_action.h>
+#include <util/filesystem.h>
+#include <mutex>
 
 /// Builds a clang driver initialized for running clang tools.
 static clang::driver::Driver *newDriver(
@@ -48,20 +55,144 @@ static clang::driver::Driver *newDriver(
   return CompilerDriver;
 }
 
-std::unique_ptr<clang::ASTUnit> buildASTs(
-  const std::string &intrinsics,
-  const std::vector<std::string> &compiler_args)
+/// A file system with the files bundled into ESBMC, see
+/// file_operations::virtual_dir(), on top of the real one. The bundled files
+/// are copied the first time they are seen, as clang's lexer wants them
+/// null-terminated, into a layer that is shared by every ASTUnit afterwards.
+/// Layers are never modified once made, so that ASTs can be built on several
+/// threads.
+static llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> newFileSystem()
 {
-  // Create virtual file system to add clang's headers
+  static std::mutex Mutex;
+  static std::vector<llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem>>
+    Layers;
+  static size_t NumFiles = 0;
+
   llvm::IntrusiveRefCntPtr<llvm::vfs::OverlayFileSystem> OverlayFileSystem(
     new llvm::vfs::OverlayFileSystem(llvm::vfs::getRealFileSystem()));
 
-  llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> InMemoryFileSystem(
-    new llvm::vfs::InMemoryFileSystem);
-  OverlayFileSystem->pushOverlay(InMemoryFileSystem);
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto Files = file_operations::virtual_files(NumFiles);
+  if (!Files.empty())
+  {
+    llvm::IntrusiveRefCntPtr<llvm::vfs::InMemoryFileSystem> Layer(
+      new llvm::vfs::InMemoryFileSystem);
+    for (const auto &[Path, Body] : Files)
+      Layer->addFile(
+        Path,
+        0,
+        llvm::MemoryBuffer::getMemBufferCopy(
+          llvm::StringRef(Body.data(), Body.size()), Path));
+    Layers.push_back(Layer);
+    NumFiles += Files.size();
+  }
+
+  for (const auto &Layer : Layers)
+    OverlayFileSystem->pushOverlay(Layer);
+
+  return OverlayFileSystem;
+}
+
+/// Collects all files read, including system headers
+class all_dependencies : public clang::DependencyCollector
+{
+public:
+  bool needSystemDependencies() override
+  {
+    return true;
+  }
+};
+
+/// Like clang's GeneratePCHAction, but the precompiled header is kept in
+/// memory instead of being written to a file.
+class esbmc_pch_action : public clang::ASTFrontendAction
+{
+public:
+  esbmc_pch_action(
+    std::shared_ptr<clang::PCHBuffer> Buffer,
+    std::shared_ptr<all_dependencies> Deps)
+    : Buffer(std::move(Buffer)), Deps(std::move(Deps))
+  {
+  }
+
+  bool BeginInvocation(clang::CompilerInstance &CI) override
+  {
+    // Must be attached before the preprocessor is created
+    CI.addDependencyCollector(Deps);
+    return true;
+  }
+
+  bool BeginSourceFileAction(clang::CompilerInstance &CI) override
+  {
+    CI.getLangOpts().CompilingPCH = true;
+    return true;
+  }
+
+  std::unique_ptr<clang::ASTConsumer>
+  CreateASTConsumer(clang::CompilerInstance &CI, llvm::StringRef) override
+  {
+    std::string Sysroot;
+    if (!clang::GeneratePCHAction::ComputeASTConsumerArguments(CI, Sysroot))
+      return nullptr;
+
+    // No timestamps, so that the result only depends on the contents
+    return std::make_unique<clang::PCHGenerator>(
+      CI.getPreprocessor(),
+      CI.getModuleCache(),
+      "",
+      Sysroot,
+      Buffer,
+      CI.getFrontendOpts().ModuleFileExtensions,
+      /*AllowASTWithErrors=*/false,
+      /*IncludeTimestamps=*/false);
+  }
+
+  clang::TranslationUnitKind getTranslationUnitKind() override
+  {
+    return clang::TU_Prefix;
+  }
+
+  bool hasCodeCompletionSupport() const override
+  {
+    return false;
+  }
+
+private:
+  std::shared_ptr<clang::PCHBuffer> Buffer;
+  std::shared_ptr<all_dependencies> Deps;
+};
 
+bool buildPCH(
+  const std::vector<std::string> &compiler_args,
+  std::string &pch,
+  std::vector<std::string> &inputs)
+{
+  llvm::IntrusiveRefCntPtr<clang::FileManager> Files(
+    new clang::FileManager(clang::FileSystemOptions(), newFileSystem()));
+
+  auto Buffer = std::make_shared<clang::PCHBuffer>();
+  auto Deps = std::make_shared<all_dependencies>();
+  clang::tooling::ToolInvocation Invocation(
+    compiler_args, std::make_unique<esbmc_pch_action>(Buffer, Deps), &*Files);
+
+  if (!Invocation.run() || !Buffer->IsComplete)
+    return true;
+
+  pch.assign(Buffer->Data.data(), Buffer->Data.size());
+  for (const std::string &Dep : Deps->getDependencies())
+    inputs.push_back(Dep);
+
+  return false;
+}
+
+std::unique_ptr<clang::ASTUnit> buildASTs(
+  const std::string &intrinsics,
+  const std::vector<std::string> &compiler_args)
+{
+  // Create virtual file system to add clang's headers, and the rest of the
+  // bundled files, without writing them to disk
   llvm::IntrusiveRefCntPtr<clang::FileManager> Files(
-    new clang::FileManager(clang::FileSystemOptions(), OverlayFileSystem));
+    new clang::FileManager(clang::FileSystemOptions(), newFileSystem()));
 
   // Create everything needed to create a CompilerInvocation,
   // copied from ToolInvocation::run
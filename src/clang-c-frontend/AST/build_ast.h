@@ -2,6 +2,7 @@
 #define CLANG_C_FRONTEND_AST_BUILD_AST_H_
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -18,4 +19,12 @@ std::unique_ptr<clang::ASTUnit> buildASTs(
   const std::string &intrinsics,
   const std::vector<std::string> &compiler_args);
 
+/// Builds a precompiled header of the header given last in compiler_args,
+/// which must select a header language with -x, into pch. The paths of the
+/// files it was built from are added to inputs. Returns true on error.
+bool buildPCH(
+  const std::vector<std::string> &compiler_args,
+  std::string &pch,
+  std::vector<std::string> &inputs);
+
 #endif /* CLANG_C_FRONTEND_AST_BUILD_AST_H_ */
@@ -39,7 +39,7 @@ clang_c_languaget::clang_c_languaget()
   }
 }
 
-void clang_c_languaget::build_compiler_args(const std::string &tmp_dir)
+void clang_c_languaget::build_compiler_args(const std::string &headers_dir)
 {
   compiler_args.emplace_back("clang-tool");
 
@@ -54,7 +54,7 @@ void clang_c_languaget::build_compiler_args(const std::string &tmp_dir)
   }
 
   compiler_args.push_back("-isystem");
-  compiler_args.push_back(tmp_dir);
+  compiler_args.push_back(headers_dir);
 
   // Append mode arg
   switch (config.ansi_c.word_size)
@@ -327,6 +327,21 @@ bool clang_c_languaget::parse(const std::string &path)
   // Get intrinsics
   std::string intrinsics = internal_additions();
 
+  // Or rather the precompiled header of them, if one can be built
+  if (
+    config.options.get_bool_option("frontend-pch") ||
+    !config.options.get_option("frontend-pch-dir").empty() ||
+    !config.ansi_c.pch_includes.empty())
+  {
+    std::string pch = precompiled_header(intrinsics);
+    if (!pch.empty())
+    {
+      new_compiler_args.insert(
+        new_compiler_args.end() - 1, {"-include-pch", pch});
+      intrinsics.clear();
+    }
+  }
+
   // Generate ASTUnit and add to our vector
   auto AST = buildASTs(intrinsics, new_compiler_args);
 
@@ -344,6 +359,17 @@ bool clang_c_languaget::typecheck(contextt &context, const std::string &module)
 {
   contextt new_context;
 
+  if (convert(new_context))
+    return true;
+
+  if (link(context, new_context, module))
+    return true;
+
+  return false;
+}
+
+bool clang_c_languaget::convert(contextt &new_context)
+{
   clang_c_convertert converter(new_context, ASTs, "C");
   if (converter.convert())
     return true;
@@ -352,12 +378,17 @@ bool clang_c_languaget::typecheck(contextt &context, const std::string &module)
   if (adjuster.adjust())
     return true;
 
-  if (c_link(context, new_context, module))
-    return true;
-
   return false;
 }
 
+bool clang_c_languaget::link(
+  contextt &context,
+  contextt &new_context,
+  const std::string &module)
+{
+  return c_link(context, new_context, module);
+}
+
 void clang_c_languaget::show_parse(std::ostream &)
 {
   for (auto const &translation_unit : ASTs)
@@ -23,6 +23,16 @@ public:
 
   bool typecheck(contextt &context, const std::string &module) override;
 
+  bool separate_conversion() const override
+  {
+    return true;
+  }
+
+  bool convert(contextt &new_context) override;
+
+  bool link(contextt &context, contextt &new_context, const std::string &module)
+    override;
+
   std::string id() const override
   {
     return "c";
@@ -60,7 +70,12 @@ protected:
   virtual void force_file_type();
 
   static const std::string &clang_headers_path();
-  void build_compiler_args(const std::string &tmp_dir);
+  /// Appends the headers of --frontend-pch-include to the intrinsics, and
+  /// returns the path of a precompiled header of the result for the current
+  /// compiler arguments. It is built once per configuration and served from
+  /// memory, see clang_pch.cpp. Empty if it could not be built.
+  std::string precompiled_header(std::string &intrinsics);
+  void build_compiler_args(const std::string &headers_dir);
 
   std::vector<std::string> compiler_args;
   std::vector<std::unique_ptr<clang::ASTUnit>> ASTs;
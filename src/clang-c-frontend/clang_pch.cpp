@@ -0,0 +1,188 @@
+#include <clang-c-frontend/AST/build_ast.h>
+#include <clang-c-frontend/clang_c_language.h>
+#include <ac_config.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <util/crypto_hash.h>
+#include <util/filesystem.h>
+#include <util/message.h>
+
+/* Precompiled headers are cached in memory for the whole run, and on disk in
+ * the directory given by --frontend-pch-dir. A cache entry on disk starts with
+ * the list of files the header was built from, one per line, each with a
+ * stamp of its contents, followed by an empty line and the precompiled header.
+ * An entry is only used if the stamps of all files still match. */
+
+static std::string hash_of(const std::string &s)
+{
+  crypto_hash h;
+  h.ingest(s.data(), s.size());
+  h.fin();
+  return h.to_string();
+}
+
+/* Bundled files are stamped by contents, files on disk by size and
+ * modification time. Empty if the file can't be found. */
+static std::string input_stamp(const std::string &path)
+{
+  std::string_view bundled;
+  if (file_operations::get_virtual_file(path, bundled))
+    return hash_of(std::string(bundled));
+
+  boost::system::error_code ec;
+  auto size = boost::filesystem::file_size(path, ec);
+  if (ec)
+    return "";
+  auto mtime = boost::filesystem::last_write_time(path, ec);
+  if (ec)
+    return "";
+  return std::to_string(size) + ":" + std::to_string(mtime);
+}
+
+static bool load_pch(const boost::filesystem::path &entry, std::string &pch)
+{
+  std::ifstream in(entry.string(), std::ios::binary);
+  if (!in)
+    return false;
+
+  std::string line;
+  while (std::getline(in, line) && !line.empty())
+  {
+    size_t tab = line.find('\t');
+    if (
+      tab == std::string::npos ||
+      input_stamp(line.substr(0, tab)) != line.substr(tab + 1))
+      return false;
+  }
+  if (!in)
+    return false;
+
+  pch.assign(
+    std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  return !pch.empty();
+}
+
+static void store_pch(
+  const boost::filesystem::path &entry,
+  const std::string &pch,
+  const std::vector<std::string> &inputs)
+{
+  std::ostringstream manifest;
+  for (const std::string &input : inputs)
+  {
+    std::string stamp = input_stamp(input);
+    // Don't store what could not be checked when loading it again
+    if (stamp.empty())
+      return;
+    manifest << input << '\t' << stamp << '\n';
+  }
+  manifest << '\n';
+
+  // Write to a private file first and rename it into place, so that
+  // concurrent runs sharing the directory never see a partial entry
+  boost::filesystem::path tmp =
+    entry.parent_path() /
+    boost::filesystem::unique_path(
+      entry.filename().string() + "-%%%%-%%%%.tmp");
+  {
+    std::ofstream out(tmp.string(), std::ios::binary);
+    out << manifest.str();
+    out.write(pch.data(), pch.size());
+    if (!out)
+    {
+      log_warning("Could not write precompiled header {}", entry.string());
+      return;
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp, entry, ec);
+  if (ec)
+    boost::filesystem::remove(tmp, ec);
+}
+
+std::string clang_c_languaget::precompiled_header(std::string &intrinsics)
+{
+  // The header is in the language of the translation units
+  std::string lang = "c";
+  for (size_t i = 0; i + 1 < compiler_args.size(); i++)
+    if (compiler_args[i] == "-x")
+      lang = compiler_args[i + 1];
+
+  for (const auto &inc : config.ansi_c.pch_includes)
+  {
+    if (boost::filesystem::exists(inc))
+      intrinsics += "#include \"" +
+                    boost::filesystem::absolute(inc).generic_string() + "\"\n";
+    else
+      intrinsics += "#include <" + inc + ">\n";
+  }
+  const std::string &header = intrinsics;
+
+  std::string key = ESBMC_VERSION "\n" + header;
+  for (const std::string &arg : compiler_args)
+    key += "\n" + arg;
+  key = hash_of(key);
+
+  // Precompiled headers built so far, by key. Empty if that failed.
+  static std::unordered_map<std::string, std::string> built;
+  // Contents of the headers and of the precompiled headers, which are served
+  // from memory and so must live as long as the process
+  static std::list<std::string> bodies;
+  // Translation units may be parsed on several threads, see --frontend-jobs.
+  // Those needing a header that is being built wait for it.
+  static std::mutex mutex;
+  std::lock_guard lock(mutex);
+
+  auto it = built.find(key);
+  if (it != built.end())
+    return it->second;
+  std::string &pch_path = built[key];
+
+  const std::string dir = file_operations::virtual_dir("pch");
+  const std::string header_path = dir + "/" + key + ".h";
+  bodies.push_back(header);
+  file_operations::add_virtual_file(
+    header_path, bodies.back().data(), bodies.back().size());
+
+  std::string pch;
+  boost::filesystem::path entry;
+  std::string cache_dir = config.options.get_option("frontend-pch-dir");
+  if (!cache_dir.empty())
+  {
+    boost::system::error_code ec;
+    boost::filesystem::create_directories(cache_dir, ec);
+    entry = boost::filesystem::path(cache_dir) / (key + ".pch");
+  }
+
+  if (!entry.empty() && load_pch(entry, pch))
+    log_debug("clang", "Loaded precompiled header {}", entry.string());
+  else
+  {
+    std::vector<std::string> args(compiler_args);
+    args.push_back("-x");
+    args.push_back(lang + "-header");
+    args.push_back(header_path);
+
+    std::vector<std::string> inputs;
+    if (buildPCH(args, pch, inputs))
+    {
+      log_warning("Could not precompile the intrinsics, parsing them instead");
+      return pch_path;
+    }
+
+    if (!entry.empty())
+      store_pch(entry, pch, inputs);
+  }
+
+  bodies.push_back(std::move(pch));
+  pch_path = dir + "/" + key + ".pch";
+  file_operations::add_virtual_file(
+    pch_path, bodies.back().data(), bodies.back().size());
+  return pch_path;
+}
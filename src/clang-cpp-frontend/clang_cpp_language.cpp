@@ -5,7 +5,6 @@ CC_DIAGNOSTIC_IGNORE_LLVM_CHECKS()
 #include <clang/Frontend/ASTUnit.h>
 CC_DIAGNOSTIC_POP()
 
-#include <util/c_link.h>
 #include <c2goto/cprover_library.h>
 #include <clang-cpp-frontend/clang_cpp_main.h>
 #include <clang-cpp-frontend/clang_cpp_adjust.h>
@@ -72,12 +71,8 @@ std::string clang_cpp_languaget::internal_additions()
   return std::regex_replace(intrinsics, std::regex("_Bool"), "bool");
 }
 
-bool clang_cpp_languaget::typecheck(
-  contextt &context,
-  const std::string &module)
+bool clang_cpp_languaget::convert(contextt &new_context)
 {
-  contextt new_context;
-
   clang_cpp_convertert converter(new_context, ASTs, "C++");
   if (converter.convert())
     return true;
@@ -86,9 +81,6 @@ bool clang_cpp_languaget::typecheck(
   if (adjuster.adjust())
     return true;
 
-  if (c_link(context, new_context, module))
-    return true;
-
   return false;
 }
 
@@ -11,7 +11,7 @@ class clang_cpp_languaget : public clang_c_languaget
 public:
   bool final(contextt &context) override;
 
-  bool typecheck(contextt &context, const std::string &module) override;
+  bool convert(contextt &new_context) override;
 
   std::string id() const override
   {
@@ -7,6 +7,21 @@ extern "C"
 }
 
 const std::string &esbmct::abstract_cpp_includes()
+{
+  // Serve CPP headers from memory, for the clang frontend. They are
+  // registered once, so the same path is used during a run.
+  static const std::string path = [] {
+    std::string p = file_operations::virtual_dir("cpp-headers");
+#define ESBMC_FLAIL(body, size, ...)                                           \
+  file_operations::add_virtual_file(p + "/" #__VA_ARGS__, body, size);
+#include <abstract_includes/cpp_includes.h> /* generated by build system */
+#undef ESBMC_FLAIL
+    return p;
+  }();
+  return path;
+}
+
+const std::string &esbmct::extract_abstract_cpp_includes()
 {
   // Dump CPP headers into a temporary directory
   static bool dumped = false;
@@ -26,4 +41,4 @@ const std::string &esbmct::abstract_cpp_includes()
 #undef ESBMC_FLAIL
   }
   return p.path();
-}
\ No newline at end of file
+}
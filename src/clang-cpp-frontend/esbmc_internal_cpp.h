@@ -1,5 +1,9 @@
 #include <sstream>
 namespace esbmct
 {
+/* Directory of the abstract CPP headers, which only clang can read as it is
+ * in memory. */
 const std::string &abstract_cpp_includes();
-}
\ No newline at end of file
+/* The same headers, written to a temporary directory for other tools. */
+const std::string &extract_abstract_cpp_includes();
+}
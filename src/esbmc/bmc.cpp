@@ -4,6 +4,13 @@
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <mutex>
+#include <map>
+#include <optional>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -41,6 +48,47 @@
 #include <atomic>
 #include <goto-symex/witnesses.h>
 
+void cancellationt::cancel()
+{
+  std::lock_guard lock(mutex);
+  cancelled = true;
+  // A solver that is only about to start searching may miss this, see
+  // smt_convt::interrupt; the work then notices once it returns
+  for (smt_convt *solver : solving)
+    solver->interrupt();
+}
+
+void cancellationt::reset()
+{
+  cancelled = false;
+}
+
+smt_convt::resultt cancellationt::solve(smt_convt &solver)
+{
+  {
+    std::lock_guard lock(mutex);
+    if (cancelled)
+      return smt_convt::P_ERROR;
+    solving.push_back(&solver);
+  }
+
+  smt_convt::resultt res;
+  try
+  {
+    res = solver.dec_solve();
+  }
+  catch (...)
+  {
+    std::lock_guard lock(mutex);
+    solving.erase(std::find(solving.begin(), solving.end(), &solver));
+    throw;
+  }
+
+  std::lock_guard lock(mutex);
+  solving.erase(std::find(solving.begin(), solving.end(), &solver));
+  return res;
+}
+
 bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   : options(opts), context(_context), ns(context)
 {
@@ -61,6 +109,11 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
         config.ssa_caching_db, !options.get_bool_option("forward-condition")));
   }
 
+  const std::string cache_dir = options.get_option("verification-cache");
+  if (!cache_dir.empty())
+    verification_cache =
+      std::make_unique<verification_cachet>(cache_dir, options);
+
   if (options.get_bool_option("smt-during-symex"))
   {
     runtime_solver = std::shared_ptr<smt_convt>(create_solver("", ns, options));
@@ -182,7 +235,8 @@ smt_convt::resultt bmct::run_decision_procedure(
   log_progress("Solving with solver {}", smt_conv->solver_text());
 
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv->dec_solve();
+  smt_convt::resultt dec_result =
+    cancelled ? cancelled->solve(*smt_conv) : smt_conv->dec_solve();
   fine_timet sat_stop = current_time();
 
   // output runtime
@@ -192,6 +246,243 @@ smt_convt::resultt bmct::run_decision_procedure(
   return dec_result;
 }
 
+namespace
+{
+/// wins per solver, over every portfolio race of this run
+std::mutex portfolio_wins_mutex;
+std::map<std::string, unsigned int> portfolio_wins;
+} // namespace
+
+smt_convt::resultt bmct::run_portfolio_decision_procedure(
+  std::shared_ptr<symex_target_equationt> &eq)
+{
+  struct membert
+  {
+    std::string name;
+    std::shared_ptr<smt_convt> solver;
+    /// converting stores the ASTs of each solver in the steps
+    std::shared_ptr<symex_target_equationt> eq;
+    smt_convt::resultt result = smt_convt::P_ERROR;
+    std::exception_ptr error;
+    fine_timet time = 0;
+    std::atomic_bool solving = false;
+    bool finished = false;
+  };
+
+  std::vector<std::string> names;
+  std::istringstream portfolio(options.get_option("portfolio"));
+  for (std::string name; std::getline(portfolio, name, ',');)
+    if (!name.empty())
+      names.push_back(name);
+
+  // Solvers are all created up front, interrupt() must not race with that
+  std::vector<membert> members(names.size());
+  for (size_t i = 0; i < names.size(); i++)
+  {
+    members[i].name = names[i];
+    members[i].solver =
+      std::shared_ptr<smt_convt>(create_solver(names[i], ns, options));
+    members[i].eq = std::make_shared<symex_target_equationt>(*eq);
+  }
+
+  std::mutex race_mutex;
+  std::condition_variable race_cv;
+  std::optional<size_t> winner;
+  size_t num_finished = 0;
+  bool cancelled = false;
+
+  auto race = [&](membert &m) {
+    try
+    {
+      fine_timet start = current_time();
+      m.eq->convert(*m.solver);
+      {
+        std::lock_guard lock(race_mutex);
+        m.solving = !cancelled;
+      }
+      if (m.solving)
+        m.result = m.solver->dec_solve();
+      m.time = current_time() - start;
+    }
+    catch (...)
+    {
+      m.error = std::current_exception();
+    }
+
+    std::lock_guard lock(race_mutex);
+    m.finished = true;
+    ++num_finished;
+    if (
+      !winner && !m.error && (m.result == smt_convt::P_SATISFIABLE ||
+                              m.result == smt_convt::P_UNSATISFIABLE))
+      winner = &m - members.data();
+    race_cv.notify_all();
+  };
+
+  log_progress(
+    "Solving with a portfolio of {} solvers: {}",
+    members.size(),
+    options.get_option("portfolio"));
+
+  std::vector<std::thread> pool;
+  for (membert &m : members)
+    pool.emplace_back(race, std::ref(m));
+
+  {
+    std::unique_lock lock(race_mutex);
+    race_cv.wait(
+      lock, [&]() { return winner || num_finished == members.size(); });
+
+    // A solver that was just starting its search may miss an interrupt, so
+    // keep asking until every one of them has given up
+    cancelled = true;
+    while (num_finished < members.size())
+    {
+      for (membert &m : members)
+        if (m.solving && !m.finished)
+          m.solver->interrupt();
+      race_cv.wait_for(lock, std::chrono::milliseconds(10));
+    }
+  }
+
+  for (auto &t : pool)
+    t.join();
+
+  if (!winner)
+  {
+    for (membert &m : members)
+      if (m.error)
+        std::rethrow_exception(m.error);
+
+    log_error("No solver of the portfolio gave an answer");
+    return smt_convt::P_ERROR;
+  }
+
+  membert &w = members[*winner];
+  runtime_solver = w.solver;
+  eq = w.eq;
+
+  std::string wins;
+  {
+    std::lock_guard lock(portfolio_wins_mutex);
+    ++portfolio_wins[w.name];
+    for (const auto &[name, n] : portfolio_wins)
+      wins += fmt::format("{}{}: {}", wins.empty() ? "" : ", ", name, n);
+  }
+
+  log_status(
+    "{} answered first, after {}s of encoding and solving",
+    w.solver->solver_text(),
+    time2string(w.time));
+  log_status("Portfolio wins so far: {}", wins);
+
+  return w.result;
+}
+
+static bool same_step(
+  const symex_target_equationt::SSA_stept &a,
+  const symex_target_equationt::SSA_stept &b)
+{
+  return a.type == b.type && a.ignore == b.ignore && a.guard == b.guard &&
+         a.cond == b.cond && a.lhs == b.lhs && a.rhs == b.rhs &&
+         a.output_args == b.output_args;
+}
+
+smt_convt::resultt bmct::run_reused_solver_decision_procedure(
+  std::shared_ptr<symex_target_equationt> &eq)
+{
+  reused_solvert &st = *reused_solver;
+
+  // Drop the steps that were specific to the last bound
+  if (st.in_ctx)
+  {
+    st.solver->pop_ctx();
+    st.in_ctx = false;
+  }
+
+  // Length of the prefix shared with the equation of the last bound
+  size_t common = 0;
+  if (st.last_eq)
+  {
+    auto it = st.last_eq->SSA_steps.begin();
+    auto it2 = eq->SSA_steps.begin();
+    while (it != st.last_eq->SSA_steps.end() && it2 != eq->SSA_steps.end() &&
+           same_step(*it, *it2))
+      ++it, ++it2, ++common;
+  }
+
+  if (!st.solver || common < st.committed)
+  {
+    if (st.solver)
+      log_status("Equation diverged from the encoded prefix, re-encoding");
+
+    st.solver = std::shared_ptr<smt_convt>(create_solver("", st.ns, options));
+    st.committed = 0;
+    st.committed_assertions.clear();
+    st.committed_assumptions = st.solver->convert_ast(gen_true_expr());
+  }
+  runtime_solver = st.solver;
+
+  fine_timet encode_start = current_time();
+
+  // The committed steps are already encoded: share their ASTs, which the
+  // counterexample is built from
+  auto it = eq->SSA_steps.begin();
+  auto last_it = st.last_eq ? st.last_eq->SSA_steps.begin() : it;
+  for (size_t i = 0; i < st.committed; i++, ++it, ++last_it)
+  {
+    it->guard_ast = last_it->guard_ast;
+    it->cond_ast = last_it->cond_ast;
+    it->converted_output_args = last_it->converted_output_args;
+  }
+
+  // Steps that two consecutive bounds agree on are likely to stay, so they
+  // become permanent
+  for (size_t i = st.committed; i < common; i++, ++it)
+    eq->convert_internal_step(
+      *runtime_solver,
+      st.committed_assumptions,
+      st.committed_assertions,
+      it.index());
+
+  log_status(
+    "Encoding {} new step(s), reusing {} from the previous bound",
+    eq->SSA_steps.size() - st.committed,
+    st.committed);
+  st.committed = common;
+
+  runtime_solver->push_ctx();
+  st.in_ctx = true;
+
+  smt_astt assumptions = st.committed_assumptions;
+  smt_convt::ast_vec assertions = st.committed_assertions;
+  for (; it != eq->SSA_steps.end(); ++it)
+    eq->convert_internal_step(
+      *runtime_solver, assumptions, assertions, it.index());
+
+  if (!assertions.empty())
+    runtime_solver->assert_ast(runtime_solver->make_n_ary(
+      runtime_solver.get(), &smt_convt::mk_or, assertions));
+
+  st.last_eq = eq;
+
+  fine_timet encode_stop = current_time();
+  log_status(
+    "Encoding to solver time: {}s", time2string(encode_stop - encode_start));
+
+  log_progress("Solving with solver {}", runtime_solver->solver_text());
+
+  fine_timet sat_start = current_time();
+  smt_convt::resultt dec_result = cancelled ? cancelled->solve(*runtime_solver)
+                                            : runtime_solver->dec_solve();
+  fine_timet sat_stop = current_time();
+
+  log_status(
+    "Runtime decision procedure: {}s", time2string(sat_stop - sat_start));
+
+  return dec_result;
+}
+
 void bmct::report_success()
 {
   log_success("\nVERIFICATION SUCCESSFUL");
@@ -390,11 +681,90 @@ smt_convt::resultt bmct::start_bmc()
 {
   std::shared_ptr<symex_target_equationt> eq;
   smt_convt::resultt res = run(eq);
-  report_trace(res, eq);
+  // Parallel exploration reports counterexamples from its workers
+  if (eq || res != smt_convt::P_SATISFIABLE)
+    report_trace(res, eq);
   report_result(res);
   return res;
 }
 
+namespace
+{
+/* Subtrees of the reachability tree that are left to explore. A worker
+ * blocks for the next one as long as others are busy, since they may still
+ * donate part of theirs; once nobody is, the exploration is complete. */
+class subtree_queuet
+{
+public:
+  typedef reachability_treet::dfs_position dfs_position;
+
+  explicit subtree_queuet(std::vector<dfs_position> &&positions)
+    : positions(
+        std::make_move_iterator(positions.begin()),
+        std::make_move_iterator(positions.end()))
+  {
+  }
+
+  /// the next subtree to explore, or nothing once there is none left
+  std::optional<dfs_position> pop()
+  {
+    std::unique_lock lock(mutex);
+    ++idle;
+    cv.wait(lock, [this]() { return stopped || !positions.empty() || !busy; });
+    --idle;
+
+    if (stopped || positions.empty())
+    {
+      cv.notify_all();
+      return std::nullopt;
+    }
+
+    dfs_position pos = std::move(positions.front());
+    positions.pop_front();
+    ++busy;
+    return pos;
+  }
+
+  /// the subtree returned by the last pop() was fully explored
+  void done()
+  {
+    std::lock_guard lock(mutex);
+    --busy;
+    cv.notify_all();
+  }
+
+  void push(std::vector<dfs_position> &&donated)
+  {
+    std::lock_guard lock(mutex);
+    for (dfs_position &pos : donated)
+      positions.push_back(std::move(pos));
+    cv.notify_all();
+  }
+
+  /// some worker is waiting and there is nothing to hand it
+  bool starving()
+  {
+    std::lock_guard lock(mutex);
+    return idle && positions.empty();
+  }
+
+  void stop()
+  {
+    std::lock_guard lock(mutex);
+    stopped = true;
+    cv.notify_all();
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<dfs_position> positions;
+  unsigned int busy = 0;
+  unsigned int idle = 0;
+  bool stopped = false;
+};
+} // namespace
+
 smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
 {
   symex->options.set_option("unwind", options.get_option("unwind"));
@@ -403,6 +773,29 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
   if (options.get_bool_option("schedule"))
     return run_thread(eq);
 
+  // "interleaving-jobs 0" uses one worker per hardware thread
+  const std::string jobs_opt = options.get_option("interleaving-jobs");
+  if (!jobs_opt.empty())
+  {
+    size_t num_jobs = strtoul(jobs_opt.c_str(), nullptr, 10);
+    if (!num_jobs)
+      num_jobs = std::thread::hardware_concurrency();
+
+    if (
+      options.get_bool_option("smt-during-symex") ||
+      options.get_bool_option("interactive-ileaves") ||
+      options.get_bool_option("bidirectional") || reused_solver)
+      log_warning(
+        "Interleavings can only be explored in parallel with one solver per "
+        "interleaving, ignoring --interleaving-jobs");
+    else if (options.get_bool_option("dpor"))
+      log_warning(
+        "DPOR needs the whole reachability tree in one exploration, ignoring "
+        "--interleaving-jobs");
+    else if (num_jobs > 1)
+      return run_parallel_interleavings(eq, num_jobs);
+  }
+
   smt_convt::resultt res;
   do
   {
@@ -437,11 +830,156 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
     if (options.get_bool_option("interactive-ileaves"))
       return res;
 
+    if (cancelled && *cancelled)
+      return smt_convt::P_SMTLIB;
+
   } while (symex->setup_next_formula());
 
+  if (options.get_bool_option("dpor"))
+  {
+    log_status(
+      "DPOR pruned {} branches of the reachability tree, {} with sleep sets",
+      symex->pruned_branches,
+      symex->pruned_by_sleep_sets);
+    log_status(
+      "Partial order reduction would have pruned {} of the transitions DPOR "
+      "explored",
+      symex->pruned_by_mpor);
+  }
+  else if (symex->pruned_branches)
+    log_status(
+      "Partial order reduction pruned {} branches of the reachability tree",
+      symex->pruned_branches);
+
   return interleaving_failed > 0 ? smt_convt::P_SATISFIABLE : res;
 }
 
+smt_convt::resultt bmct::run_parallel_interleavings(
+  std::shared_ptr<symex_target_equationt> &eq,
+  size_t num_jobs)
+{
+  const std::string depth_opt = options.get_option("interleaving-split-depth");
+  const unsigned int depth =
+    depth_opt.empty() ? 2 : strtoul(depth_opt.c_str(), nullptr, 10);
+
+  std::vector<reachability_treet::dfs_position> positions;
+  try
+  {
+    positions = symex->split_at_depth(depth);
+  }
+  catch (std::string &error_str)
+  {
+    log_error("{}", error_str);
+    return smt_convt::P_ERROR;
+  }
+  catch (const char *error_str)
+  {
+    log_error("{}", error_str);
+    return smt_convt::P_ERROR;
+  }
+
+  const size_t pool_size = std::min(num_jobs, positions.size());
+  log_status(
+    "Exploring {} subtrees of interleavings with {} parallel jobs",
+    positions.size(),
+    pool_size);
+
+  /* Every worker explores the subtrees it takes from the queue depth-first,
+   * one interleaving at a time, on its own symex and solver. When some
+   * worker runs out of subtrees, the others donate the unexplored branches
+   * of their shallowest context switch point. The first violation found
+   * stops everyone, unless --all-runs is set. */
+  subtree_queuet queue(std::move(positions));
+  cancellationt stop;
+  std::mutex result_mutex;
+  smt_convt::resultt result = smt_convt::P_UNSATISFIABLE;
+  bool reported = false;
+  std::exception_ptr error;
+
+  auto worker = [&]() {
+    try
+    {
+      // Symex adds symbols to the context it runs on, so only the GOTO
+      // program is actually shared
+      contextt worker_context;
+      context.foreach_operand_in_order(
+        [&worker_context](const symbolt &s) { worker_context.add(s); });
+      optionst worker_options = options;
+
+      bmct bmc(symex->goto_functions, worker_options, worker_context);
+      bmc.cancelled = &stop;
+
+      while (std::optional<reachability_treet::dfs_position> pos = queue.pop())
+      {
+        bmc.symex->setup_for_new_explore();
+        bmc.symex->restore_from_dfs_state(*pos);
+
+        do
+        {
+          std::shared_ptr<symex_target_equationt> worker_eq;
+          smt_convt::resultt res = bmc.run_thread(worker_eq);
+          if (stop)
+            break;
+
+          std::lock_guard lock(result_mutex);
+          if (++interleaving_number > 1)
+            log_status("Thread interleavings {}", interleaving_number);
+
+          if (res == smt_convt::P_SATISFIABLE)
+          {
+            ++interleaving_failed;
+            if (config.options.get_bool_option("smt-model"))
+              bmc.runtime_solver->print_model();
+
+            if (!reported)
+              bmc.report_trace(res, worker_eq);
+            reported = true;
+          }
+
+          if (res)
+          {
+            if (result != smt_convt::P_SATISFIABLE)
+              result = res;
+
+            if (!options.get_bool_option("all-runs"))
+            {
+              stop.cancel();
+              queue.stop();
+              break;
+            }
+          }
+
+          if (queue.starving())
+            queue.push(bmc.symex->donate_unexplored());
+        } while (bmc.symex->setup_next_formula());
+
+        queue.done();
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard lock(result_mutex);
+      if (!error)
+        error = std::current_exception();
+      stop.cancel();
+      queue.stop();
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < pool_size; i++)
+    pool.emplace_back(worker);
+  for (auto &t : pool)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  // Counterexamples were reported by the workers, there is no equation left
+  eq.reset();
+  return result;
+}
+
 void bmct::bidirectional_search(
   std::shared_ptr<smt_convt> &smt_conv,
   std::shared_ptr<symex_target_equationt> &eq)
@@ -455,7 +993,7 @@ void bmct::bidirectional_search(
   // We'll walk list of SSA steps and look for inductive assignments
   std::vector<stack_framet> frames;
   unsigned assert_loop_number = 0;
-  for (auto ssait : eq->SSA_steps)
+  for (const auto &ssait : std::as_const(eq->SSA_steps))
   {
     if (ssait.is_assert() && smt_conv->l_get(ssait.cond_ast).is_false())
     {
@@ -463,7 +1001,8 @@ void bmct::bidirectional_search(
         return;
 
       // Save the location of the failed assertion
-      frames = ssait.stack_trace;
+      if (ssait.stack_trace)
+        frames = *ssait.stack_trace;
       assert_loop_number = ssait.loop_number;
 
       // We are not interested in instructions before the failed assertion yet
@@ -509,7 +1048,7 @@ void bmct::bidirectional_search(
     std::unordered_map<irep_idt, std::pair<expr2tc, expr2tc>, irep_id_hash>
       var_ssa_list;
 
-    for (auto ssait : eq->SSA_steps)
+    for (const auto &ssait : std::as_const(eq->SSA_steps))
     {
       if (ssait.loop_number == lit->get_original_loop_head()->loop_number)
         break;
@@ -615,6 +1154,14 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
     time2string(symex_stop - symex_start),
     eq->SSA_steps.size());
 
+  simplify_cache_statst simp = simplify_cache_stats();
+  log_debug(
+    "simplify",
+    "Simplification cache: {} hits, {} misses, {} evicted",
+    simp.hits,
+    simp.misses,
+    simp.evicted);
+
   if (options.get_bool_option("double-assign-check"))
     eq->check_for_duplicate_assigns();
 
@@ -655,6 +1202,9 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_SMTLIB;
     }
 
+    if (cancelled && *cancelled)
+      return smt_convt::P_SMTLIB;
+
     if (result->remaining_claims == 0)
     {
       if (options.get_bool_option("smt-formula-only"))
@@ -668,6 +1218,20 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
+    if (
+      reused_solver && !options.get_bool_option("multi-property") &&
+      !options.get_bool_option("smt-formula-too") &&
+      !options.get_bool_option("smt-formula-only"))
+      return run_reused_solver_decision_procedure(eq);
+
+    if (
+      !options.get_option("portfolio").empty() &&
+      !options.get_bool_option("smt-during-symex") &&
+      !options.get_bool_option("multi-property") &&
+      !options.get_bool_option("smt-formula-too") &&
+      !options.get_bool_option("smt-formula-only"))
+      return run_portfolio_decision_procedure(eq);
+
     if (!options.get_bool_option("smt-during-symex"))
     {
       runtime_solver =
@@ -701,6 +1265,207 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
   }
 }
 
+bmct::claim_resultt bmct::check_claim(
+  const std::shared_ptr<symex_target_equationt> &eq,
+  size_t claim_nr,
+  cancellationt &cancelled)
+{
+  claim_resultt res;
+  try
+  {
+    // Since this is just a copy, we probably don't need a lock. It shares
+    // the steps with eq: slicing only writes to its own ignore bits
+    auto local_eq = std::make_shared<symex_target_equationt>(*eq);
+    const auto &steps = std::as_const(local_eq->SSA_steps);
+    local_eq->claim_ignore = local_eq->ignore_bits();
+
+    // Set up the current claim and slice it
+    claim_slicer claim(claim_nr);
+    claim.run(steps, local_eq->claim_ignore);
+    symex_slicet slicer(options);
+    slicer.run(steps, local_eq->claim_ignore);
+    res.claim_msg = claim.claim_msg;
+
+    if (cancelled)
+      return res;
+
+    std::string cache_key;
+    if (verification_cache)
+    {
+      cache_key = verification_cache->key(steps, local_eq->claim_ignore);
+      if (verification_cache->lookup(cache_key).is_true())
+      {
+        log_status("Claim '{}' holds (cached)", claim.claim_msg);
+        res.result = smt_convt::P_UNSATISFIABLE;
+        res.solved = true;
+        return res;
+      }
+    }
+
+    // Initialize a solver
+    auto runtime_solver =
+      std::shared_ptr<smt_convt>(create_solver("", ns, options));
+    // Save current instance
+    generate_smt_from_equation(runtime_solver, local_eq);
+
+    if (cancelled)
+      return res;
+
+    log_status(
+      "Solving claim '{}' with solver {}",
+      claim.claim_msg,
+      runtime_solver->solver_text());
+
+    res.result = cancelled.solve(*runtime_solver);
+    // An interrupted solver gives no answer
+    res.solved = !(cancelled && res.result == smt_convt::P_ERROR);
+
+    if (
+      verification_cache && (res.result == smt_convt::P_SATISFIABLE ||
+                             res.result == smt_convt::P_UNSATISFIABLE))
+      verification_cache->store(
+        cache_key, res.result == smt_convt::P_UNSATISFIABLE);
+
+    if (res.result == smt_convt::P_SATISFIABLE && !cancelled)
+    {
+      bool is_compact_trace = true;
+      if (
+        options.get_bool_option("no-slice") &&
+        !options.get_bool_option("compact-trace"))
+        is_compact_trace = false;
+
+      build_goto_trace(
+        local_eq, runtime_solver, res.goto_trace, is_compact_trace);
+    }
+  }
+  catch (...)
+  {
+    res.error = std::current_exception();
+  }
+
+  return res;
+}
+
+void bmct::check_claims_incremental(
+  std::shared_ptr<symex_target_equationt> &eq,
+  const std::vector<size_t> &claims,
+  const std::function<bool()> &should_stop,
+  const std::function<void(claim_resultt &)> &report_claim)
+{
+  // Encode the equation once, sliced for all the claims together, without
+  // asserting any of them
+  auto runtime_solver =
+    std::shared_ptr<smt_convt>(create_solver("", ns, options));
+
+  // Claim N is the N-th assertion of the equation
+  std::vector<symex_target_equationt::SSA_stept *> asserts;
+  for (auto &step : eq->SSA_steps)
+    if (step.is_assert())
+      asserts.push_back(&step);
+
+  // Every claim is checked, even one that is ignored in the equation, as the
+  // claim slicer does for the claim it keeps
+  for (size_t claim_nr : claims)
+  {
+    assert(claim_nr >= 1 && claim_nr <= asserts.size());
+    asserts[claim_nr - 1]->ignore = false;
+  }
+
+  log_status("Encoding shared VCC(s) for {} claim(s)", claims.size());
+  fine_timet encode_start = current_time();
+  eq->convert_steps(*runtime_solver);
+  fine_timet encode_stop = current_time();
+  log_status(
+    "Encoding to solver time: {}s", time2string(encode_stop - encode_start));
+
+  smt_astt false_val = runtime_solver->convert_ast(gen_false_expr());
+  bool is_compact_trace = true;
+  if (
+    options.get_bool_option("no-slice") &&
+    !options.get_bool_option("compact-trace"))
+    is_compact_trace = false;
+
+  for (size_t claim_nr : claims)
+  {
+    if (should_stop())
+      break;
+
+    claim_resultt res;
+    try
+    {
+      symex_target_equationt::SSA_stept &claim = *asserts[claim_nr - 1];
+      res.claim_msg = claim.comment;
+
+      // The cache is keyed by the formula sliced for this claim alone,
+      // which the slicers work out without touching the shared steps
+      std::string cache_key;
+      if (verification_cache)
+      {
+        const auto &steps = std::as_const(eq->SSA_steps);
+        std::vector<bool> claim_ignore = eq->ignore_bits();
+        claim_slicer(claim_nr).run(steps, claim_ignore);
+        symex_slicet(options).run(steps, claim_ignore);
+        cache_key = verification_cache->key(steps, claim_ignore);
+
+        if (verification_cache->lookup(cache_key).is_true())
+        {
+          log_status("Claim '{}' holds (cached)", res.claim_msg);
+          res.result = smt_convt::P_UNSATISFIABLE;
+          res.solved = true;
+          report_claim(res);
+          continue;
+        }
+      }
+
+      // Everything encoded under this context is thrown away after the
+      // claim was checked, while the shared encoding and whatever the
+      // solver learnt about it stay around for the next claim
+      runtime_solver->push_ctx();
+      runtime_solver->assert_ast(runtime_solver->invert_ast(claim.cond_ast));
+
+      log_status(
+        "Solving claim '{}' with solver {}",
+        res.claim_msg,
+        runtime_solver->solver_text());
+
+      res.result = runtime_solver->dec_solve();
+      res.solved = true;
+
+      if (
+        verification_cache && (res.result == smt_convt::P_SATISFIABLE ||
+                               res.result == smt_convt::P_UNSATISFIABLE))
+        verification_cache->store(
+          cache_key, res.result == smt_convt::P_UNSATISFIABLE);
+
+      if (res.result == smt_convt::P_SATISFIABLE)
+      {
+        // Hide the other claims from the trace, as the claim slicer would
+        std::vector<std::pair<symex_target_equationt::SSA_stept *, smt_astt>>
+          hidden;
+        for (auto *step : asserts)
+          if (step != &claim)
+          {
+            hidden.emplace_back(step, step->guard_ast);
+            step->guard_ast = false_val;
+          }
+
+        build_goto_trace(eq, runtime_solver, res.goto_trace, is_compact_trace);
+
+        for (auto &[step, guard_ast] : hidden)
+          step->guard_ast = guard_ast;
+      }
+
+      runtime_solver->pop_ctx();
+    }
+    catch (...)
+    {
+      res.error = std::current_exception();
+    }
+
+    report_claim(res);
+  }
+}
+
 smt_convt::resultt bmct::multi_property_check(
   std::shared_ptr<symex_target_equationt> &eq,
   size_t remaining_claims)
@@ -712,9 +1477,7 @@ smt_convt::resultt bmct::multi_property_check(
 
   // Initial values
   smt_convt::resultt final_result = smt_convt::P_UNSATISFIABLE;
-  std::atomic_size_t ce_counter = 0;
-  std::unordered_set<size_t> jobs;
-  std::mutex result_mutex;
+  size_t ce_counter = 0;
   std::unordered_set<std::string> reached_claims;
   // For coverage info
   int total_instance = 0;
@@ -732,140 +1495,205 @@ smt_convt::resultt bmct::multi_property_check(
     abort();
   }
 
-  // TODO: This is the place to check a cache
+  // For multi-property-jobs
+  const std::string jobs_opt = options.get_option("multi-property-jobs");
+  const int num_workers = !jobs_opt.empty() ? stoi(jobs_opt) : 1;
+  if (num_workers < 0)
+  {
+    log_error("the value of multi-property-jobs should be positive!");
+    abort();
+  }
+
+  // Claims already proven by an earlier run are skipped by the jobs
+  // themselves when --verification-cache is set (see check_claim)
+  std::vector<size_t> jobs;
   for (size_t i = 1; i <= remaining_claims; i++)
-    jobs.emplace(i);
+    jobs.push_back(i);
 
-  /* This is a JOB that will:
-   * 1. Generate a solver instance for a specific claim (@parameter i)
-   * 2. Solve the instance
-   * 3. Generate a Counter-Example (or Witness)
-   *
-   * This job also affects the environment by using:
-   * - &ce_counter: for generating the Counter Example file name
-   * - &final_result: if the current instance is SAT, then we known that the current k contains a bug
+  /* This is a REPORT that will, for the result of a JOB (see check_claim):
+   * 1. Print the Counter-Example of a violated claim, unless it was already
+   *    reported for the same location
+   * 2. Update the final result and the coverage information
    *
-   * Finally, this function is affected by the "multi-fail-fast" option, which makes this instance stop
-   * if final_result is set to SAT
+   * Reports always happen on this thread and in claim order, no matter how
+   * many workers produced the results, so the output is deterministic.
    */
-  auto job_function = [this,
-                       &eq,
+  auto report_claim = [this,
                        &ce_counter,
                        &final_result,
-                       &result_mutex,
                        &reached_claims,
                        &reached_mul_claims,
                        &total_instance,
                        &is_goto_cov,
-                       &is_fail_fast,
-                       &fail_fast_limit,
-                       &fail_fast_cnt](const size_t &i) {
-    //"multi-fail-fast n": stop after first n SATs found.
-    if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
+                       &fail_fast_cnt](claim_resultt &res) {
+    if (res.error)
+      std::rethrow_exception(res.error);
+
+    if (!res.solved)
       return;
 
-    // Since this is just a copy, we probably don't need a lock
-    auto local_eq = std::make_shared<symex_target_equationt>(*eq);
+    total_instance++;
 
-    // Set up the current claim and slice it
-    claim_slicer claim(i);
-    claim.run(local_eq->SSA_steps);
-    symex_slicet slicer(options);
-    slicer.run(local_eq->SSA_steps);
+    if (res.result != smt_convt::P_SATISFIABLE)
+      return;
 
-    // Initialize a solver
-    auto runtime_solver =
-      std::shared_ptr<smt_convt>(create_solver("", ns, options));
-    // Save current instance
-    generate_smt_from_equation(runtime_solver, local_eq);
+    const goto_tracet &goto_trace = res.goto_trace;
 
-    log_status(
-      "Solving claim '{}' with solver {}",
-      claim.claim_msg,
-      runtime_solver->solver_text());
-    total_instance++;
+    // Store the comment and location of the assertion
+    // to avoid double verifying the claims that are already verified
+    std::string cmt_loc = "";
 
-    smt_convt::resultt result = runtime_solver->dec_solve();
+    for (const auto &step : goto_trace.steps)
+      if (step.type == goto_trace_stept::ASSERT)
+      {
+        // since we only handle one claim at a time
+        // we will/should not overwrite the loc
+        assert(cmt_loc == "");
+        std::string loc;
+        if (step.pc->location.is_nil())
+          loc = "nil";
+        else
+          loc = step.pc->location.as_string();
+
+        // we use the "comment + location" to distinguish each claim
+        // e.g. "Claim x: ... location line y"
+        // x is unique. However, the unwinding asserts do not have these Claim x prefixes.
+        // Therefore we add the location behind, as the line number y for each unwinding assert is different.
+        cmt_loc = step.comment + "\t" + loc;
+      }
 
-    // This try-catch is mainly for fail-fast.
+    bool is_unverified = false;
 
-    if (result == smt_convt::P_SATISFIABLE)
+    if (is_goto_cov)
     {
-      bool is_compact_trace = true;
-      if (
-        options.get_bool_option("no-slice") &&
-        !options.get_bool_option("compact-trace"))
-        is_compact_trace = false;
+      reached_mul_claims.emplace(cmt_loc);
+      is_unverified = true;
+    }
+    else
+    {
+      // the ins is true if the element was actually inserted
+      auto [it, ins] = reached_claims.emplace(cmt_loc);
+      is_unverified = ins;
+    }
+
+    if (is_unverified || options.get_bool_option("keep-verified-claims"))
+    {
+      std::string output_file = options.get_option("cex-output");
+      if (output_file != "")
+      {
+        std::ofstream out(fmt::format("{}-{}", ce_counter++, output_file));
+        show_goto_trace(out, ns, goto_trace);
+      }
+      std::ostringstream oss;
+      log_fail("\n[Counterexample]\n");
+      show_goto_trace(oss, ns, goto_trace);
+      log_result("{}", oss.str());
+      final_result = res.result;
+      // update fail-fast-counter
+      fail_fast_cnt++;
+    }
+    else
+    {
+      // we should not be here if "keep-verified-claims" is enabled
+      log_status("\nFound verified claim. Skipping...\n");
 
-      goto_tracet goto_trace;
-      build_goto_trace(local_eq, runtime_solver, goto_trace, is_compact_trace);
+      //TODO: this can still be annoying when we unind for many times
+      // e.g. '--unwind 100' will show 1 counterexample and 99 'skip's
+      // Maybe we should use log_debug instead, both in slicer.run and multi_property_check
+    }
+  };
 
-      // Store the comment and location of the assertion
-      // to avoid double verifying the claims that are already verified
-      std::string cmt_loc = "";
+  //"multi-fail-fast n": stop after first n SATs found.
+  auto should_stop = [&is_fail_fast, &fail_fast_limit, &fail_fast_cnt]() {
+    return is_fail_fast && fail_fast_cnt >= fail_fast_limit;
+  };
 
-      for (const auto &step : goto_trace.steps)
-        if (step.type == goto_trace_stept::ASSERT)
-        {
-          // since we only handle one claim at a time
-          // we will/should not overwrite the loc
-          assert(cmt_loc == "");
-          std::string loc;
-          if (step.pc->location.is_nil())
-            loc = "nil";
-          else
-            loc = step.pc->location.as_string();
-
-          // we use the "comment + location" to distinguish each claim
-          // e.g. "Claim x: ... location line y"
-          // x is unique. However, the unwinding asserts do not have these Claim x prefixes.
-          // Therefore we add the location behind, as the line number y for each unwinding assert is different.
-          cmt_loc = step.comment + "\t" + loc;
-        }
+  // "multi-property-jobs 0" uses one worker per hardware thread
+  cancellationt cancelled;
+  const size_t pool_size = std::min<size_t>(
+    num_workers ? num_workers : std::thread::hardware_concurrency(),
+    jobs.size());
 
-      bool is_unverified = false;
+  if (options.get_bool_option("multi-property-incremental"))
+  {
+    if (pool_size > 1)
+      log_warning(
+        "--multi-property-incremental checks every claim on one solver, "
+        "ignoring --multi-property-jobs");
 
-      if (is_goto_cov)
+    check_claims_incremental(eq, jobs, should_stop, report_claim);
+  }
+  else if (pool_size <= 1)
+  {
+    for (size_t claim : jobs)
+    {
+      if (should_stop())
+        break;
+
+      claim_resultt res = check_claim(eq, claim, cancelled);
+      report_claim(res);
+    }
+  }
+  else
+  {
+    /* Every worker claims the next pending job and stores its result in the
+     * slot of that job. The results are then reported in order as soon as
+     * the prefix before them is complete. Once fail-fast triggers, workers
+     * stop taking new jobs and in-flight ones are abandoned at their next
+     * phase boundary (slicing, encoding, solving). */
+    std::vector<claim_resultt> results(jobs.size());
+    std::vector<bool> finished(jobs.size(), false);
+    std::mutex result_mutex;
+    std::condition_variable result_cv;
+    std::atomic_size_t next_job = 0;
+
+    auto worker = [&]() {
+      for (size_t i = next_job++; i < jobs.size() && !cancelled;
+           i = next_job++)
       {
-        reached_mul_claims.emplace(cmt_loc);
-        is_unverified = true;
+        claim_resultt res = check_claim(eq, jobs[i], cancelled);
+        std::lock_guard lock(result_mutex);
+        results[i] = std::move(res);
+        finished[i] = true;
+        result_cv.notify_all();
       }
-      else
+    };
+
+    log_status(
+      "Checking {} claims with {} parallel jobs", jobs.size(), pool_size);
+
+    std::vector<std::thread> pool;
+    for (size_t i = 0; i < pool_size; i++)
+      pool.emplace_back(worker);
+
+    std::exception_ptr error;
+    for (size_t i = 0; i < jobs.size() && !should_stop(); i++)
+    {
+      claim_resultt res;
       {
-        // the ins is true if the element was actually inserted
-        auto [it, ins] = reached_claims.emplace(cmt_loc);
-        is_unverified = ins;
+        std::unique_lock lock(result_mutex);
+        result_cv.wait(lock, [&finished, i]() { return finished[i]; });
+        res = std::move(results[i]);
       }
 
-      if (is_unverified || options.get_bool_option("keep-verified-claims"))
+      try
       {
-        std::string output_file = options.get_option("cex-output");
-        if (output_file != "")
-        {
-          std::ofstream out(fmt::format("{}-{}", ce_counter++, output_file));
-          show_goto_trace(out, ns, goto_trace);
-        }
-        std::ostringstream oss;
-        log_fail("\n[Counterexample]\n");
-        show_goto_trace(oss, ns, goto_trace);
-        log_result("{}", oss.str());
-        final_result = result;
-        // update fail-fast-counter
-        fail_fast_cnt++;
+        report_claim(res);
       }
-      else
+      catch (...)
       {
-        // we should not be here if "keep-verified-claims" is enabled
-        log_status("\nFound verified claim. Skipping...\n");
-
-        //TODO: this can still be annoying when we unind for many times
-        // e.g. '--unwind 100' will show 1 counterexample and 99 'skip's
-        // Maybe we should use log_debug instead, both in slicer.run and multi_property_check
+        error = std::current_exception();
+        break;
       }
     }
-  };
 
-  std::for_each(std::begin(jobs), std::end(jobs), job_function);
+    cancelled.cancel();
+    for (auto &t : pool)
+      t.join();
+
+    if (error)
+      std::rethrow_exception(error);
+  }
 
   // For coverage
   if (is_goto_cov)
@@ -5,13 +5,79 @@
 #include <goto-symex/reachability_tree.h>
 #include <goto-symex/symex_target_equation.h>
 #include <langapi/language_ui.h>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <list>
 #include <map>
+#include <mutex>
 #include <solvers/smt/smt_conv.h>
 #include <solvers/smtlib/smtlib_conv.h>
 #include <solvers/solve.h>
 #include <util/options.h>
 #include <util/algorithms.h>
+#include <util/cache.h>
+
+/**
+ * Solver state carried across the bounds of an incremental verification
+ * strategy (--k-induction, --incremental-bmc, ...), one per kind of check.
+ *
+ * This is not incremental BMC in the sense of extending the last unwinding:
+ * symbolic execution still runs from scratch for every bound. Only the
+ * leading steps that the equations of consecutive bounds have in common are
+ * encoded once, at the base context level of a solver that stays alive.
+ * The steps specific to the current bound are encoded in a push_ctx/pop_ctx
+ * scope that is discarded when the next bound is checked. If a new equation
+ * diverges inside the shared prefix, the solver is rebuilt from scratch.
+ */
+class reused_solvert
+{
+public:
+  explicit reused_solvert(const contextt &context) : ns(context)
+  {
+  }
+
+  /// outlives the bmct objects that use the solver
+  namespacet ns;
+  std::shared_ptr<smt_convt> solver;
+  /// equation of the last bound, with the ASTs of its steps
+  std::shared_ptr<symex_target_equationt> last_eq;
+  /// number of leading steps encoded at the base context level
+  size_t committed = 0;
+  /// assumptions and negated claims of the committed steps
+  smt_astt committed_assumptions = nullptr;
+  smt_convt::ast_vec committed_assertions;
+  /// whether the scope of the last bound still has to be popped
+  bool in_ctx = false;
+};
+
+/**
+ * Raised from another thread once the result of some work is no longer
+ * wanted. The work polls it between its phases, and the solvers it runs
+ * through solve() are interrupted when it is raised, instead of running to
+ * completion in vain.
+ */
+class cancellationt
+{
+public:
+  /// raise it and interrupt the solvers running under it
+  void cancel();
+  /// lower it again, for the next piece of work
+  void reset();
+
+  explicit operator bool() const
+  {
+    return cancelled;
+  }
+
+  /// solver.dec_solve(), unless already cancelled, in which case P_ERROR
+  smt_convt::resultt solve(smt_convt &solver);
+
+private:
+  std::atomic_bool cancelled = false;
+  std::mutex mutex;
+  std::vector<smt_convt *> solving;
+};
 
 class bmct
 {
@@ -20,6 +86,13 @@ public:
 
   optionst &options;
 
+  /// if set, the decision procedure reuses this solver state
+  std::shared_ptr<reused_solvert> reused_solver;
+
+  /// if set and raised, the run gives up (with P_SMTLIB) before solving, or
+  /// its solver is interrupted if it is solving already
+  cancellationt *cancelled = nullptr;
+
   BigInt interleaving_number;
   BigInt interleaving_failed;
 
@@ -37,6 +110,18 @@ protected:
     std::shared_ptr<smt_convt> &smt_conv,
     std::shared_ptr<symex_target_equationt> &eq);
 
+  smt_convt::resultt run_reused_solver_decision_procedure(
+    std::shared_ptr<symex_target_equationt> &eq);
+
+  /**
+   * Races the solvers listed in --portfolio on \p eq, each converting its
+   * own copy of it on its own thread. The first sat or unsat answer wins and
+   * the other solvers are interrupted. On return, runtime_solver and \p eq
+   * are those of the winner, so that its model gives the trace.
+   */
+  smt_convt::resultt
+  run_portfolio_decision_procedure(std::shared_ptr<symex_target_equationt> &eq);
+
   virtual void show_program(std::shared_ptr<symex_target_equationt> &eq);
   virtual void report_success();
   virtual void report_failure();
@@ -66,10 +151,58 @@ protected:
     std::shared_ptr<symex_target_equationt> &eq);
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
+
+  /**
+   * Splits the reachability tree after a few context switches and explores
+   * the subtrees on up to \p num_jobs workers, each with its own symex and
+   * solver. Counterexamples are reported by the workers, so \p eq is left
+   * empty.
+   */
+  smt_convt::resultt run_parallel_interleavings(
+    std::shared_ptr<symex_target_equationt> &eq,
+    size_t num_jobs);
   smt_convt::resultt multi_property_check(
     std::shared_ptr<symex_target_equationt> &eq,
     size_t remaining_claims);
+
+  /// Outcome of checking a single claim in multi-property mode
+  struct claim_resultt
+  {
+    smt_convt::resultt result = smt_convt::P_ERROR;
+    /// false if the job was cancelled before the solver gave an answer
+    bool solved = false;
+    std::string claim_msg;
+    /// only filled in when the claim is violated
+    goto_tracet goto_trace;
+    /// exception raised by the job, rethrown by the reporting thread
+    std::exception_ptr error;
+  };
+
+  /**
+   * Slices, encodes and solves claim number \p claim on a private copy of
+   * \p eq. Only touches state owned by the job, so that any number of them
+   * can run concurrently. \p cancelled is polled between the phases, and
+   * interrupts the solver.
+   */
+  claim_resultt check_claim(
+    const std::shared_ptr<symex_target_equationt> &eq,
+    size_t claim,
+    cancellationt &cancelled);
+
+  /**
+   * Checks \p claims one after the other on a single solver. The equation
+   * is encoded only once; each claim is then asserted in its own
+   * push_ctx/pop_ctx scope, reusing the encoding cache and the solver's
+   * learnt clauses. Each result is handed to \p report_claim as it arrives.
+   */
+  void check_claims_incremental(
+    std::shared_ptr<symex_target_equationt> &eq,
+    const std::vector<size_t> &claims,
+    const std::function<bool()> &should_stop,
+    const std::function<void(claim_resultt &)> &report_claim);
   std::vector<std::unique_ptr<ssa_step_algorithm>> algorithms;
+  /// verdicts of previously checked claims, if --verification-cache is set
+  std::unique_ptr<verification_cachet> verification_cache;
 
   void generate_smt_from_equation(
     std::shared_ptr<smt_convt> &smt_conv,
@@ -24,6 +24,7 @@ extern "C"
 #include <csignal>
 #include <cstdlib>
 #include <util/expr_util.h>
+#include <condition_variable>
 #include <iostream>
 #include <goto-programs/add_race_assertions.h>
 #include <goto-programs/goto_check.h>
@@ -45,11 +46,13 @@ extern "C"
 #include <langapi/languages.h>
 #include <langapi/mode.h>
 #include <memory>
+#include <mutex>
 #include <pointer-analysis/goto_program_dereference.h>
 #include <pointer-analysis/show_value_sets.h>
 #include <pointer-analysis/value_set_analysis.h>
 #include <util/symbol.h>
 #include <util/time_stopping.h>
+#include <thread>
 
 #ifndef _WIN32
 #include <sys/wait.h>
@@ -71,12 +74,6 @@ enum PROCESS_TYPE
   PARENT
 };
 
-struct resultt
-{
-  PROCESS_TYPE type;
-  uint64_t k;
-};
-
 #ifndef _WIN32
 void timeout_handler(int)
 {
@@ -260,6 +257,13 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   if (cmdline.isset("bv"))
     options.set_option("int-encoding", false);
 
+  // Must be set before the frontend creates any irep2
+  irep2_hash_consing = cmdline.isset("hash-consing");
+
+  if (cmdline.isset("simplify-cache-size"))
+    irep2_simplify_cache_size =
+      strtoul(cmdline.getval("simplify-cache-size"), nullptr, 10);
+
   if (cmdline.isset("ir"))
     options.set_option("int-encoding", true);
 
@@ -273,6 +277,29 @@ void esbmc_parseoptionst::get_command_line_options(optionst &options)
   else
     options.set_option("context-bound", -1);
 
+  // Sleep sets assume that a transition they skip can still be taken later
+  // on, which neither bounding context switches nor pruning visited states
+  // guarantees
+  if (
+    cmdline.isset("dpor") &&
+    (atoi(options.get_option("context-bound").c_str()) != -1 ||
+     cmdline.isset("state-hashing")))
+  {
+    log_warning(
+      "--dpor is unsound with --context-bound or --state-hashing, using the "
+      "default partial order reduction");
+    options.set_option("dpor", false);
+  }
+
+  // Pass every solver on, one command per line
+  if (cmdline.isset("smtlib-solver-prog"))
+  {
+    std::string progs;
+    for (const std::string &prog : cmdline.get_values("smtlib-solver-prog"))
+      progs += prog + "\n";
+    options.set_option("smtlib-solver-prog", progs);
+  }
+
   if (cmdline.isset("deadlock-check"))
   {
     options.set_option("deadlock-check", true);
@@ -481,8 +508,7 @@ int esbmc_parseoptionst::doit()
 
   // Run this before the main flow. This method performs its own
   // parsing and preprocessing.
-  // This is an old implementation of parallel k-induction algorithm.
-  // Eventually we will modify it and implement parallel version for all
+  // Eventually we will implement a parallel version for all
   // available strategies. Just run it first before everything else
   // for now.
   if (cmdline.isset("k-induction-parallel"))
@@ -526,566 +552,377 @@ int esbmc_parseoptionst::doit()
   return do_bmc(bmc);
 }
 
-// This is the parallel version of k-induction algorithm.
-// This is an old implementation and should be revisited sometime in the
-// future.
-int esbmc_parseoptionst::doit_k_induction_parallel()
+namespace
 {
-#ifdef _WIN32
-  log_error("Windows does not support parallel kind");
-  abort();
-#else
-  // Pipes for communication between processes
-  int forward_pipe[2], backward_pipe[2];
-
-  // Process type
-  PROCESS_TYPE process_type = PARENT;
-
-  if (pipe(forward_pipe))
+// One thread of the parallel k-induction. It checks the bounds of a single
+// step, one at a time, as handed out by the broker.
+struct k_induction_workert
+{
+  explicit k_induction_workert(PROCESS_TYPE _step) : step(_step)
   {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
   }
 
-  if (pipe(backward_pipe))
-  {
-    log_status("\nPipe Creation Failed, giving up.");
-    _exit(1);
-  }
+  const PROCESS_TYPE step;
+
+  // Bound under check, valid while busy
+  BigInt k;
+  bool busy = false;
 
-  /* Set file descriptor non-blocking */
-  fcntl(
-    backward_pipe[0], F_SETFL, fcntl(backward_pipe[0], F_GETFL) | O_NONBLOCK);
+  // Raised by the broker once the bound being checked became obsolete
+  cancellationt cancelled;
+};
+
+// Hands out the bounds of every step to the workers and collects their
+// results. A bug found by the base case makes every bound above it
+// obsolete; a proof found by the forward condition or the inductive step
+// does the same to every bound that is not needed to confirm it. Obsolete
+// workers are cancelled as soon as the broker learns about it.
+class k_induction_brokert
+{
+public:
+  k_induction_brokert(
+    std::vector<std::unique_ptr<k_induction_workert>> &_workers,
+    const BigInt &_max_k_step,
+    unsigned _k_step_inc,
+    const BigInt &_max_inductive_step)
+    : workers(_workers),
+      max_k_step(_max_k_step),
+      k_step_inc(_k_step_inc),
+      max_inductive_step(_max_inductive_step),
+      active(_workers.size())
+  {
+    // The forward condition and the inductive step start at k = 2
+    next_k[BASE_CASE] = 1;
+    next_k[FORWARD_CONDITION] = 2;
+    next_k[INDUCTIVE_STEP] = 2;
+  }
+
+  // Assigns the next bound of its step to the worker. Returns false, and
+  // retires the worker, if there is nothing useful left for it to check.
+  bool claim(k_induction_workert &w)
+  {
+    std::lock_guard lock(mutex);
+    w.busy = false;
+
+    if (verdict == UNDECIDED && next_k[w.step] <= limit(w.step))
+    {
+      w.k = next_k[w.step];
+      next_k[w.step] += k_step_inc;
+      w.busy = true;
+      return true;
+    }
 
-  pid_t children_pid[3];
-  short num_p = 0;
+    if (--active == 0)
+      decide();
+    return false;
+  }
 
-  // We need to fork 3 times: one for each step
-  for (unsigned p = 0; p < 3; ++p)
+  // Records the outcome of the bound the worker has just checked
+  void report(k_induction_workert &w, smt_convt::resultt res)
   {
-    pid_t pid = fork();
+    std::lock_guard lock(mutex);
+    w.busy = false;
 
-    if (pid == -1)
+    // A cancelled bound tells nothing
+    if (w.cancelled)
+      w.cancelled.reset();
+    else if (w.step == BASE_CASE)
     {
-      log_status("\nFork Failed, giving up.");
-      _exit(1);
+      if (res == smt_convt::P_SATISFIABLE && (bug_k == 0 || w.k < bug_k))
+        bug_k = w.k;
+      else if (res == smt_convt::P_UNSATISFIABLE && w.k > safe_k)
+        safe_k = w.k;
     }
-
-    // Child process
-    if (!pid)
+    else if (
+      res == smt_convt::P_UNSATISFIABLE && (proof_k == 0 || w.k < proof_k))
     {
-      process_type = PROCESS_TYPE(p);
-      break;
+      proof_k = w.k;
+      proof_step = w.step;
     }
-    // Parent process
 
-    children_pid[p] = pid;
-    ++num_p;
+    decide();
+    cancel_obsolete();
   }
 
-  if (process_type == PARENT && num_p != 3)
+  // Blocks until a verdict is known or every worker has retired
+  void wait()
   {
-    log_error("Child processes were not created sucessfully.");
-    abort();
+    std::unique_lock lock(mutex);
+    done.wait(lock, [this] { return verdict != UNDECIDED; });
   }
 
-  optionst options;
-
-  if (process_type != PARENT)
+  // Stops every worker that is still running
+  void cancel_all()
   {
-    // Get full set of options
-    get_command_line_options(options);
-
-    // Generate goto functions and set claims
-    if (get_goto_program(options, goto_functions))
-      return 6;
-
-    if (cmdline.isset("show-claims"))
-    {
-      const namespacet ns(context);
-      show_claims(ns, goto_functions);
-      return 0;
-    }
-
-    if (set_claims(goto_functions))
-      return 7;
+    std::lock_guard lock(mutex);
+    for (auto &w : workers)
+      if (w->busy)
+        w->cancelled.cancel();
   }
 
-  // Get max number of iterations
-  BigInt max_k_step = cmdline.isset("unlimited-k-steps")
-                        ? UINT_MAX
-                        : strtoul(cmdline.getval("max-k-step"), nullptr, 10);
-
-  // Get the increment
-  unsigned k_step_inc = strtoul(cmdline.getval("k-step"), nullptr, 10);
-
-  // All processes were created successfully
-  switch (process_type)
-  {
-  case PARENT:
+  enum verdictt
   {
-    // Communication to child processes
-    close(forward_pipe[1]);
-    close(backward_pipe[0]);
-
-    struct resultt a_result;
-    bool bc_finished = false, fc_finished = false, is_finished = false;
-    BigInt bc_solution = max_k_step, fc_solution = max_k_step,
-           is_solution = max_k_step;
-
-    // Keep reading until we find an answer
-    while (!(bc_finished && fc_finished && is_finished))
-    {
-      // Perform read and interpret the number of bytes read
-      int read_size = read(forward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          ;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction children");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-          abort();
-        }
-      }
-
-      // Eventually the parent process will check if the child process is alive
+    UNDECIDED,
+    BUG,
+    PROOF,
+    UNKNOWN
+  };
 
-      // Check base case process
-      if (!bc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[0], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("base case process crashed.");
-          bc_finished = fc_finished = is_finished = true;
-        }
-      }
-
-      // Check forward condition process
-      if (!fc_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[1], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("forward condition process crashed.");
-          fc_finished = bc_finished = is_finished = true;
-        }
-      }
-
-      // Check inductive step process
-      if (!is_finished)
-      {
-        int status;
-        pid_t result = waitpid(children_pid[2], &status, WNOHANG);
-        if (result == 0)
-        {
-          // Child still alive
-        }
-        else if (result == -1)
-        {
-          // Error
-        }
-        else
-        {
-          log_warning("inductive step process crashed.");
-          is_finished = bc_finished = fc_finished = true;
-        }
-      }
-
-      switch (a_result.type)
-      {
-      case BASE_CASE:
-        bc_finished = true;
-        bc_solution = a_result.k;
-        break;
-
-      case FORWARD_CONDITION:
-        fc_finished = true;
-        fc_solution = a_result.k;
-        break;
-
-      case INDUCTIVE_STEP:
-        is_finished = true;
-        is_solution = a_result.k;
-        break;
-
-      default:
-        log_error("Message from unrecognized k-induction child process");
-        abort();
-      }
-
-      // If either the base case found a bug or the forward condition
-      // finds a solution, present the result
-      if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
-        break;
-
-      // If the either the forward condition or inductive step finds a
-      // solution, first check if base case couldn't find a bug in that code,
-      // if there is no bug, inductive step can present the result
-      if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the inductive step process
-        kill(children_pid[2], SIGKILL);
-
-        // And ask base case for a solution
+  verdictt verdict = UNDECIDED;
 
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
+  // The bound the verdict was reached at, and the step that proved it
+  BigInt verdict_k;
+  PROCESS_TYPE verdict_step = PARENT;
 
-        r.k = fc_solution.to_uint64();
+private:
+  std::vector<std::unique_ptr<k_induction_workert>> &workers;
+  const BigInt max_k_step;
+  const unsigned k_step_inc;
+  const BigInt max_inductive_step;
 
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-
-      if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
-      {
-        // If base case finished, then we can present the result
-        if (bc_finished)
-          break;
-
-        // Otherwise, kill the forward condition process
-        kill(children_pid[1], SIGKILL);
+  std::mutex mutex;
+  std::condition_variable done;
 
-        // And ask base case for a solution
+  size_t active;
+  BigInt next_k[3];
 
-        // Struct to keep the result
-        struct resultt r = {process_type, 0};
-
-        r.k = is_solution.to_uint64();
-
-        // Write result
-        auto const len = write(backward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-      }
-    }
+  // Smallest bound with a bug, largest bug-free bound of the base case and
+  // smallest bound proven by the other steps (0 if none)
+  BigInt bug_k = 0, safe_k = 0, proof_k = 0;
+  PROCESS_TYPE proof_step = PARENT;
 
-    for (int i : children_pid)
-      kill(i, SIGKILL);
+  // The largest bound of the step still worth checking
+  BigInt limit(PROCESS_TYPE step) const
+  {
+    BigInt l = max_k_step;
+    if (step == INDUCTIVE_STEP && max_inductive_step < l)
+      l = max_inductive_step;
 
-    // Check if a solution was found by the base case
-    if (bc_finished && (bc_solution != 0) && (bc_solution != max_k_step))
+    if (step != BASE_CASE)
     {
-      log_result(
-        "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
-        bc_solution);
-      return true;
+      // Neither step is needed after a bug and only smaller proofs matter
+      if (bug_k != 0)
+        return 0;
+      if (proof_k != 0)
+        l = proof_k - 1;
+      return l;
     }
 
-    // Check if a solution was found by the forward condition
-    if (fc_finished && (fc_solution != 0) && (fc_solution != max_k_step))
-    {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the forward condition; "
-          "all states are reachable (k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          fc_solution);
-        return false;
-      }
-    }
+    // Only a smaller bug could still change the verdict
+    if (bug_k != 0)
+      l = bug_k - 1;
 
-    // Check if a solution was found by the inductive step
-    if (is_finished && (is_solution != 0) && (is_solution != max_k_step))
+    // A proof holds once the base case is bug-free for a bound as large
+    if (proof_k != 0)
     {
-      // We should only present the result if the base case finished
-      // and haven't crashed (if it crashed, bc_solution will be UINT_MAX
-      if (bc_finished && (bc_solution != max_k_step))
-      {
-        log_success(
-          "\nSolution found by the inductive step "
-          "(k = {:d})\n"
-          "VERIFICATION SUCCESSFUL",
-          is_solution);
-        return false;
-      }
+      BigInt first = 1;
+      if (proof_k > 1)
+        first += ((proof_k - 2) / k_step_inc + 1) * k_step_inc;
+      if (first < l)
+        l = first;
     }
 
-    // Couldn't find a bug or a proof for the current deepth
-    log_fail("\nVERIFICATION UNKNOWN");
-    return false;
+    return l;
   }
 
-  case BASE_CASE:
+  bool pending_base_case_below(const BigInt &k) const
   {
-    // Set that we are running base case
-    options.set_option("base-case", true);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", false);
+    for (auto &w : workers)
+      if (w->busy && w->step == BASE_CASE && w->k < k)
+        return true;
+    return false;
+  }
 
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
+  void set_verdict(verdictt v, const BigInt &k, PROCESS_TYPE step)
+  {
+    verdict = v;
+    verdict_k = k;
+    verdict_step = step;
+    done.notify_all();
+  }
 
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
+  void decide()
+  {
+    if (verdict != UNDECIDED)
+      return;
 
-    // Run bmc and only send results in two occasions:
-    // 1. A bug was found, we send the step where it was found
-    // 2. It couldn't find a bug
-    for (BigInt k_step = 1; k_step <= max_k_step; k_step += k_step_inc)
+    // Report the smallest bug, so wait for the base case below it
+    if (bug_k != 0)
     {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
+      if (!pending_base_case_below(bug_k))
+        set_verdict(BUG, bug_k, BASE_CASE);
+    }
+    else if (proof_k != 0 && safe_k >= proof_k)
+      set_verdict(PROOF, proof_k, proof_step);
+    else if (active == 0)
+      set_verdict(UNKNOWN, 0, PARENT);
+  }
 
-      log_status("Checking base case, k = {:d}\n", k_step);
+  void cancel_obsolete()
+  {
+    for (auto &w : workers)
+      if (w->busy && (verdict != UNDECIDED || w->k > limit(w->step)))
+        w->cancelled.cancel();
+  }
+};
+} // namespace
 
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
-      {
-        break;
-      }
+// This is the parallel version of k-induction algorithm. Every step (base
+// case, forward condition and inductive step) is run by its own pool of
+// threads, which share the GOTO program and claim the bounds to check from
+// a broker (see k_induction_brokert) until a verdict is known.
+int esbmc_parseoptionst::doit_k_induction_parallel()
+{
+  optionst options;
+  get_command_line_options(options);
 
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_SATISFIABLE)
-      {
-        r.k = k_step.to_uint64();
+  // Generate goto functions and set claims
+  if (get_goto_program(options, goto_functions))
+    return 6;
 
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
+  if (cmdline.isset("show-claims"))
+  {
+    const namespacet ns(context);
+    show_claims(ns, goto_functions);
+    return 0;
+  }
 
-        log_status("Base case process finished (bug found).\n");
-        return true;
-      }
+  if (set_claims(goto_functions))
+    return 7;
 
-      // Check if the parent process is asking questions
+  // Get max number of iterations
+  BigInt max_k_step = cmdline.isset("unlimited-k-steps")
+                        ? UINT_MAX
+                        : strtoul(cmdline.getval("max-k-step"), nullptr, 10);
 
-      // Perform read and interpret the number of bytes read
-      struct resultt a_result;
-      int read_size = read(backward_pipe[0], &a_result, sizeof(resultt));
-      if (read_size != sizeof(resultt))
-      {
-        if (read_size == 0)
-        {
-          // Client hung up; continue on, but don't interpret the result.
-          continue;
-        }
-        if (read_size == -1 && errno == EAGAIN)
-        {
-          // No data available yet
-          continue;
-        }
-        else
-        {
-          // Invalid size read.
-          log_error("Short read communicating with kinduction parent");
-          log_error("Size {}, expected {}", read_size, sizeof(resultt));
-
-          abort();
-        }
-      }
+  // Get the increment
+  unsigned k_step_inc = strtoul(cmdline.getval("k-step"), nullptr, 10);
 
-      // We only receive messages from the parent
-      assert(a_result.type == PARENT);
+  BigInt max_inductive_step =
+    strtoul(cmdline.getval("max-inductive-step"), nullptr, 10);
 
-      // If the value being asked is greater or equal the current step,
-      // then we can stop the base case. It can be equal, because we
-      // have just checked the current value of k
-      if (a_result.k < k_step)
-        break;
+  // "k-induction-workers 0" splits the hardware threads between the steps
+  const std::string workers_opt = options.get_option("k-induction-workers");
+  const int num_workers = !workers_opt.empty() ? stoi(workers_opt) : 1;
+  if (num_workers < 0)
+  {
+    log_error("the value of k-induction-workers should be positive!");
+    abort();
+  }
 
-      // Otherwise, we just need to check the base case for k = a_result.k
-      max_k_step = a_result.k + k_step_inc;
-    }
+  const size_t per_step =
+    num_workers ? num_workers
+                : std::max(1u, std::thread::hardware_concurrency() / 3);
 
-    // Send information to parent that a bug was not found
-    r.k = 0;
+  std::vector<std::unique_ptr<k_induction_workert>> workers;
+  for (size_t i = 0; i < per_step; ++i)
+  {
+    workers.push_back(std::make_unique<k_induction_workert>(BASE_CASE));
 
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
+    if (!options.get_bool_option("disable-forward-condition"))
+      workers.push_back(
+        std::make_unique<k_induction_workert>(FORWARD_CONDITION));
 
-    log_status("Base case process finished (no bug found).\n");
-    return false;
+    if (!options.get_bool_option("disable-inductive-step"))
+      workers.push_back(std::make_unique<k_induction_workert>(INDUCTIVE_STEP));
   }
 
-  case FORWARD_CONDITION:
-  {
-    // Set that we are running forward condition
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", true);
-    options.set_option("inductive-step", false);
-
-    options.set_option("no-unwinding-assertions", false);
-    options.set_option("partial-loops", false);
-    options.set_option("no-assertions", true);
+  k_induction_brokert broker(
+    workers, max_k_step, k_step_inc, max_inductive_step);
 
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
+  auto run_worker = [&](k_induction_workert &w) {
+    // Every worker sets up its own step, and symex adds symbols to the
+    // context it runs on, so only the GOTO program is actually shared
+    optionst step_options = options;
+    step_options.set_option("base-case", w.step == BASE_CASE);
+    step_options.set_option("forward-condition", w.step == FORWARD_CONDITION);
+    step_options.set_option("inductive-step", w.step == INDUCTIVE_STEP);
+    step_options.set_option(
+      "no-unwinding-assertions", w.step != FORWARD_CONDITION);
+    step_options.set_option("partial-loops", w.step == INDUCTIVE_STEP);
+    if (w.step == FORWARD_CONDITION)
+      step_options.set_option("no-assertions", true);
 
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
+    contextt worker_context;
+    context.foreach_operand_in_order(
+      [&worker_context](const symbolt &s) { worker_context.add(s); });
 
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (BigInt k_step = 2; k_step <= max_k_step; k_step += k_step_inc)
+    while (broker.claim(w))
     {
-      bmct bmc(goto_functions, options, context);
-      bmc.options.set_option("unwind", integer2string(k_step));
+      step_options.set_option("unwind", integer2string(w.k));
 
-      log_status("Checking forward condition, k = {:d}", k_step);
+      bmct bmc(goto_functions, step_options, worker_context);
+      bmc.cancelled = &w.cancelled;
 
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
-      try
-      {
-        res = do_bmc(bmc);
-      }
-      catch (...)
+      switch (w.step)
       {
+      case BASE_CASE:
+        log_status("Checking base case, k = {:d}", w.k);
         break;
-      }
-
-      if (options.get_bool_option("disable-forward-condition"))
+      case FORWARD_CONDITION:
+        log_status("Checking forward condition, k = {:d}", w.k);
         break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step.to_uint64();
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Forward condition process finished (safety proven).");
-        return false;
+      default:
+        log_status("Checking inductive step, k = {:d}", w.k);
       }
-    }
-
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
-
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
-
-    log_status("Forward condition process finished (safety not proven).");
-    return true;
-  }
-
-  case INDUCTIVE_STEP:
-  {
-    // Set that we are running inductive step
-    options.set_option("base-case", false);
-    options.set_option("forward-condition", false);
-    options.set_option("inductive-step", true);
-
-    options.set_option("no-unwinding-assertions", true);
-    options.set_option("partial-loops", true);
-
-    // Start communication to the parent process
-    close(forward_pipe[0]);
-    close(backward_pipe[1]);
 
-    // Struct to keep the result
-    struct resultt r = {process_type, 0};
-
-    // Run bmc and only send results in two occasions:
-    // 1. A proof was found, we send the step where it was found
-    // 2. It couldn't find a proof
-    for (BigInt k_step = 2; k_step <= max_k_step; k_step += k_step_inc)
-    {
-      bmct bmc(goto_functions, options, context);
-
-      bmc.options.set_option("unwind", integer2string(k_step));
-
-      log_status("Checking inductive step, k = {:d}", k_step);
-
-      // If an exception was thrown, we should abort the process
-      int res = smt_convt::P_ERROR;
+      // An error leaves this bound undecided
+      smt_convt::resultt res = smt_convt::P_ERROR;
       try
       {
-        res = do_bmc(bmc);
+        res = bmc.start_bmc();
       }
       catch (...)
       {
-        break;
       }
 
-      if (options.get_bool_option("disable-inductive-step"))
-        break;
-
-      // Send information to parent if no bug was found
-      if (res == smt_convt::P_UNSATISFIABLE)
-      {
-        r.k = k_step.to_uint64();
-
-        // Write result
-        auto const len = write(forward_pipe[1], &r, sizeof(r));
-        assert(len == sizeof(r) && "short write");
-        (void)len; //ndebug
-
-        log_status("Inductive process finished (safety proven).");
-        return false;
-      }
+      broker.report(w, res);
     }
+  };
 
-    // Send information to parent that it couldn't prove the code
-    r.k = 0;
+  std::vector<std::thread> threads;
+  for (auto &w : workers)
+    threads.emplace_back(run_worker, std::ref(*w));
 
-    auto const len = write(forward_pipe[1], &r, sizeof(r));
-    assert(len == sizeof(r) && "short write");
-    (void)len; //ndebug
+  // Workers in the middle of a solver call are interrupted, but the verdict
+  // doesn't need to wait for them
+  broker.wait();
+  broker.cancel_all();
 
-    log_status("Inductive process finished (safety not proven).");
-    return true;
-  }
+  int ret = 0;
+  switch (broker.verdict)
+  {
+  case k_induction_brokert::BUG:
+    log_result(
+      "\nBug found by the base case (k = {})\nVERIFICATION FAILED",
+      broker.verdict_k);
+    ret = 1;
+    break;
+
+  case k_induction_brokert::PROOF:
+    if (broker.verdict_step == FORWARD_CONDITION)
+      log_success(
+        "\nSolution found by the forward condition; "
+        "all states are reachable (k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        broker.verdict_k);
+    else
+      log_success(
+        "\nSolution found by the inductive step "
+        "(k = {:d})\n"
+        "VERIFICATION SUCCESSFUL",
+        broker.verdict_k);
+    break;
 
   default:
-    assert(0 && "Unknown process type.");
+    // Couldn't find a bug or a proof for the current depth
+    log_fail("\nVERIFICATION UNKNOWN");
   }
 
-#endif
+  for (auto &t : threads)
+    t.join();
 
-  return 0;
+  return ret;
 }
 
 // This method iteratively applies one of the verification strategies
@@ -1120,6 +957,14 @@ int esbmc_parseoptionst::do_bmc_strategy(
   // Get the increment
   unsigned k_step_inc = strtoul(cmdline.getval("k-step"), nullptr, 10);
 
+  // Keep one live solver per step, shared by all the bounds
+  if (options.get_bool_option("reuse-solver"))
+  {
+    base_case_solver = std::make_shared<reused_solvert>(context);
+    forward_condition_solver = std::make_shared<reused_solvert>(context);
+    inductive_step_solver = std::make_shared<reused_solvert>(context);
+  }
+
   // Trying all bounds from 1 to "max_k_step" in "k_step_inc"
   for (BigInt k_step = 1; k_step <= max_k_step; k_step += k_step_inc)
   {
@@ -1201,6 +1046,7 @@ tvt esbmc_parseoptionst::is_base_case_violated(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.reused_solver = base_case_solver;
 
   log_status("Checking base case, k = {:d}", k_step);
   switch (do_bmc(bmc))
@@ -1260,6 +1106,7 @@ tvt esbmc_parseoptionst::does_forward_condition_hold(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.reused_solver = forward_condition_solver;
 
   log_progress("Checking forward condition, k = {:d}", k_step);
   auto res = do_bmc(bmc);
@@ -1327,6 +1174,7 @@ tvt esbmc_parseoptionst::is_inductive_step_violated(
   options.set_option("unwind", integer2string(k_step));
 
   bmct bmc(goto_functions, options, context);
+  bmc.reused_solver = inductive_step_solver;
 
   log_progress("Checking inductive step, k = {:d}", k_step);
   switch (do_bmc(bmc))
@@ -1494,7 +1342,7 @@ bool esbmc_parseoptionst::create_goto_program(
     }
 
     // Ahem
-    migrate_namespace_lookup = new namespacet(context);
+    set_migrate_namespace(new namespacet(context));
 
     // If the user is providing the GOTO functions, we don't need to parse
     if (cmdline.isset("binary"))
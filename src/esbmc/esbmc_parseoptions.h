@@ -82,6 +82,11 @@ protected:
   std::vector<std::unique_ptr<goto_functions_algorithm>>
     goto_preprocess_algorithms;
 
+  /// solver states reused across k by --reuse-solver, one per step
+  std::shared_ptr<reused_solvert> base_case_solver;
+  std::shared_ptr<reused_solvert> forward_condition_solver;
+  std::shared_ptr<reused_solvert> inductive_step_solver;
+
 private:
   void close_file(FILE *f)
   {
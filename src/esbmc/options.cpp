@@ -87,6 +87,23 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "do not include abstract cpp operational models"},
     {"force,f", boost::program_options::value<std::vector<std::string>>(), ""},
+    {"frontend-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "parse and convert the input files on up to n threads, and link them "
+     "in order afterwards (0 uses one job per hardware thread, default is 1)"},
+    {"frontend-pch",
+     NULL,
+     "precompile the ESBMC intrinsics once per configuration instead of "
+     "parsing them for every translation unit"},
+    {"frontend-pch-dir",
+     boost::program_options::value<std::string>()->value_name("dir"),
+     "like --frontend-pch, and keep the precompiled headers in directory dir "
+     "for later runs"},
+    {"frontend-pch-include",
+     boost::program_options::value<std::vector<std::string>>()->value_name(
+       "header"),
+     "like --frontend-pch, and precompile header along with the intrinsics; "
+     "it is included in every translation unit, before anything else"},
     {"preprocess", NULL, "stop after preprocessing"},
     {"cache-asserts", NULL, "cache asserts that were already proven correct"},
     {"no-inlining", NULL, "disable inlining function calls"},
@@ -209,7 +226,12 @@ const struct group_opt_templ all_cmd_options[] = {
     {"falsification", NULL, "incremental loop unwinding for bug searching"},
     {"termination",
      NULL,
-     "incremental loop unwinding assertion verification"}}},
+     "incremental loop unwinding assertion verification"},
+    {"reuse-solver",
+     NULL,
+     "keep one solver alive across the bounds of k-induction and of the "
+     "incremental strategies. Symbolic execution is still redone for every "
+     "bound; only the steps that consecutive bounds share are encoded once"}}},
   {"Solver",
    {{"list-solvers", NULL, "list available solvers and exit"},
     {"boolector", NULL, "use Boolector (default),"},
@@ -225,6 +247,7 @@ const struct group_opt_templ all_cmd_options[] = {
     {"cvc", NULL, "use CVC4"},
     {"yices", NULL, "use Yices"},
     {"bitwuzla", NULL, "use Bitwuzla"},
+    {"minisat", NULL, "use MiniSat, on ESBMC's own bit-blaster"},
     {"bv", NULL, "use solver with bit-vector arithmetic"},
     {"ir", NULL, "use solver with integer/real arithmetic"},
     {"smtlib", NULL, "use SMT lib format"},
@@ -235,14 +258,19 @@ const struct group_opt_templ all_cmd_options[] = {
      " (Boolector)"
 #endif
     },
+    {"portfolio",
+     boost::program_options::value<std::string>()->value_name("s1,s2,..."),
+     "solve each formula with all the given solvers concurrently, taking the "
+     "first answer"},
     {"non-supported-models-as-zero",
      NULL,
      "if ESBMC can't extract a type/expression from the solver, then the value "
      "will be set to zero"},
     {"smtlib-solver-prog",
-
-     boost::program_options::value<std::string>(),
-     "SMT lib program name"},
+     boost::program_options::value<std::vector<std::string>>()->value_name(
+       "cmd"),
+     "SMT lib program name; when given several times, all of them solve each "
+     "formula and the first answer is taken"},
     {"output",
      boost::program_options::value<std::string>()->value_name("<filename>"),
      "output VCCs in SMT lib format to given file (or stdout if it is '-')"},
@@ -259,6 +287,14 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "encode tuples using our tuple to symbol API"},
     {"array-flattener", NULL, "encode arrays using our array API"},
+    {"linear-address-space",
+     NULL,
+     "lay out objects in allocation order, with a number of address space "
+     "constraints linear in the number of objects. Freed memory is only "
+     "reused once all objects allocated after it are freed too: with "
+     "out-of-order frees, a program can run out of address space or never "
+     "get a freed address back, and verdicts that depend on either can "
+     "differ from the default layout"},
     {"no-return-value-opt",
      NULL,
      "disable return value optimization to compute the stack size"}}},
@@ -281,6 +317,18 @@ const struct group_opt_templ all_cmd_options[] = {
    {{"multi-property",
      NULL,
      "verify satisfiability of all claims of the current bound"},
+    {"multi-property-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "in multi-property mode, check up to n claims in parallel "
+     "(0 uses one job per hardware thread, default is 1)"},
+    {"multi-property-incremental",
+     NULL,
+     "in multi-property mode, encode the program once and check each claim "
+     "incrementally on the same solver"},
+    {"verification-cache",
+     boost::program_options::value<std::string>()->value_name("dir"),
+     "in multi-property mode, remember the verdict of each sliced claim in "
+     "directory dir and skip claims already proven by earlier runs"},
     {"no-assertions", NULL, "ignore assertions"},
     {"no-bounds-check", NULL, "do not do array bounds check"},
     {"no-div-by-zero-check", NULL, "do not do division by zero check"},
@@ -348,7 +396,11 @@ const struct group_opt_templ all_cmd_options[] = {
      "conditions"},
     {"k-induction-parallel",
      NULL,
-     "prove by k-induction, running each step on a separate process"},
+     "prove by k-induction, running each step on separate threads"},
+    {"k-induction-workers",
+     boost::program_options::value<int>()->value_name("n"),
+     "in parallel k-induction, run n threads per step (0 splits the "
+     "hardware threads between the steps, default is 1)"},
     {"k-step",
      boost::program_options::value<int>()->default_value(1)->value_name("nr"),
      "set k increment (default is 1)"},
@@ -381,9 +433,21 @@ const struct group_opt_templ all_cmd_options[] = {
      "do not not merge gotos when restoring the last paths after a "
      "context-switch"},
     {"no-por", NULL, "do not do partial order reduction"},
+    {"dpor",
+     NULL,
+     "use dynamic partial order reduction with sleep sets instead of the "
+     "default partial order reduction"},
     {"all-runs",
      NULL,
-     "check all interleavings, even if a bug was already found"}}},
+     "check all interleavings, even if a bug was already found"},
+    {"interleaving-jobs",
+     boost::program_options::value<int>()->value_name("n"),
+     "explore and check interleavings with n parallel jobs "
+     "(0 uses one job per hardware thread, default is 1)"},
+    {"interleaving-split-depth",
+     boost::program_options::value<int>()->value_name("nr"),
+     "with --interleaving-jobs, hand out the subtrees of interleavings after "
+     "nr context switches to the jobs (default is 2)"}}},
   {"Interval Analysis",
    {{"interval-analysis",
      NULL,
@@ -449,6 +513,13 @@ const struct group_opt_templ all_cmd_options[] = {
     {"enable-core-dump", NULL, "do not disable core dump output"},
     {"no-simplify", NULL, "do not simplify any expression"},
     {"no-propagation", NULL, "disable constant propagation"},
+    {"hash-consing",
+     NULL,
+     "share structurally equal expressions and types in memory"},
+    {"simplify-cache-size",
+     boost::program_options::value<int>()->value_name("n"),
+     "remember at most n simplification results per thread, 0 disables "
+     "(default: 65536)"},
     {"add-symex-value-sets",
      NULL,
      "enable value-set analysis for pointers and add assumes to the "
@@ -1,18 +1,204 @@
 #include <goto-programs/read_bin_goto_object.h>
 #include <goto-programs/read_goto_binary.h>
-#include <fstream>
+#include <goto-programs/write_goto_binary.h>
+#include <goto-programs/goto_program_irep.h>
+#include <util/irep_serialization.h>
+#include <util/migrate.h>
+#include <util/symbol_serialization.h>
 #include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
 
+namespace
+{
+unsigned binary_version(const char *data, size_t size)
+{
+  if (size < 7 || data[0] != 'G' || data[1] != 'B' || data[2] != 'F')
+    return 0;
+  const unsigned char *p = reinterpret_cast<const unsigned char *>(data) + 3;
+  return (unsigned(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+/* Decodes a version 2 goto binary (see write_goto_binary) straight from
+ * memory. Pool nodes are only decoded once they are reached and are then
+ * shared, so a subtree that occurs many times in the program is built once.
+ * Children are stored before their parents, which also rules out cycles in a
+ * corrupt file. */
+class goto_binary_readert
+{
+public:
+  goto_binary_readert(const char *data, size_t size)
+    : data(reinterpret_cast<const unsigned char *>(data)), size(size)
+  {
+  }
+
+  bool read(contextt &context, goto_functionst &functions);
+
+private:
+  unsigned word(size_t offset)
+  {
+    if (offset + 4 > size)
+    {
+      corrupt = true;
+      return 0;
+    }
+    const unsigned char *p = data + offset;
+    return (unsigned(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+  }
+
+  const irep_idt &string(unsigned i)
+  {
+    if (i < strings.size())
+      return strings[i];
+    corrupt = true;
+    return get_nil_irep().id();
+  }
+
+  const irept &node(unsigned i, unsigned bound)
+  {
+    if (i >= bound)
+    {
+      corrupt = true;
+      return get_nil_irep();
+    }
+    if (loaded[i])
+      return nodes[i];
+
+    size_t at = word(pool_offset + 4 + 4 * size_t(i));
+    irept &irep = nodes[i];
+    irep.id(string(word(at)));
+    at += 4;
+
+    unsigned n = word(at);
+    at += 4;
+    for (unsigned j = 0; j < n && !corrupt; j++, at += 4)
+      irep.get_sub().push_back(node(word(at), i));
+
+    // Named subtrees, then comments
+    for (unsigned k = 0; k < 2 && !corrupt; k++)
+    {
+      n = word(at);
+      at += 4;
+      for (unsigned j = 0; j < n && !corrupt; j++, at += 8)
+        irep.add(string(word(at))) = node(word(at + 4), i);
+    }
+
+    loaded[i] = true;
+    return irep;
+  }
+
+  const unsigned char *data;
+  size_t size;
+  size_t pool_offset = 0;
+  bool corrupt = false;
+  std::vector<irep_idt> strings;
+  std::vector<irept> nodes;
+  std::vector<bool> loaded;
+};
+
+bool goto_binary_readert::read(contextt &context, goto_functionst &functions)
+{
+  size_t strings_offset = word(7);
+  pool_offset = word(11);
+  size_t symbols_offset = word(15);
+  size_t functions_offset = word(19);
+
+  unsigned count = word(strings_offset);
+  size_t at = strings_offset + 4;
+  for (unsigned i = 0; i < count && !corrupt; i++)
+  {
+    unsigned len = word(at);
+    at += 4;
+    if (at + len > size)
+      corrupt = true;
+    else
+      strings.emplace_back(
+        std::string(reinterpret_cast<const char *>(data + at), len));
+    at += len;
+  }
+
+  count = word(pool_offset);
+  if (count > size / 4)
+    corrupt = true;
+  if (corrupt)
+  {
+    log_error("Corrupt goto binary");
+    return true;
+  }
+  nodes.resize(count);
+  loaded.resize(count, false);
+
+  count = word(symbols_offset);
+  for (unsigned i = 0; i < count && !corrupt; i++)
+  {
+    at = symbols_offset + 4 + 4 * size_t(i);
+    const irept &t = node(word(at), nodes.size());
+    if (corrupt)
+      break;
+
+    symbolt symbol;
+    symbol.from_irep(t);
+
+    if (!symbol.is_type && symbol.type.is_code())
+    {
+      // makes sure there is an empty function
+      // for every function symbol and fixes
+      // the function types.
+      functions.function_map[symbol.id].type = to_code_type(symbol.type);
+    }
+    context.add(symbol);
+  }
+
+  assert(migrate_namespace_lookup);
+
+  count = word(functions_offset);
+  for (unsigned i = 0; i < count && !corrupt; i++)
+  {
+    at = functions_offset + 4 + 8 * size_t(i);
+    irep_idt fname = string(word(at));
+    const irept &t = node(word(at + 4), nodes.size());
+    if (corrupt)
+      break;
+
+    goto_functiont &f = functions.function_map[fname];
+    convert(t, f.body);
+    f.body_available = f.body.instructions.size() > 0;
+  }
+
+  if (corrupt)
+  {
+    log_error("Corrupt goto binary");
+    return true;
+  }
+
+  return false;
+}
+
+bool read_goto_binary_memory(
+  const char *data,
+  size_t size,
+  const std::string &filename,
+  contextt &context,
+  goto_functionst &dest)
+{
+  if (binary_version(data, size) == GOTO_BINARY_VERSION)
+    return goto_binary_readert(data, size).read(context, dest);
+
+  // Older binaries, and the diagnostics for things that aren't goto binaries
+  using namespace boost::iostreams;
+  stream<array_source> src(data, size);
+  return read_bin_goto_object(src, filename, context, dest);
+}
+} // namespace
+
 bool read_goto_binary_array(
   const void *data,
   size_t size,
   contextt &context,
   goto_functionst &dest)
 {
-  using namespace boost::iostreams;
-  stream<array_source> src(static_cast<const char *>(data), size);
-  return read_bin_goto_object(src, "", context, dest);
+  return read_goto_binary_memory(
+    static_cast<const char *>(data), size, "", context, dest);
 }
 
 bool read_goto_binary(
@@ -20,6 +206,97 @@ bool read_goto_binary(
   contextt &context,
   goto_functionst &dest)
 {
-  std::ifstream in(path, std::ios::in | std::ios::binary);
-  return read_bin_goto_object(in, path, context, dest);
+  boost::iostreams::mapped_file_source file;
+  try
+  {
+    file.open(path);
+  }
+  catch (const std::exception &e)
+  {
+    log_error("Failed to open `{}': {}", path, e.what());
+    return true;
+  }
+
+  return read_goto_binary_memory(file.data(), file.size(), path, context, dest);
+}
+
+bool read_goto_library(
+  const void *data,
+  size_t size,
+  const std::function<bool(const irep_idt &)> &wanted,
+  contextt &context)
+{
+  using namespace boost::iostreams;
+  stream<array_source> in(static_cast<const char *>(data), size);
+
+  char hdr[3];
+  in.read(hdr, 3);
+  if (!in || hdr[0] != 'G' || hdr[1] != 'B' || hdr[2] != 'L')
+  {
+    log_error("Not an indexed goto library");
+    return true;
+  }
+
+  if (irep_serializationt::read_long(in) != GOTO_LIBRARY_VERSION)
+  {
+    log_error("The goto library was built by a different version of c2goto");
+    return true;
+  }
+
+  // Table of contents
+  irep_serializationt::ireps_containert toc_ic;
+  irep_serializationt toc(toc_ic);
+
+  unsigned count = irep_serializationt::read_long(in);
+  std::vector<std::pair<irep_idt, unsigned>> entries;
+  std::vector<bool> load(count, false);
+  for (unsigned i = 0; i < count; i++)
+  {
+    irep_idt name = toc.read_string(in);
+    unsigned offset = irep_serializationt::read_long(in);
+    entries.emplace_back(name, offset);
+
+    bool needed = wanted(name);
+    load[i] = load[i] || needed;
+
+    unsigned n_deps = irep_serializationt::read_long(in);
+    for (unsigned j = 0; j < n_deps; j++)
+    {
+      unsigned dep = irep_serializationt::read_long(in);
+      if (dep >= count)
+      {
+        log_error("Corrupt goto library index");
+        return true;
+      }
+      if (needed)
+        load[dep] = true;
+    }
+  }
+
+  if (!in)
+  {
+    log_error("Truncated goto library index");
+    return true;
+  }
+
+  // Records, each decoded on its own
+  const std::streamoff records = in.tellg();
+  for (unsigned i = 0; i < count; i++)
+  {
+    if (!load[i])
+      continue;
+
+    in.seekg(records + entries[i].second);
+
+    irep_serializationt::ireps_containert ic;
+    symbol_serializationt symbolconverter(ic);
+    irept t;
+    symbolconverter.convert(in, t);
+
+    symbolt symbol;
+    symbol.from_irep(t);
+    context.add(symbol);
+  }
+
+  return false;
 }
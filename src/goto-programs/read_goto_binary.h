@@ -1,6 +1,7 @@
 #ifndef CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
+#include <functional>
 #include <goto-programs/goto_functions.h>
 #include <util/context.h>
 #include <util/message.h>
@@ -17,4 +18,13 @@ bool read_goto_binary(
   contextt &context,
   goto_functionst &dest);
 
+/* Adds to `context` the symbols of an indexed library (see
+ * write_goto_library) for which `wanted` holds, together with everything they
+ * depend on. No other symbol is decoded. */
+bool read_goto_library(
+  const void *data,
+  size_t size,
+  const std::function<bool(const irep_idt &)> &wanted,
+  contextt &context);
+
 #endif
@@ -1,49 +1,278 @@
 #include <fstream>
-#include <goto-programs/goto_function_serialization.h>
+#include <sstream>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+#include <goto-programs/goto_program_irep.h>
 #include <goto-programs/write_goto_binary.h>
 #include <util/irep_serialization.h>
 #include <util/message.h>
 #include <util/symbol_serialization.h>
 
+namespace
+{
+/* Builds the flat irep pool of a version 2 goto binary. Every node becomes
+ * one record of words: its id, its children and its named and comment
+ * subtrees, the latter two as (name, node) pairs. Strings and nodes are
+ * referred to by index, children always come before their parents, and equal
+ * records are only stored once. */
+class goto_binary_poolt
+{
+public:
+  unsigned string(const std::string &s)
+  {
+    auto [it, inserted] = string_index.emplace(s, strings.size());
+    if (inserted)
+      strings.push_back(s);
+    return it->second;
+  }
+
+  unsigned node(const irept &irep)
+  {
+    std::vector<unsigned> record;
+    record.push_back(string(irep.id_string()));
+
+    // Children first, so that the parent record can refer to them
+    record.push_back(irep.get_sub().size());
+    forall_irep (it, irep.get_sub())
+      record.push_back(node(*it));
+
+    for (const irept::named_subt *sub :
+         {&irep.get_named_sub(), &irep.get_comments()})
+    {
+      record.push_back(sub->size());
+      forall_named_irep (it, *sub)
+      {
+        record.push_back(string(name2string(it->first)));
+        record.push_back(node(it->second));
+      }
+    }
+
+    auto [it, inserted] = record_index.emplace(record, records.size());
+    if (inserted)
+      records.push_back(std::move(record));
+    return it->second;
+  }
+
+  std::vector<std::string> strings;
+  std::vector<std::vector<unsigned>> records;
+
+private:
+  std::unordered_map<std::string, unsigned> string_index;
+  std::unordered_map<
+    std::vector<unsigned>,
+    unsigned,
+    boost::hash<std::vector<unsigned>>>
+    record_index;
+};
+} // namespace
+
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions)
 {
+  goto_binary_poolt pool;
+
+  std::vector<unsigned> symbols;
+  lcontext.foreach_operand([&pool, &symbols](const symbolt &s) {
+    irept t;
+    s.to_irep(t);
+    symbols.push_back(pool.node(t));
+  });
+
+  std::vector<std::pair<unsigned, unsigned>> bodies;
+  for (auto &it : functions.function_map)
+  {
+    if (it.second.body_available)
+    {
+      it.second.body.compute_location_numbers();
+      irept t;
+      convert(it.second.body, t);
+      bodies.emplace_back(pool.string(it.first.as_string()), pool.node(t));
+    }
+  }
+
+  // Section offsets are absolute, the header being "GBF", the version and
+  // the four offsets
+  unsigned strings_offset = 3 + 5 * 4;
+  unsigned pool_offset = strings_offset + 4;
+  for (const std::string &s : pool.strings)
+    pool_offset += 4 + s.size();
+
+  unsigned symbols_offset = pool_offset + 4 + 4 * pool.records.size();
+  std::vector<unsigned> record_offsets;
+  for (const std::vector<unsigned> &r : pool.records)
+  {
+    record_offsets.push_back(symbols_offset);
+    symbols_offset += 4 * r.size();
+  }
+
+  unsigned functions_offset = symbols_offset + 4 + 4 * symbols.size();
+
   // header
   out << "GBF";
   write_long(out, GOTO_BINARY_VERSION);
+  write_long(out, strings_offset);
+  write_long(out, pool_offset);
+  write_long(out, symbols_offset);
+  write_long(out, functions_offset);
+
+  write_long(out, pool.strings.size());
+  for (const std::string &s : pool.strings)
+  {
+    write_long(out, s.size());
+    out.write(s.data(), s.size());
+  }
+
+  write_long(out, pool.records.size());
+  for (unsigned offset : record_offsets)
+    write_long(out, offset);
+  for (const std::vector<unsigned> &r : pool.records)
+    for (unsigned w : r)
+      write_long(out, w);
 
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-  symbol_serializationt symbolconverter(irepc);
-  goto_function_serializationt gfconverter(irepc);
+  write_long(out, symbols.size());
+  for (unsigned s : symbols)
+    write_long(out, s);
 
-  write_long(out, lcontext.size());
+  write_long(out, bodies.size());
+  for (const auto &[name, body] : bodies)
+  {
+    write_long(out, name);
+    write_long(out, body);
+  }
 
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
+  return !out.good();
+}
+
+static void generate_symbol_deps(
+  irep_idt name,
+  irept irep,
+  std::multimap<irep_idt, irep_idt> &deps)
+{
+  std::pair<irep_idt, irep_idt> type;
+
+  if (irep.id() == "symbol")
+  {
+    type = std::pair<irep_idt, irep_idt>(name, irep.identifier());
+    deps.insert(type);
+    return;
+  }
+
+  forall_irep (irep_it, irep.get_sub())
+  {
+    if (irep_it->id() == "symbol")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->identifier());
+      deps.insert(type);
+      generate_symbol_deps(name, *irep_it, deps);
+    }
+    else if (irep_it->id() == "argument")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->cmt_identifier());
+      deps.insert(type);
+    }
+    else
+    {
+      generate_symbol_deps(name, *irep_it, deps);
+    }
+  }
+
+  forall_named_irep (irep_it, irep.get_named_sub())
+  {
+    if (irep_it->second.id() == "symbol")
+    {
+      type = std::pair<irep_idt, irep_idt>(name, irep_it->second.identifier());
+      deps.insert(type);
+    }
+    else if (irep_it->second.id() == "argument")
+    {
+      type =
+        std::pair<irep_idt, irep_idt>(name, irep_it->second.cmt_identifier());
+      deps.insert(type);
+    }
+    else
+    {
+      generate_symbol_deps(name, irep_it->second, deps);
+    }
+  }
+}
+
+bool write_goto_library(
+  std::ostream &out,
+  const contextt &lcontext,
+  const std::multimap<irep_idt, irep_idt> &extra_deps)
+{
+  std::vector<const symbolt *> symbols;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> index;
+  lcontext.foreach_operand_in_order([&symbols, &index](const symbolt &s) {
+    index.emplace(s.id, symbols.size());
+    symbols.push_back(&s);
   });
 
-  unsigned cnt = 0;
-  forall_goto_functions (it, functions)
-    if (it->second.body_available)
-      cnt++;
+  // Direct dependencies between the symbols of the library, by index
+  std::multimap<irep_idt, irep_idt> symbol_deps = extra_deps;
+  for (const symbolt *s : symbols)
+  {
+    generate_symbol_deps(s->id, s->value, symbol_deps);
+    generate_symbol_deps(s->id, s->type, symbol_deps);
+  }
 
-  write_long(out, cnt);
+  std::vector<std::vector<unsigned>> deps(symbols.size());
+  for (const auto &[from, to] : symbol_deps)
+  {
+    auto f = index.find(from), t = index.find(to);
+    if (f != index.end() && t != index.end())
+      deps[f->second].push_back(t->second);
+  }
 
-  for (auto &it : functions.function_map)
+  // Every record has its own irep and string tables, so that it can be
+  // decoded on its own
+  std::ostringstream records;
+  std::vector<unsigned> offsets;
+  for (const symbolt *s : symbols)
   {
-    if (it.second.body_available)
+    offsets.push_back(records.tellp());
+    irep_serializationt::ireps_containert irepc;
+    symbol_serializationt symbolconverter(irepc);
+    symbolconverter.convert(*s, records);
+  }
+
+  // header
+  out << "GBL";
+  write_long(out, GOTO_LIBRARY_VERSION);
+  write_long(out, symbols.size());
+
+  // table of contents
+  std::vector<bool> seen;
+  std::vector<unsigned> closure, stack;
+  for (unsigned i = 0; i < symbols.size(); i++)
+  {
+    seen.assign(symbols.size(), false);
+    seen[i] = true;
+    closure.clear();
+    stack.assign(1, i);
+    while (!stack.empty())
     {
-      it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      unsigned s = stack.back();
+      stack.pop_back();
+      for (unsigned d : deps[s])
+        if (!seen[d])
+        {
+          seen[d] = true;
+          closure.push_back(d);
+          stack.push_back(d);
+        }
     }
+
+    write_string(out, symbols[i]->id.as_string());
+    write_long(out, offsets[i]);
+    write_long(out, closure.size());
+    for (unsigned d : closure)
+      write_long(out, d);
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  out << records.str();
 
   return false;
 }
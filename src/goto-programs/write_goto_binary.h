@@ -1,15 +1,32 @@
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+#define GOTO_BINARY_VERSION 2
+#define GOTO_LIBRARY_VERSION 1
 
 #include <goto-programs/goto_functions.h>
+#include <map>
 #include <ostream>
 #include <util/context.h>
 
+/* Writes a version 2 goto binary: after the header comes an index of the
+ * string table, the irep pool, the symbol table and the function table. All
+ * ireps live once in a flat pool that is addressed by index, so readers can
+ * map the file and decode only the nodes they reach, see read_goto_binary. */
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions);
 
+/* Writes the symbols of `lcontext` as an indexed library: a table of contents
+ * giving, for each symbol, the offset of its record and the transitive
+ * closure of the symbols it depends on, followed by one self-contained record
+ * per symbol. Readers can then decode only what they need, see
+ * read_goto_library. `extra_deps` adds dependencies that aren't visible in
+ * the symbols themselves. */
+bool write_goto_library(
+  std::ostream &out,
+  const contextt &lcontext,
+  const std::multimap<irep_idt, irep_idt> &extra_deps);
+
 #endif
@@ -75,7 +75,8 @@ void build_goto_trace(
     goto_trace_step.step_nr = ++step_nr;
     goto_trace_step.format_string = SSA_step.format_string;
 
-    goto_trace_step.stack_trace = SSA_step.stack_trace;
+    if (SSA_step.stack_trace)
+      goto_trace_step.stack_trace = *SSA_step.stack_trace;
 
     if (SSA_step.is_assignment())
     {
@@ -144,7 +145,8 @@ void build_successful_goto_trace(
       goto_trace_step.type = it->type;
       goto_trace_step.step_nr = step_nr++;
       goto_trace_step.format_string = it->format_string;
-      goto_trace_step.stack_trace = it->stack_trace;
+      if (it->stack_trace)
+        goto_trace_step.stack_trace = *it->stack_trace;
     }
   }
 }
@@ -3,6 +3,7 @@
 #include <langapi/language_ui.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <util/c_types.h>
@@ -16,8 +17,8 @@
 #include <util/string2array.h>
 #include <vector>
 
-unsigned int execution_statet::node_count = 0;
-unsigned int execution_statet::dynamic_counter = 0;
+thread_local unsigned int execution_statet::node_count = 0;
+thread_local unsigned int execution_statet::dynamic_counter = 0;
 
 execution_statet::execution_statet(
   const goto_functionst &goto_functions,
@@ -44,6 +45,7 @@ execution_statet::execution_statet(
   symex_trace = options.get_bool_option("symex-trace");
   smt_during_symex = options.get_bool_option("smt-during-symex");
   smt_thread_guard = options.get_bool_option("smt-thread-guard");
+  dpor = options.get_bool_option("dpor");
 
   goto_functionst::function_mapt::const_iterator it =
     goto_functions.function_map.find("__ESBMC_main");
@@ -85,6 +87,7 @@ execution_statet::execution_statet(
   // Initial mpor tracking.
   thread_last_reads.emplace_back();
   thread_last_writes.emplace_back();
+  thread_footprints.emplace_back();
   // One thread with one dependancy relation.
   dependancy_chain.emplace_back();
   dependancy_chain.back().push_back(0);
@@ -134,6 +137,9 @@ execution_statet &execution_statet::operator=(const execution_statet &ex)
   preserved_paths = ex.preserved_paths;
   atomic_numbers = ex.atomic_numbers;
   DFS_traversed = ex.DFS_traversed;
+  dpor_backtrack = ex.dpor_backtrack;
+  dpor_sleep = ex.dpor_sleep;
+  dpor_explored = ex.dpor_explored;
   thread_start_data = ex.thread_start_data;
   last_active_thread = ex.last_active_thread;
   last_insn = ex.last_insn;
@@ -154,6 +160,7 @@ execution_statet &execution_statet::operator=(const execution_statet &ex)
   symex_trace = ex.symex_trace;
   smt_during_symex = ex.smt_during_symex;
   smt_thread_guard = ex.smt_thread_guard;
+  dpor = ex.dpor;
   stack_limit = ex.stack_limit;
   no_return_value_opt = ex.no_return_value_opt;
 
@@ -161,6 +168,7 @@ execution_statet &execution_statet::operator=(const execution_statet &ex)
 
   thread_last_reads = ex.thread_last_reads;
   thread_last_writes = ex.thread_last_writes;
+  thread_footprints = ex.thread_footprints;
   dependancy_chain = ex.dependancy_chain;
   mpor_says_no = ex.mpor_says_no;
   cswitch_forced = ex.cswitch_forced;
@@ -453,6 +461,7 @@ void execution_statet::update_after_switch_point()
   // starting a new transition, so for the current thread, clear records.
   thread_last_reads[active_thread].clear();
   thread_last_writes[active_thread].clear();
+  thread_footprints[active_thread] = footprintt();
 
   cswitch_forced = false;
 
@@ -747,6 +756,7 @@ unsigned int execution_statet::add_thread(const goto_programt *prog)
   // Update MPOR tracking data with newly initialized thread
   thread_last_reads.emplace_back();
   thread_last_writes.emplace_back();
+  thread_footprints.emplace_back();
   // Unfortunately as each thread has a depenancy relation with every other
   // thread we have to do a lot of work to initialize a new one. And initially
   // all relations are '0', no transitions yet.
@@ -803,6 +813,85 @@ void execution_statet::analyze_read(const expr2tc &code)
   }
 }
 
+/**
+ *  Calls f on each object expr accesses. Objects only named to take their
+ *  address aren't accessed.
+ */
+static void foreach_accessed_object(
+  const expr2tc &expr,
+  const std::function<void(const symbol2t &)> &f)
+{
+  if (is_nil_expr(expr) || is_address_of2t(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    f(to_symbol2t(expr));
+    return;
+  }
+
+  expr->foreach_operand(
+    [&f](const expr2tc &e) { foreach_accessed_object(e, f); });
+}
+
+/**
+ *  Key of the storage behind sym: level2 numbers tell apart the values an
+ *  object takes, not where it lives.
+ */
+static symbol_keyt storage_key(const symbol2t &sym)
+{
+  symbol_keyt key = sym.get_symbol_key();
+  key.l2 = 0;
+  if (key.level == 2)
+    key.level = 1;
+  else if (key.level == 3)
+    key.level = 0;
+  return key;
+}
+
+void execution_statet::analyze_dereference(
+  const expr2tc &expr,
+  const expr2tc &deref,
+  dereferencet::modet mode)
+{
+  if (!dpor || threads_state.size() < thread_cswitch_threshold)
+    return;
+
+  // Locals named by the access belong to this thread. Anything else it
+  // names, or reaches through a pointer, may be shared: that includes mutexes
+  // and the state of the pthread library, which MPOR leaves out.
+  std::unordered_set<symbol_keyt, symbol_key_hash> locals;
+  foreach_accessed_object(expr, [this, &locals](const symbol2t &sym) {
+    if (sym.rlevel != symbol2t::level0)
+    {
+      locals.insert(storage_key(sym));
+      return;
+    }
+
+    const symbolt *symbol = ns.lookup(sym.thename);
+    if (
+      !symbol || (!symbol->static_lifetime && !symbol->type.is_dynamic_set()))
+      locals.insert(storage_key(sym));
+  });
+
+  // Whatever a write or free mentions counts as written, even the pointers
+  // and indexes it only reads; that makes more transitions dependent, which
+  // is safe.
+  const bool reads = !is_write(mode) && !is_free(mode);
+  const bool writes = !is_read(mode);
+  footprintt &footprint = thread_footprints[active_thread];
+  foreach_accessed_object(
+    deref, [&locals, &footprint, reads, writes](const symbol2t &sym) {
+      symbol_keyt key = storage_key(sym);
+      if (locals.count(key))
+        return;
+      if (reads)
+        footprint.reads.insert(key);
+      if (writes)
+        footprint.writes.insert(key);
+    });
+}
+
 void execution_statet::get_expr_globals(
   const namespacet &ns,
   const expr2tc &expr,
@@ -938,6 +1027,26 @@ bool execution_statet::check_mpor_dependancy(unsigned int j, unsigned int l)
   return false;
 }
 
+bool execution_statet::footprintt::depends_on(const footprintt &other) const
+{
+  typedef std::unordered_set<symbol_keyt, symbol_key_hash> objectst;
+  auto intersects = [](const objectst &a, const objectst &b) {
+    for (const symbol_keyt &key : a)
+      if (b.count(key))
+        return true;
+    return false;
+  };
+
+  // Same rules as check_mpor_dependancy; reads alone always commute
+  return intersects(writes, other.writes) || intersects(reads, other.writes) ||
+         intersects(writes, other.reads);
+}
+
+execution_statet::footprintt execution_statet::get_transition_footprint() const
+{
+  return thread_footprints[active_thread];
+}
+
 void execution_statet::calculate_mpor_constraints()
 {
   // Primary bit of MPOR logic - to be executed at the end of a transition to
@@ -1054,6 +1163,11 @@ bool execution_statet::has_cswitch_point_occured() const
     thread_last_writes[active_thread].size() != 0)
     return true;
 
+  // DPOR also sees the shared objects reached through pointers
+  const footprintt &footprint = thread_footprints[active_thread];
+  if (dpor && (!footprint.reads.empty() || !footprint.writes.empty()))
+    return true;
+
   return false;
 }
 
@@ -1068,38 +1182,19 @@ bool execution_statet::can_execution_continue() const
   return true;
 }
 
-crypto_hash execution_statet::generate_hash() const
+state_fingerprintt execution_statet::generate_hash() const
 {
   auto l2 = std::dynamic_pointer_cast<state_hashing_level2t>(state_level2);
   assert(l2 != nullptr);
 
-  crypto_hash state = l2->generate_l2_state_hash();
-  std::string str = state.to_string();
-
-  for (const auto &it : threads_state)
-  {
-    goto_programt::const_targett pc = it.source.pc;
-    int id = pc->location_number;
-    std::stringstream s;
-    s << id;
-    str += "!" + s.str();
-  }
-
-  crypto_hash h;
-  h.ingest(str.c_str(), str.size());
-  h.fin();
+  state_fingerprintt h = l2->l2_fingerprint;
+  for (unsigned int tid = 0; tid < threads_state.size(); tid++)
+    h += state_fingerprintt::of(
+      tid, threads_state[tid].source.pc->location_number);
 
   return h;
 }
 
-crypto_hash execution_statet::update_hash_for_assignment(const expr2tc &rhs)
-{
-  crypto_hash h;
-  rhs->hash(h);
-  h.fin();
-  return h;
-}
-
 void execution_statet::print_stack_traces(unsigned int indent) const
 {
   std::vector<goto_symex_statet>::const_iterator it;
@@ -1294,38 +1389,19 @@ void execution_statet::state_hashing_level2t::make_assignment(
   const expr2tc &const_value,
   const expr2tc &assigned_value)
 {
-  //  crypto_hash hash;
+  name_record rec(to_symbol2t(lhs_sym));
 
   renaming::level2t::make_assignment(lhs_sym, const_value, assigned_value);
 
   // If there's no body to the assignment, don't hash.
   if (!is_nil_expr(assigned_value))
   {
-    // XXX - consider whether to use l1 names instead. Recursion, reentrancy.
-    crypto_hash hash = owner->update_hash_for_assignment(assigned_value);
-    std::string orig_name = to_symbol2t(lhs_sym).thename.as_string();
-    current_hashes[orig_name] = hash;
+    // Swap the fingerprint of the variable's previous value, if any, for the
+    // new one. The cached crc of the value is all that's hashed, so this
+    // doesn't walk the expression once it's been hashed before.
+    state_fingerprintt &hash = current_hashes[rec];
+    l2_fingerprint -= hash;
+    hash = state_fingerprintt::of(rec.hash, assigned_value->crc());
+    l2_fingerprint += hash;
   }
 }
-
-crypto_hash
-execution_statet::state_hashing_level2t::generate_l2_state_hash() const
-{
-  unsigned int total;
-  size_t hash_sz = sizeof(crypto_hash::hash);
-
-  uint8_t *data =
-    (uint8_t *)alloca(current_hashes.size() * hash_sz * sizeof(uint8_t));
-
-  total = 0;
-  for (const auto &current_hashe : current_hashes)
-  {
-    memcpy(&data[total * hash_sz], current_hashe.second.hash, hash_sz);
-    total++;
-  }
-
-  crypto_hash c;
-  c.ingest(data, total * hash_sz);
-  c.fin();
-  return c;
-}
@@ -11,8 +11,11 @@
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_set>
 #include <irep2/irep2.h>
 #include <util/message.h>
+#include <util/persistent_map.h>
+#include <util/state_fingerprint.h>
 #include <util/std_expr.h>
 
 class reachability_treet;
@@ -46,6 +49,23 @@ class execution_statet : public goto_symext
 {
 public:
   class ex_state_level2t; // Forward dec
+
+  /**
+   *  Shared objects accessed by a transition of a thread, i.e. what it ran
+   *  between two context switch points. Keyed by the level1 storage of each
+   *  object, as found after dereferencing, so accesses through pointers count.
+   */
+  struct footprintt
+  {
+    std::unordered_set<symbol_keyt, symbol_key_hash> reads;
+    std::unordered_set<symbol_keyt, symbol_key_hash> writes;
+
+    /**
+     *  Whether the two transitions may not commute: one writes something
+     *  the other reads or writes.
+     */
+    bool depends_on(const footprintt &other) const;
+  };
   // Convenience typedef
   typedef goto_symex_statet::goto_statet goto_statet;
 
@@ -109,7 +129,9 @@ public:
   /**
    *  State-hashing level2t.
    *  When using this level2t, any assignment made is caught, and the symbolic
-   *  names are hashed. This is the primary handler for state hashing.
+   *  names are hashed. This is the primary handler for state hashing: the
+   *  fingerprint of every variable's current value is kept, and so is their
+   *  sum, which is updated in O(1) on each assignment.
    */
   class state_hashing_level2t : public ex_state_level2t
   {
@@ -121,9 +143,13 @@ public:
       expr2tc &lhs_symbol,
       const expr2tc &const_value,
       const expr2tc &assigned_value) override;
-    crypto_hash generate_l2_state_hash() const;
-    typedef std::map<irep_idt, crypto_hash> current_state_hashest;
+    /** Per variable, fingerprint of its name and last assigned value.
+     *  Shared between copies, like current_names. */
+    typedef persistent_mapt<name_record, state_fingerprintt, name_rec_hash>
+      current_state_hashest;
     current_state_hashest current_hashes;
+    /** Sum of current_hashes */
+    state_fingerprintt l2_fingerprint;
   };
 
   // Macros
@@ -382,6 +408,20 @@ public:
    */
   void analyze_read(const expr2tc &expr);
 
+  /**
+   *  Record the objects an access touches in the DPOR footprint.
+   *  Unlike analyze_read and analyze_assign, this sees the access after
+   *  dereferencing, so objects reached through pointers, such as the mutex
+   *  behind a pthread_mutex_t *, are recorded too.
+   *  @param expr Accessed expression, renamed to level1.
+   *  @param deref The same expression with its dereferences eliminated.
+   *  @param mode Whether the access reads or writes.
+   */
+  void analyze_dereference(
+    const expr2tc &expr,
+    const expr2tc &deref,
+    dereferencet::modet mode) override;
+
   /**
    *  Get list of globals accessed by expr.
    *  @param ns Namespace to work under.
@@ -403,6 +443,12 @@ public:
    */
   bool check_mpor_dependancy(unsigned int j, unsigned int l) const;
 
+  /**
+   *  Footprint of the transition the active thread is running, complete
+   *  once a context switch point has occurred.
+   */
+  footprintt get_transition_footprint() const;
+
   /**
    *  Calculate MPOR schedulable threads. I.E. what threads we can schedule
    *  right now without violating the "quasi-monotonic" property.
@@ -440,20 +486,13 @@ public:
 
   /**
    *  Generate hash of entire execution state.
-   *  This takes all current symbolic assignments to variables contained in the
-   *  l2 renaming object, and their precomputed hashes, concatonates them with
-   *  the current program counter of each thread, and hashes that. This results
-   *  in a full hash of the current execution state.
+   *  This takes the fingerprint of all current symbolic assignments to
+   *  variables contained in the l2 renaming object, and adds in the current
+   *  program counter of each thread. This results in a full hash of the
+   *  current execution state, in O(number of threads).
    *  @return Hash of entire current execution state.
    */
-  crypto_hash generate_hash() const;
-
-  /**
-   *  Generate hash of an expression.
-   *  @param rhs Expression to hash.
-   *  @return Hash of passed in expression.
-   */
-  crypto_hash update_hash_for_assignment(const expr2tc &rhs);
+  state_fingerprintt generate_hash() const;
 
   /**
    *  Print stack trace of each thread to stdout.
@@ -504,6 +543,16 @@ public:
    *  Every time a context switch is taken, the bool in this vector is set to
    *  true at the corresponding thread IDs index. */
   std::vector<bool> DFS_traversed;
+  /** DPOR persistent set: the threads that must be explored from this state.
+   *  Starts with the first thread explored, then grows whenever a later
+   *  transition races with the one taken from here. */
+  std::set<unsigned int> dpor_backtrack;
+  /** DPOR sleep set: threads whose next transition, recorded here, only
+   *  leads to interleavings equivalent to ones already explored. */
+  std::map<unsigned int, footprintt> dpor_sleep;
+  /** Footprint of the transition taken from this state by each thread
+   *  explored so far. Put to sleep in the states explored after them. */
+  std::map<unsigned int, footprintt> dpor_explored;
   /** Storage for threading libraries thread start data. See version history
    *  of when this was introduced to fully understand why; essentially this
    *  is a workaround to prevent too much nondeterminism entering into the
@@ -525,7 +574,7 @@ public:
   /** Number of nondeterministic symbols in this state. */
   unsigned nondet_count;
   /** Number of dynamic objects in this state. */
-  static unsigned dynamic_counter;
+  static thread_local unsigned dynamic_counter;
   /** Identifying number for this execution state. Used to distinguish runs
    *  in --schedule mode. */
   unsigned int node_id;
@@ -568,6 +617,10 @@ protected:
    *  last transition (run). Renamed to level1, as that identifies each piece of
    *  data that could have storage in C. */
   std::vector<std::set<expr2tc>> thread_last_writes;
+  /** For each thread, the objects its last transition accessed, for DPOR.
+   *  Unlike the two above, includes objects reached through pointers and
+   *  the state of the pthread library. */
+  std::vector<footprintt> thread_footprints;
   /** Dependancy chain for POR calculations. In mpor paper, DCij elements map
    *  to dependancy_chain[i][j] here. */
   std::vector<std::vector<int>> dependancy_chain;
@@ -586,11 +639,13 @@ protected:
   /** Are we evaluating the thread guard in the SMT solver during context
    *  switching? */
   bool smt_thread_guard;
+  /** Are we recording footprints for dynamic partial-order reduction? */
+  bool dpor;
 
   // Static stuff:
 
 public:
-  static unsigned int node_count;
+  static thread_local unsigned int node_count;
 
   friend void build_goto_symex_classes();
 };
@@ -162,6 +162,18 @@ protected:
    */
   void dereference(expr2tc &expr, dereferencet::modet mode);
 
+  /**
+   *  Observe an access once its dereferences are eliminated. Does nothing
+   *  here; the multi-threaded execution state tracks what threads touch.
+   *  @param expr Accessed expression, renamed to level1.
+   *  @param deref The same expression after dereferencing.
+   *  @param mode The dereference mode.
+   */
+  virtual void analyze_dereference(
+    const expr2tc &expr,
+    const expr2tc &deref,
+    dereferencet::modet mode);
+
   // symex
 
   /**
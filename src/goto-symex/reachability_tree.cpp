@@ -10,11 +10,12 @@
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/reachability_tree.h>
 #include <util/config.h>
-#include <util/crypto_hash.h>
 #include <util/expr_util.h>
 #include <util/i2string.h>
 #include <util/message.h>
 #include <util/std_expr.h>
+#include <algorithm>
+#include <iterator>
 
 reachability_treet::reachability_treet(
   goto_functionst &goto_functions,
@@ -40,7 +41,8 @@ reachability_treet::reachability_treet(
   directed_interleavings = options.get_bool_option("direct-interleavings");
   interactive_ileaves = options.get_bool_option("interactive-ileaves");
   schedule = options.get_bool_option("schedule");
-  por = !options.get_bool_option("no-por");
+  dpor = options.get_bool_option("dpor");
+  por = !options.get_bool_option("no-por") && !dpor;
   main_thread_ended = false;
   target_template = std::move(target);
 }
@@ -79,6 +81,10 @@ void reachability_treet::setup_for_new_explore()
   execution_states.emplace_back(s);
   cur_state_it = execution_states.begin();
   targ->push_ctx(); // Start with a depth of 1.
+  restore_path.clear();
+  pruned_branches = 0;
+  pruned_by_sleep_sets = 0;
+  pruned_by_mpor = 0;
 }
 
 execution_statet &reachability_treet::get_cur_state()
@@ -103,14 +109,7 @@ int reachability_treet::get_CS_bound() const
 
 bool reachability_treet::check_for_hash_collision() const
 {
-  const execution_statet &ex_state = get_cur_state();
-
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
-  if (hit_hashes.find(hash) != hit_hashes.end())
-    return true;
-
-  return false;
+  return hit_hashes.contains(get_cur_state().generate_hash());
 }
 
 void reachability_treet::post_hash_collision_cleanup()
@@ -121,11 +120,7 @@ void reachability_treet::post_hash_collision_cleanup()
 
 void reachability_treet::update_hash_collision_set()
 {
-  execution_statet &ex_state = get_cur_state();
-
-  crypto_hash hash;
-  hash = ex_state.generate_hash();
-  hit_hashes.insert(hash);
+  hit_hashes.insert(get_cur_state().generate_hash());
 }
 
 void reachability_treet::create_next_state()
@@ -137,6 +132,18 @@ void reachability_treet::create_next_state()
     auto new_state = ex_state.clone();
     execution_states.push_back(new_state);
 
+    if (dpor)
+    {
+      // Threads asleep here, and those already explored from here, start
+      // asleep in the new state, until its transition turns out to depend
+      // on theirs
+      new_state->dpor_backtrack.clear();
+      new_state->dpor_explored.clear();
+      for (const auto &[tid, footprint] : ex_state.dpor_explored)
+        new_state->dpor_sleep.insert_or_assign(tid, footprint);
+      new_state->dpor_sleep.erase(next_thread_id);
+    }
+
     /* Make it active, make it follow on from previous state... */
     if (new_state->get_active_state_number() != next_thread_id)
       new_state->increment_context_switch();
@@ -175,6 +182,9 @@ reachability_treet::decide_ileave_direction(execution_statet &ex_state)
     if (!check_thread_viable(tid, true))
       continue;
 
+    if (dpor && !dpor_schedulable(ex_state, tid))
+      continue;
+
     if (!ex_state.dfs_explore_thread(tid))
       continue;
 
@@ -236,11 +246,13 @@ bool reachability_treet::reset_to_unexplored_state()
   // all depths from the current execution state are explored, so delete it.
 
   auto it = cur_state_it--;
+  count_pruned_branches(**it);
   execution_states.erase(it);
 
   while (execution_states.size() > 0 && !step_next_state())
   {
     it = cur_state_it--;
+    count_pruned_branches(**it);
     execution_states.erase(it);
   }
 
@@ -480,8 +492,14 @@ void reachability_treet::print_ileave_trace() const
 
 bool reachability_treet::check_thread_viable(unsigned int tid, bool quiet) const
 {
-  const execution_statet &ex = get_cur_state();
+  return check_thread_viable(get_cur_state(), tid, quiet);
+}
 
+bool reachability_treet::check_thread_viable(
+  const execution_statet &ex,
+  unsigned int tid,
+  bool quiet) const
+{
   if (ex.DFS_traversed.at(tid) == true)
   {
     if (!quiet)
@@ -526,45 +544,76 @@ reachability_treet::get_next_formula()
 {
   assert(execution_states.size() > 0 && "Must setup RT before exploring");
 
-  while (!is_has_complete_formula())
-  {
-    while ((!get_cur_state().has_cswitch_point_occured() ||
-            get_cur_state().check_if_ileaves_blocked()) &&
-           get_cur_state().can_execution_continue())
-      get_cur_state().symex_step(*this);
+  while (!is_has_complete_formula() && run_to_next_switch())
+    switch_to_next_execution_state();
 
-    if (state_hashing)
-    {
-      if (check_for_hash_collision())
-      {
-        post_hash_collision_cleanup();
-        break;
-      }
+  (*cur_state_it)->add_memory_leak_checks();
 
-      update_hash_collision_set();
+  has_complete_formula = false;
+
+  return get_cur_state().get_symex_result();
+}
+
+bool reachability_treet::run_to_next_switch()
+{
+  while ((!get_cur_state().has_cswitch_point_occured() ||
+          get_cur_state().check_if_ileaves_blocked()) &&
+         get_cur_state().can_execution_continue())
+    get_cur_state().symex_step(*this);
+
+  if (state_hashing)
+  {
+    if (check_for_hash_collision())
+    {
+      post_hash_collision_cleanup();
+      return false;
     }
 
-    if (por)
+    update_hash_collision_set();
+  }
+
+  if (por)
+  {
+    get_cur_state().calculate_mpor_constraints();
+    if (get_cur_state().is_transition_blocked_by_mpor())
     {
-      get_cur_state().calculate_mpor_constraints();
-      if (get_cur_state().is_transition_blocked_by_mpor())
-        break;
+      ++pruned_branches;
+      return false;
     }
+  }
 
-    next_thread_id = decide_ileave_direction(get_cur_state());
+  if (dpor)
+  {
+    // Ask MPOR too, only to report what it would have pruned
+    get_cur_state().calculate_mpor_constraints();
+    if (get_cur_state().is_transition_blocked_by_mpor())
+      ++pruned_by_mpor;
 
-    if (get_cur_state().interleaving_unviable)
-      break;
-    create_next_state();
+    dpor_record_transition();
+  }
 
-    switch_to_next_execution_state();
+  // Along a restored path, only the recorded thread is left to explore
+  size_t depth = execution_states.size() - 1;
+  if (depth < restore_path.size())
+  {
+    std::vector<bool> &traversed = get_cur_state().DFS_traversed;
+    if (restore_path[depth] >= traversed.size())
+    {
+      log_error("Unexpected number of threads when restoring a DFS position");
+      abort();
+    }
+
+    std::fill(traversed.begin(), traversed.end(), true);
+    traversed[restore_path[depth]] = false;
   }
 
-  (*cur_state_it)->add_memory_leak_checks();
+  next_thread_id = decide_ileave_direction(get_cur_state());
 
-  has_complete_formula = false;
+  if (get_cur_state().interleaving_unviable)
+    return false;
+  create_next_state();
 
-  return get_cur_state().get_symex_result();
+  return true;
 }
 
 bool reachability_treet::setup_next_formula()
@@ -610,63 +659,145 @@ reachability_treet::generate_schedule_formula()
       schedule_target, schedule_total_claims, schedule_remaining_claims));
 }
 
-bool reachability_treet::restore_from_dfs_state(void *)
+void reachability_treet::dpor_record_transition()
 {
-  abort();
-#if 0
-  std::vector<reachability_treet::dfs_position::dfs_state>::const_iterator it;
-  unsigned int i;
+  execution_statet &ex = get_cur_state();
+  const unsigned int tid = ex.active_thread;
+  const execution_statet::footprintt footprint = ex.get_transition_footprint();
+
+  // Sleeping threads stay asleep only while what runs commutes with them
+  for (auto it = ex.dpor_sleep.begin(); it != ex.dpor_sleep.end();)
+    it = it->second.depends_on(footprint) ? ex.dpor_sleep.erase(it)
+                                          : std::next(it);
+
+  if (cur_state_it == execution_states.begin())
+    return;
+
+  (*std::prev(cur_state_it))->dpor_explored[tid] = footprint;
+
+  // Without tracking happens-before, any earlier transition of another thread
+  // that this one depends on may race with it. Reverse the race by running
+  // this thread first from where that transition was taken or, if it
+  // couldn't run yet, any thread that could
+  auto runnable = [](const execution_statet &from, unsigned int t) {
+    return t < from.threads_state.size() &&
+           !from.threads_state[t].thread_ended &&
+           !from.threads_state[t].call_stack.empty();
+  };
+
+  for (auto it = execution_states.begin(); it != cur_state_it; ++it)
+  {
+    const execution_statet &taken = **std::next(it);
+    if (taken.active_thread == tid)
+      continue;
 
-  const reachability_treet::dfs_position *foo = (const reachability_treet::dfs_position*)_dfs;
-  const reachability_treet::dfs_position &dfs = *foo;
-  // Symex repeatedly until context switch points. At each point, verify that it
-  // happened where we expected it to, and then switch to the correct thread for
-  // the history we've been provided with.
-  for (it = dfs.states.begin(), i = 0; it != dfs.states.end(); it++, i++) {
-
-    at_end_of_run = false;
-
-    while (!is_at_end_of_run()) {
-      // Restore the DFS exploration space so that when an interleaving occurs
-      // we take the option leading to the thread we desire to run. This
-      // assumes that the DFS exploration path algorithm never changes.
-      // Has to occur here; between generating new threads, ESBMC messes with
-      // the dfs state.
-      for (unsigned int dfspos = 0; dfspos < get_cur_state().DFS_traversed.size();
-           dfspos++)
-        get_cur_state().DFS_traversed[dfspos] = true;
-      get_cur_state().DFS_traversed[it->cur_thread] = false;
+    if (!taken.get_transition_footprint().depends_on(footprint))
+      continue;
 
-      get_cur_state().symex_step(*this);
+    execution_statet &from = **it;
+    if (runnable(from, tid))
+    {
+      from.dpor_backtrack.insert(tid);
+      continue;
     }
 
-    create_next_state();
+    for (unsigned int t = 0; t < from.threads_state.size(); t++)
+      if (runnable(from, t))
+        from.dpor_backtrack.insert(t);
+  }
+}
+
+bool reachability_treet::dpor_schedulable(
+  execution_statet &ex_state,
+  unsigned int tid)
+{
+  if (ex_state.dpor_sleep.count(tid))
+    return false;
+
+  // The first thread explored from a state starts its persistent set
+  if (ex_state.dpor_backtrack.empty())
+    ex_state.dpor_backtrack.insert(tid);
+
+  return ex_state.dpor_backtrack.count(tid) != 0;
+}
+
+void reachability_treet::count_pruned_branches(const execution_statet &ex_state)
+{
+  if (!dpor || ex_state.interleaving_unviable)
+    return;
 
-    get_cur_state().DFS_traversed = it->explored;
+  for (unsigned int tid = 0; tid < ex_state.threads_state.size(); tid++)
+  {
+    if (!check_thread_viable(ex_state, tid, true))
+      continue;
 
-    if (get_cur_state().threads_state.size() != it->num_threads)
+    ++pruned_branches;
+    if (ex_state.dpor_sleep.count(tid))
+      ++pruned_by_sleep_sets;
+  }
+}
+
+void reachability_treet::restore_from_dfs_state(const dfs_position &dfs)
 {
-log_error("Unexpected number of threads when reexploring checkpoint");
-abort();
+  assert(execution_states.size() == 1 && "Must setup RT before restoring");
+
+  // The final state of a position is a dummy, with no choice recorded
+  restore_path.clear();
+  for (size_t i = 0; i + 1 < dfs.states.size(); i++)
+    restore_path.push_back(dfs.states[i].cur_thread);
 }
 
-    switch_to_next_execution_state();
+std::vector<reachability_treet::dfs_position>
+reachability_treet::split_at_depth(unsigned int depth)
+{
+  std::vector<dfs_position> positions;
 
-    // check we're on the right thread; except on the last run, where there are
-    // no more threads to be run.
-    if (i + 1 < dfs.states.size())
-      assert(get_cur_state().get_active_state_number() == it->cur_thread);
+  setup_for_new_explore();
+  do
+  {
+    while (!is_has_complete_formula() && execution_states.size() <= depth &&
+           run_to_next_switch())
+      switch_to_next_execution_state();
 
-#if 0
-    if (get_cur_state().get_active_state().source.pc->location_number !=
-        it->location_number) {
-log_error("Interleave at unexpected location when restoring checkpoint").
-abort();
+    has_complete_formula = false;
+    positions.emplace_back(*this);
+  } while (reset_to_unexplored_state());
+
+  return positions;
 }
-#endif
+
+std::vector<reachability_treet::dfs_position>
+reachability_treet::donate_unexplored()
+{
+  std::vector<dfs_position> donated;
+  const dfs_position here(*this);
+
+  // The last state is being explored; the restored path isn't ours to give
+  size_t i = 0;
+  for (auto it = execution_states.begin();
+       donated.empty() && std::next(it) != execution_states.end();
+       ++it, ++i)
+  {
+    if (i < restore_path.size())
+      continue;
+
+    execution_statet &ex = **it;
+    for (unsigned int tid = 0; tid < ex.threads_state.size(); tid++)
+    {
+      if (!check_thread_viable(ex, tid, true))
+        continue;
+
+      ex.DFS_traversed[tid] = true;
+
+      dfs_position pos = here;
+      pos.states.resize(i + 2);
+      pos.states[i].cur_thread = tid;
+      pos.states[i + 1].cur_thread = 0;
+      donated.push_back(std::move(pos));
+    }
   }
-#endif
-  return false;
+
+  return donated;
 }
 
 void reachability_treet::save_checkpoint(const std::string &&) const
@@ -10,7 +10,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
-#include <util/crypto_hash.h>
+#include <util/state_fingerprint.h>
 #include <util/message.h>
 #include <util/options.h>
 
@@ -130,6 +130,15 @@ public:
    */
   bool check_thread_viable(unsigned int tid, bool quiet) const;
 
+  /**
+   *  Determine if a thread can be run from a given execution state.
+   *  @see check_thread_viable
+   */
+  bool check_thread_viable(
+    const execution_statet &ex,
+    unsigned int tid,
+    bool quiet) const;
+
   /**
    *  Check whether current ex_state is a state hash collision.
    *  @return True if this state has already been visited
@@ -217,6 +226,37 @@ public:
    */
   std::shared_ptr<goto_symext::symex_resultt> get_next_formula();
 
+  /**
+   *  Symex the current state up to its next context switch and pick the
+   *  thread to switch to, as get_next_formula does for each switch.
+   *  @return False if the interleaving stops here: its state was already
+   *  visited, is blocked by POR or became unviable.
+   */
+  bool run_to_next_switch();
+
+  /**
+   *  DPOR bookkeeping once the transition of the current state is complete.
+   *  Wakes up the threads it depends on, records it for its siblings, and
+   *  adds backtrack points to the earlier states where it may be reordered
+   *  with a transition it races with.
+   */
+  void dpor_record_transition();
+
+  /**
+   *  Whether DPOR allows switching to a thread: it's in the persistent set
+   *  of the state and not asleep.
+   *  @param ex_state State to switch from
+   *  @param tid Thread ID to switch to
+   *  @return True if the thread may be explored
+   */
+  bool dpor_schedulable(execution_statet &ex_state, unsigned int tid);
+
+  /**
+   *  Count the threads a state is backtracked over without exploring.
+   *  @param ex_state State that is about to be discarded
+   */
+  void count_pruned_branches(const execution_statet &ex_state);
+
   /**
    *  Run threads in --schedule manner.
    *  Run all threads to explore all interleavings, and encode it into a single
@@ -234,10 +274,11 @@ public:
 
   /**
    *  Class recording a reachability checkpoint.
-   *  Currently likely broken; but this originally redorced a particular trace
-   *  of the reachability that could written to file, then restored, then
-   *  re-reached through symbolic execution. Not going to document it until I
-   *  know that it works.
+   *  Records the path from the root of the reachability tree to the current
+   *  execution state: at each context switch point, the thread that was
+   *  switched to. The subtree below it can then be re-reached through
+   *  symbolic execution with restore_from_dfs_state, which is how parallel
+   *  exploration hands out work. Writing it to file is still unused.
    */
   class dfs_position
   {
@@ -288,12 +329,33 @@ public:
   };
 
   /**
-   *  Restore RT state to a reachability point.
-   *  Currently likely broken.
-   *  @param dfs State to restore
-   *  @return Dummy
+   *  Restrict exploration to the subtree below a reachability point.
+   *  Must follow setup_for_new_explore. The following get_next_formula
+   *  calls first re-execute the path recorded in \p dfs, taking the recorded
+   *  thread at each of its context switch points, then explore every
+   *  interleaving below it.
+   *  @param dfs Position to restore
+   */
+  void restore_from_dfs_state(const dfs_position &dfs);
+
+  /**
+   *  Explore the tree down to a context switch depth only.
+   *  Runs a fresh exploration that stops each interleaving after \p depth
+   *  context switches, without solving anything. Exploring every returned
+   *  position with restore_from_dfs_state then covers the whole tree.
+   *  @param depth Number of context switches to split the tree at
+   *  @return Positions of the subtrees, in DFS order
+   */
+  std::vector<dfs_position> split_at_depth(unsigned int depth);
+
+  /**
+   *  Give away unexplored subtrees of the current exploration.
+   *  Picks the shallowest context switch point of the current interleaving,
+   *  below the restored path, that still has threads left to explore. They
+   *  are marked as explored here and returned for another explorer.
+   *  @return Positions of the subtrees given away, maybe none
    */
-  bool restore_from_dfs_state(void *dfs);
+  std::vector<dfs_position> donate_unexplored();
 
   /**
    *  Save RT reachability state to file.
@@ -318,6 +380,14 @@ public:
   const namespacet &ns;
   /** Options that are enabled */
   optionst &options;
+  /** Branches of the tree that partial-order reduction didn't explore, since
+   *  the last setup_for_new_explore */
+  unsigned long long pruned_branches;
+  /** How many of pruned_branches were skipped due to DPOR sleep sets */
+  unsigned long long pruned_by_sleep_sets;
+  /** Under DPOR, how many of the transitions it explored MPOR would have
+   *  pruned, to compare the two reductions in one run */
+  unsigned long long pruned_by_mpor;
   /** __ESBMC_main thread has ended */
   bool main_thread_ended;
 
@@ -350,13 +420,18 @@ protected:
   unsigned int next_thread_id;
   /** Whether partial-order-reduction is enabled */
   bool por;
+  /** Whether dynamic partial-order reduction (--dpor) replaces MPOR */
+  bool dpor;
   /** Set of state hashes we've discovered */
-  std::set<crypto_hash> hit_hashes;
+  fingerprint_sett hit_hashes;
   /** Flag as to whether we're picking interleaving directions explicitly.
    *  Corresponds to the --interactive-ileaves option. */
   bool interactive_ileaves;
   /** Are we using the --schedule scheduling method? */
   bool schedule;
+  /** Thread to take at each of the first context switch points, set by
+   *  restore_from_dfs_state */
+  std::vector<unsigned int> restore_path;
 
   /* Map to store the expression and thread ID,
    * which that expression belongs to. */
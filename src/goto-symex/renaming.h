@@ -3,10 +3,10 @@
 
 #include <set>
 #include <boost/functional/hash.hpp>
-#include <util/crypto_hash.h>
 #include <util/expr_util.h>
 #include <util/guard.h>
 #include <util/i2string.h>
+#include <util/persistent_map.h>
 #include <irep2/irep2_expr.h>
 #include <util/std_expr.h>
 
@@ -276,11 +276,11 @@ public:
 
   friend void build_goto_symex_classes();
   // Repeat of the above ignored friend directive.
-  typedef std::unordered_map<name_record, valuet, name_rec_hash> current_namest;
+  // Persistent, so that forking the state at a branch is O(1) and merging
+  // it back only looks at the names assigned since.
+  typedef persistent_mapt<name_record, valuet, name_rec_hash> current_namest;
 
   current_namest current_names;
-  typedef std::map<const expr2tc, crypto_hash> current_state_hashest;
-  current_state_hashest current_hashes;
 };
 
 } // namespace renaming
@@ -1,10 +1,15 @@
 #include <goto-symex/slice.h>
 
 #include <util/prefix.h>
+#include <utility>
+
 static bool no_slice(const symbol2t &sym)
 {
-  return config.no_slice_names.count(sym.thename.as_string()) ||
-         config.no_slice_ids.count(sym.get_symbol_name());
+  // Checked for every symbol, don't build its name unless there's a need
+  return (!config.no_slice_names.empty() &&
+          config.no_slice_names.count(sym.thename.as_string())) ||
+         (!config.no_slice_ids.empty() &&
+          config.no_slice_ids.count(sym.get_symbol_name()));
 }
 
 template <bool Add>
@@ -23,31 +28,90 @@ bool symex_slicet::get_symbols(const expr2tc &expr)
 
   const symbol2t &s = to_symbol2t(expr);
   if constexpr (Add)
-    res |= depends.insert(s.get_symbol_name()).second;
+    res |= depends.insert(s.get_symbol_key()).second;
   else
-    res |= no_slice(s) || depends.find(s.get_symbol_name()) != depends.end();
+    res |= no_slice(s) || depends.count(s.get_symbol_key());
   return res;
 }
 
-void symex_slicet::run_on_assert(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::run(symex_target_equationt::SSA_stepst &eq)
+{
+  std::vector<bool> ignored;
+  for (const auto &step : std::as_const(eq))
+    ignored.push_back(step.ignore);
+  run(std::as_const(eq), ignored);
+
+  // Only write to the steps that were sliced
+  for (size_t i = 0; i < eq.size(); i++)
+    if (ignored[i] && !std::as_const(eq)[i].ignore)
+      eq[i].ignore = true;
+
+  return true;
+}
+
+bool symex_slicet::run(
+  const symex_target_equationt::SSA_stepst &eq,
+  std::vector<bool> &ignored)
+{
+  assert(ignored.size() == eq.size());
+  sliced = 0;
+  fine_timet algorithm_start = current_time();
+  // A step that is already ignored, such as a claim sliced away for
+  // another one, needs nothing from the steps before it
+  for (size_t i = eq.size(); i-- > 0;)
+    if (!ignored[i] && slice_step(eq[i]))
+      ignored[i] = true;
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "Slicing time: {}s (removed {} assignments)",
+    time2string(algorithm_stop - algorithm_start),
+    sliced);
+  return true;
+}
+
+bool symex_slicet::slice_step(const symex_target_equationt::SSA_stept &SSA_step)
+{
+  typedef goto_trace_stept::typet ssa_type;
+  switch (SSA_step.type)
+  {
+  case ssa_type::ASSIGNMENT:
+    return slice_assignment(SSA_step);
+  case ssa_type::ASSUME:
+    return slice_assume(SSA_step);
+  case ssa_type::ASSERT:
+    return slice_assert(SSA_step);
+  case ssa_type::RENUMBER:
+    return slice_renumber(SSA_step);
+  case ssa_type::OUTPUT:
+  case ssa_type::SKIP:
+    return false;
+  default:
+    log_warning("Invalid type for SSA step");
+    return false;
+  }
+}
+
+bool symex_slicet::slice_assert(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   get_symbols<true>(SSA_step.guard);
   get_symbols<true>(SSA_step.cond);
+  return false;
 }
 
-void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::slice_assume(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   if (!slice_assumes)
   {
     get_symbols<true>(SSA_step.guard);
     get_symbols<true>(SSA_step.cond);
-    return;
+    return false;
   }
 
   if (!get_symbols<false>(SSA_step.cond))
   {
     // we don't really need it
-    SSA_step.ignore = true;
     ++sliced;
     if (is_symbol2t(SSA_step.cond))
       log_debug(
@@ -56,17 +120,17 @@ void symex_slicet::run_on_assume(symex_target_equationt::SSA_stept &SSA_step)
         to_symbol2t(SSA_step.cond).get_symbol_name());
     else
       log_debug("slice", "slice ignoring assume expression");
+    return true;
   }
-  else
-  {
-    // If we need it, add the symbols to dependency
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.cond);
-  }
+
+  // If we need it, add the symbols to dependency
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.cond);
+  return false;
 }
 
-void symex_slicet::run_on_assignment(
-  symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::slice_assignment(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
   // TODO: create an option to ignore nondet symbols (test case generation)
@@ -81,45 +145,44 @@ void symex_slicet::run_on_assignment(
       {
         auto &sym = to_symbol2t(expr);
         if (has_prefix(sym.thename.as_string(), "nondet$"))
-          return;
+          return false;
       }
     }
 
     // we don't really need it
-    SSA_step.ignore = true;
     ++sliced;
     log_debug(
       "slice",
       "slice ignoring assignment to symbol {}",
       to_symbol2t(SSA_step.lhs).get_symbol_name());
+    return true;
   }
-  else
-  {
-    get_symbols<true>(SSA_step.guard);
-    get_symbols<true>(SSA_step.rhs);
 
-    // Remove this symbol as we won't be seeing any references to it further
-    // into the history.
-    depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
+  get_symbols<true>(SSA_step.guard);
+  get_symbols<true>(SSA_step.rhs);
+
+  // Remove this symbol as we won't be seeing any references to it further
+  // into the history.
+  depends.erase(to_symbol2t(SSA_step.lhs).get_symbol_key());
+  return false;
 }
 
-void symex_slicet::run_on_renumber(symex_target_equationt::SSA_stept &SSA_step)
+bool symex_slicet::slice_renumber(
+  const symex_target_equationt::SSA_stept &SSA_step)
 {
   assert(is_symbol2t(SSA_step.lhs));
 
-  if (!get_symbols<false>(SSA_step.lhs))
-  {
-    // we don't really need it
-    SSA_step.ignore = true;
-    ++sliced;
-    log_debug(
-      "slice",
-      "slice ignoring renumbering symbol {}",
-      to_symbol2t(SSA_step.lhs).get_symbol_name());
-  }
-
   // Don't collect the symbol; this insn has no effect on dependencies.
+  if (get_symbols<false>(SSA_step.lhs))
+    return false;
+
+  // we don't really need it
+  ++sliced;
+  log_debug(
+    "slice",
+    "slice ignoring renumbering symbol {}",
+    to_symbol2t(SSA_step.lhs).get_symbol_name());
+  return true;
 }
 
 /**
@@ -161,26 +224,42 @@ bool simple_slice::run(symex_target_equationt::SSA_stepst &steps)
 
 bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 {
+  std::vector<bool> ignored;
+  for (const auto &step : std::as_const(steps))
+    ignored.push_back(step.ignore);
+  run(std::as_const(steps), ignored);
+
+  // Only write to the assertions whose bit changed
+  for (size_t i = 0; i < steps.size(); i++)
+    if (std::as_const(steps)[i].ignore != ignored[i])
+      steps[i].ignore = ignored[i];
+
+  return true;
+}
+
+bool claim_slicer::run(
+  const symex_target_equationt::SSA_stepst &steps,
+  std::vector<bool> &ignored)
+{
+  assert(ignored.size() == steps.size());
   sliced = 0;
   fine_timet algorithm_start = current_time();
   size_t counter = 1;
-  for (symex_target_equationt::SSA_stepst::iterator it = steps.begin();
-       it != steps.end();
-       it++)
+  for (size_t i = 0; i < steps.size(); i++)
   {
     // just find the next assertion
-    if (it->is_assert())
+    if (steps[i].is_assert())
     {
       if (
         counter++ ==
         claim_to_keep) // this is the assertion that we should not skip!
       {
-        it->ignore = false;
-        claim_msg = it->comment;
+        ignored[i] = false;
+        claim_msg = steps[i].comment;
         continue;
       }
 
-      it->ignore = true;
+      ignored[i] = true;
       ++sliced;
     }
   }
@@ -5,7 +5,6 @@
 #include <util/time_stopping.h>
 #include <util/algorithms.h>
 #include <util/options.h>
-#include <boost/range/adaptor/reversed.hpp>
 
 /* Base interface */
 class slicer : public ssa_step_algorithm
@@ -53,6 +52,18 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+
+  /**
+   * Slice \p steps without writing to them, for claim-level copies that
+   * share their steps with the original equation.
+   *
+   * @param steps symex formula to be sliced
+   * @param ignored ignore bits standing in for SSA_stept::ignore, one per step
+   */
+  bool run(
+    const symex_target_equationt::SSA_stepst &steps,
+    std::vector<bool> &ignored);
+
   size_t claim_to_keep;
   std::string claim_msg;
 };
@@ -80,27 +91,27 @@ public:
    * getting symbol dependencies. If an
    * assignment, renumber or assume does not contain one
    * of the dependency symbols, then it will be ignored.
+   * Steps that are ignored already add no dependencies.
    *
    * @param eq symex formula to be sliced
    */
-  bool run(symex_target_equationt::SSA_stepst &eq) override
-  {
-    sliced = 0;
-    fine_timet algorithm_start = current_time();
-    for (auto &step : boost::adaptors::reverse(eq))
-      run_on_step(step);
-    fine_timet algorithm_stop = current_time();
-    log_status(
-      "Slicing time: {}s (removed {} assignments)",
-      time2string(algorithm_stop - algorithm_start),
-      sliced);
-    return true;
-  }
+  bool run(symex_target_equationt::SSA_stepst &eq) override;
+
+  /**
+   * Same as above, but without writing to the steps: the steps it slices
+   * are marked in \p ignored instead, which must hold one bit per step.
+   * Meant for claim-level copies, whose steps stay shared with the original.
+   *
+   * @param eq symex formula to be sliced
+   * @param ignored ignore bits standing in for SSA_stept::ignore
+   */
+  bool
+  run(const symex_target_equationt::SSA_stepst &eq, std::vector<bool> &ignored);
 
   /**
    * Holds the symbols the current equation depends on.
    */
-  std::unordered_set<std::string> depends;
+  std::unordered_set<symbol_keyt, symbol_key_hash> depends;
 
   static expr2tc get_nondet_symbol(const expr2tc &expr);
 
@@ -146,29 +157,26 @@ protected:
   bool get_symbols(const expr2tc &expr);
 
   /**
-   * Remove unneeded assumes from the formula
+   * Dispatch on the type of the step
    *
-   * Check if the Assume cond symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
-   *
-   * If the assume cond is in the #depends, then add its guards
-   * and cond into the #depends
-   *
-   * Note 1: All the conditions operands are going to be added
-   * into the #depends. This makes that the condition itself as
-   * a "reverse taint"
-   *
-   * TODO: What happens if the ASSUME would result in false?
+   * @param SSA_step a step of the formula
+   * @return whether the step can be ignored
+   */
+  bool slice_step(const symex_target_equationt::SSA_stept &SSA_step);
+
+  /**
+   * Keep an assertion: add its guard and cond into the #depends
    *
-   * @param SSA_step an assume step
+   * @param SSA_step an assert step
+   * @return whether the step can be ignored, which is never
    */
-  void run_on_assert(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool slice_assert(const symex_target_equationt::SSA_stept &SSA_step);
 
   /**
    * Remove unneeded assumes from the formula
    *
    * Check if the Assume cond symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
+   * it is not then the \SSA_Step can be ignored.
    *
    * If the assume cond is in the #depends, then add its guards
    * and cond into the #depends
@@ -180,34 +188,37 @@ protected:
    * TODO: What happens if the ASSUME would result in false?
    *
    * @param SSA_step an assume step
+   * @return whether the step can be ignored
    */
-  void run_on_assume(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool slice_assume(const symex_target_equationt::SSA_stept &SSA_step);
 
   /**
    * Remove unneeded assignments from the formula
    *
    * Check if the LHS symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
+   * it is not then the \SSA_Step can be ignored.
    *
    * If the assume cond is in the #depends, then add its guards
    * and cond into the #depends
    *
    * @param SSA_step an assignment step
+   * @return whether the step can be ignored
    */
-  void run_on_assignment(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool slice_assignment(const symex_target_equationt::SSA_stept &SSA_step);
 
   /**
    * Remove unneeded renumbers from the formula
    *
    * Check if the LHS symbol is in the #depends, if
-   * it is not then mark the \SSA_Step as ignored.
+   * it is not then the \SSA_Step can be ignored.
    *
    * If the assume cond is in the #depends, then add its guards
    * and cond into the #depends
    *
    * @param SSA_step an renumber step
+   * @return whether the step can be ignored
    */
-  void run_on_renumber(symex_target_equationt::SSA_stept &SSA_step) override;
+  bool slice_renumber(const symex_target_equationt::SSA_stept &SSA_step);
 };
 
 #endif
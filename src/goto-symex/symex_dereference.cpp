@@ -174,6 +174,7 @@ void goto_symext::dereference(expr2tc &expr, dereferencet::modet mode)
   // needs to be renamed to level 1
   assert(!cur_state->call_stack.empty());
   cur_state->top().level1.rename(expr);
+  const expr2tc accessed = expr;
 
   guardt guard;
   if (is_free(mode))
@@ -192,4 +193,13 @@ void goto_symext::dereference(expr2tc &expr, dereferencet::modet mode)
   }
   else
     dereference.dereference_expr(expr, guard, mode);
+
+  analyze_dereference(accessed, expr, mode);
+}
+
+void goto_symext::analyze_dereference(
+  const expr2tc &,
+  const expr2tc &,
+  dereferencet::modet)
+{
 }
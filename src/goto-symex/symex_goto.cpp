@@ -330,24 +330,30 @@ void goto_symext::phi_function(const statet::goto_statet &goto_state)
     tmp_guard -= cur_state->guard;
   }
 
-  for (const auto &[variable, _] : variables)
+  // Only names assigned on either side since the fork can differ; the rest
+  // is still shared and gets skipped. The loop below assigns to the current
+  // state, hence collect them first.
+  std::vector<renaming::level2t::name_record> changed;
+  variables.for_each_difference(
+    goto_variables,
+    [&changed](
+      const renaming::level2t::name_record &variable,
+      const renaming::level2t::valuet *cur,
+      const renaming::level2t::valuet *goto_) {
+      // If the variable was deleted in this branch, don't create an
+      // assignment for it
+      if (cur != nullptr && goto_ != nullptr && cur->count != goto_->count)
+        changed.push_back(variable);
+    });
+
+  for (const auto &variable : changed)
   {
-    if (
-      goto_state.level2.current_number(variable) ==
-      cur_state->level2.current_number(variable))
-      continue; // not changed
-
     if (variable.base_name == guard_identifier_s)
       continue; // just a guard
 
     if (has_prefix(variable.base_name.as_string(), "symex::invalid_object"))
       continue;
 
-    // If the variable was deleted in this branch, don't create an assignment
-    // for it
-    if (goto_variables.find(variable) == goto_variables.end())
-      continue;
-
     // changed!
     const symbolt &symbol = *ns.lookup(variable.base_name);
 
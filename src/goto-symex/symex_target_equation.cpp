@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <atomic>
+#include <boost/functional/hash.hpp>
 #include <cassert>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/goto_symex_state.h>
@@ -16,6 +19,32 @@ void symex_target_equationt::debug_print_step(const SSA_stept &step) const
   log_debug("ssa", "{}", oss.str());
 }
 
+symex_target_equationt::stack_tracet
+symex_target_equationt::intern_stack_trace(std::vector<stack_framet> &&trace)
+{
+  if (last_stack_trace && *last_stack_trace == trace)
+    return last_stack_trace;
+
+  stack_tracet t = std::make_shared<const std::vector<stack_framet>>(
+    std::move(trace));
+  last_stack_trace = *stack_traces.insert(t).first;
+  return last_stack_trace;
+}
+
+size_t symex_target_equationt::stack_trace_hash::operator()(
+  const stack_tracet &trace) const
+{
+  // Hash what stack_framet's operator== compares
+  size_t h = 0;
+  for (const stack_framet &frame : *trace)
+  {
+    boost::hash_combine(h, frame.function.get_no());
+    if (frame.src != nullptr)
+      boost::hash_combine(h, frame.src->pc->location_number);
+  }
+  return h;
+}
+
 void symex_target_equationt::assignment(
   const expr2tc &guard,
   const expr2tc &lhs,
@@ -41,7 +70,7 @@ void symex_target_equationt::assignment(
   SSA_step.cond = equality2tc(lhs, rhs);
   SSA_step.type = goto_trace_stept::ASSIGNMENT;
   SSA_step.source = source;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = intern_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if (debug_print)
@@ -102,7 +131,7 @@ void symex_target_equationt::assertion(
   SSA_step.type = goto_trace_stept::ASSERT;
   SSA_step.source = source;
   SSA_step.comment = msg;
-  SSA_step.stack_trace = stack_trace;
+  SSA_step.stack_trace = intern_stack_trace(std::move(stack_trace));
   SSA_step.loop_number = loop_number;
 
   if (debug_print)
@@ -132,28 +161,38 @@ void symex_target_equationt::renumber(
 
 void symex_target_equationt::convert(smt_convt &smt_conv)
 {
-  smt_convt::ast_vec assertions;
-  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
-
-  for (auto &SSA_step : SSA_steps)
-    convert_internal_step(smt_conv, assumpt_ast, assertions, SSA_step);
+  smt_convt::ast_vec assertions = convert_steps(smt_conv);
 
   if (!assertions.empty())
     smt_conv.assert_ast(
       smt_conv.make_n_ary(&smt_conv, &smt_convt::mk_or, assertions));
 }
 
+smt_convt::ast_vec symex_target_equationt::convert_steps(smt_convt &smt_conv)
+{
+  smt_convt::ast_vec assertions;
+  smt_astt assumpt_ast = smt_conv.convert_ast(gen_true_expr());
+
+  for (size_t i = 0; i < SSA_steps.size(); i++)
+    convert_internal_step(smt_conv, assumpt_ast, assertions, i);
+
+  return assertions;
+}
+
 void symex_target_equationt::convert_internal_step(
   smt_convt &smt_conv,
   smt_astt &assumpt_ast,
   smt_convt::ast_vec &assertions,
-  SSA_stept &step)
+  size_t i)
 {
-  static unsigned output_count = 0; // Temporary hack; should become scoped.
+  SSA_stept &step = SSA_steps[i];
+
+  // Temporary hack; should become scoped.
+  static std::atomic<unsigned> output_count = 0;
   smt_astt true_val = smt_conv.convert_ast(gen_true_expr());
   smt_astt false_val = smt_conv.convert_ast(gen_false_expr());
 
-  if (step.ignore)
+  if (is_ignored(i))
   {
     step.cond_ast = true_val;
     step.guard_ast = false_val;
@@ -365,20 +404,15 @@ void symex_target_equationt::check_for_duplicate_assigns() const
 
 unsigned int symex_target_equationt::clear_assertions()
 {
-  unsigned int num_asserts = 0;
-
-  for (SSA_stepst::iterator it = SSA_steps.begin(); it != SSA_steps.end(); it++)
-  {
-    if (it->type == goto_trace_stept::ASSERT)
-    {
-      SSA_stepst::iterator it2 = it;
-      it--;
-      SSA_steps.erase(it2);
-      num_asserts++;
-    }
-  }
-
-  return num_asserts;
+  size_t old_size = SSA_steps.size();
+  SSA_steps.erase(
+    std::remove_if(
+      SSA_steps.begin(),
+      SSA_steps.end(),
+      [](const SSA_stept &step) { return step.is_assert(); }),
+    SSA_steps.end());
+
+  return old_size - SSA_steps.size();
 }
 
 runtime_encoded_equationt::runtime_encoded_equationt(
@@ -388,42 +422,18 @@ runtime_encoded_equationt::runtime_encoded_equationt(
 {
   assert_vec_list.emplace_back();
   assumpt_chain.push_back(conv.convert_ast(gen_true_expr()));
-  cvt_progress = SSA_steps.end();
+  cvt_progress = 0;
 }
 
 void runtime_encoded_equationt::flush_latest_instructions()
 {
-  if (SSA_steps.size() == 0)
-    return;
-
-  SSA_stepst::iterator run_it = cvt_progress;
-  // Scenarios:
-  // * We're at the start of running, in which case cvt_progress == end
-  // * We're in the middle, but nothing is left to push, so run_it + 1 == end
-  // * We're in the middle, and there's more to convert.
-  if (run_it == SSA_steps.end())
-  {
-    run_it = SSA_steps.begin();
-  }
-  else
-  {
-    run_it++;
-    if (run_it == SSA_steps.end())
-    {
-      // There is in fact, nothing to do
-      return;
-    }
-
-    // Just roll on
-  }
-
-  // Now iterate from the start insn to convert, to the end of the list.
-  for (; run_it != SSA_steps.end(); ++run_it)
+  // Convert every step recorded since the last flush
+  for (; cvt_progress < SSA_steps.size(); ++cvt_progress)
     convert_internal_step(
-      conv, assumpt_chain.back(), assert_vec_list.back(), *run_it);
-
-  run_it--;
-  cvt_progress = run_it;
+      conv,
+      assumpt_chain.back(),
+      assert_vec_list.back(),
+      cvt_progress);
 }
 
 void runtime_encoded_equationt::push_ctx()
@@ -439,13 +449,8 @@ void runtime_encoded_equationt::push_ctx()
 
 void runtime_encoded_equationt::pop_ctx()
 {
-  SSA_stepst::iterator it = scoped_end_points.back();
-  cvt_progress = it;
-
-  if (SSA_steps.size() != 0)
-    ++it;
-
-  SSA_steps.erase(it, SSA_steps.end());
+  cvt_progress = scoped_end_points.back();
+  SSA_steps.erase(SSA_steps.begin() + cvt_progress, SSA_steps.end());
 
   conv.pop_ctx();
   scoped_end_points.pop_back();
@@ -479,7 +484,7 @@ std::shared_ptr<symex_targett> runtime_encoded_equationt::clone() const
     "cloned when it contains data");
   auto nthis = std::shared_ptr<runtime_encoded_equationt>(
     new runtime_encoded_equationt(*this));
-  nthis->cvt_progress = nthis->SSA_steps.end();
+  nthis->cvt_progress = 0;
   return nthis;
 }
 
@@ -10,6 +10,8 @@
 #include <list>
 #include <map>
 #include <solvers/smt/smt_conv.h>
+#include <unordered_set>
+#include <util/chunked_vector.h>
 #include <util/config.h>
 #include <irep2/irep2.h>
 #include <util/namespace.h>
@@ -20,6 +22,8 @@ class symex_target_equationt : public symex_targett
 public:
   class SSA_stept;
 
+  typedef std::shared_ptr<const std::vector<stack_framet>> stack_tracet;
+
   symex_target_equationt(const namespacet &_ns) : ns(_ns)
   {
     debug_print = config.options.get_bool_option("symex-ssa-trace");
@@ -72,11 +76,24 @@ public:
     const sourcet &source) override;
 
   virtual void convert(smt_convt &smt_conv);
+
+  /**
+   * Encode every step into \p smt_conv without asserting the claims. Each
+   * assertion step is left with its cond_ast holding "assumptions imply
+   * claim", so that claims can later be checked one at a time.
+   *
+   * @return the negation of every claim, in step order
+   */
+  smt_convt::ast_vec convert_steps(smt_convt &smt_conv);
+
+  /**
+   * Encode step \p i into \p smt_conv, or make it trivial if it is ignored.
+   */
   void convert_internal_step(
     smt_convt &smt_conv,
     smt_astt &assumpt_ast,
     smt_convt::ast_vec &assertions,
-    SSA_stept &s);
+    size_t i);
 
   class SSA_stept
   {
@@ -86,8 +103,8 @@ public:
 
     // One stack trace recorded per function activation record. Valid for
     // assignment and assert steps only. In reverse order (most recent in idx
-    // 0).
-    std::vector<stack_framet> stack_trace;
+    // 0). Steps with the same trace share it, see intern_stack_trace.
+    stack_tracet stack_trace;
 
     bool is_assert() const
     {
@@ -162,18 +179,36 @@ public:
     return i;
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  // Copying the equation shares the steps until either copy writes to them
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
+  /**
+   * Ignore bits of a claim-level copy, one per step. When not empty, they
+   * stand in for SSA_stept::ignore, so that slicing the copy for its claim
+   * leaves the steps it shares with the original untouched.
+   */
+  std::vector<bool> claim_ignore;
+
+  /// The current SSA_stept::ignore of every step, to start claim_ignore from
+  std::vector<bool> ignore_bits() const
+  {
+    std::vector<bool> bits;
+    bits.reserve(SSA_steps.size());
+    for (const auto &SSA_step : SSA_steps)
+      bits.push_back(SSA_step.ignore);
+    return bits;
+  }
+
+  bool is_ignored(size_t i) const
+  {
+    return claim_ignore.empty() ? SSA_steps[i].ignore : claim_ignore[i];
+  }
+
   SSA_stepst::iterator get_SSA_step(unsigned s)
   {
-    SSA_stepst::iterator it = SSA_steps.begin();
-    for (; s != 0; s--)
-    {
-      assert(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    assert(s <= SSA_steps.size());
+    return SSA_steps.begin() + s;
   }
 
   void output(std::ostream &out) const;
@@ -184,6 +219,8 @@ public:
   void clear()
   {
     SSA_steps.clear();
+    claim_ignore.clear();
+    stack_traces.clear();
   }
 
   unsigned int clear_assertions();
@@ -207,6 +244,27 @@ protected:
 
 private:
   void debug_print_step(const SSA_stept &step) const;
+
+  /* Returns the recorded trace equal to \p trace, recording it if there is
+   * none yet. Consecutive steps nearly always come from the same frames. */
+  stack_tracet intern_stack_trace(std::vector<stack_framet> &&trace);
+
+  struct stack_trace_hash
+  {
+    size_t operator()(const stack_tracet &trace) const;
+  };
+
+  struct stack_trace_equal
+  {
+    bool operator()(const stack_tracet &a, const stack_tracet &b) const
+    {
+      return *a == *b;
+    }
+  };
+
+  std::unordered_set<stack_tracet, stack_trace_hash, stack_trace_equal>
+    stack_traces;
+  stack_tracet last_stack_trace;
 };
 
 class runtime_encoded_equationt : public symex_target_equationt
@@ -231,17 +289,11 @@ public:
   smt_convt &conv;
   std::list<smt_convt::ast_vec> assert_vec_list;
   std::list<smt_astt> assumpt_chain;
-  std::list<SSA_stepst::iterator> scoped_end_points;
-  SSA_stepst::iterator cvt_progress;
+  // Number of steps converted so far, and at each pushed context
+  std::list<size_t> scoped_end_points;
+  size_t cvt_progress;
 };
 
-extern inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a) < &(*b);
-}
-
 std::ostream &
 operator<<(std::ostream &out, const symex_target_equationt::SSA_stept &step);
 std::ostream &
@@ -6,6 +6,7 @@
  */
 
 #include <big-int/bigint.hh>
+#include <atomic>
 #include <boost/bind/placeholders.hpp>
 #include <boost/crc.hpp>
 #include <boost/functional/hash_fwd.hpp>
@@ -26,6 +27,7 @@
 #include <boost/preprocessor/list/adt.hpp>
 #include <boost/preprocessor/list/for_each.hpp>
 #include <cstdarg>
+#include <cstdint>
 #include <functional>
 #include <util/compiler_defs.h>
 #include <util/crypto_hash.h>
@@ -256,7 +258,7 @@ public:
   {
     detach();
     T *tmp = std::shared_ptr<T>::get();
-    tmp->crc_val = 0;
+    tmp->crc_val.store(0, std::memory_order_relaxed);
     return tmp;
   }
 
@@ -272,13 +274,19 @@ public:
 
   void detach()
   {
-    /* TODO threads: this is unsafe for multi-threaded execution
-     *
-     * From the docs: In multithreaded environment, the value returned by
-     * use_count is approximate (typical implementations use a
-     * memory_order_relaxed load). */
-    if (this->use_count() == 1)
+    /* use_count() is a relaxed load. If it reads 1, this container holds the
+     * only reference and nobody can take a new one (except through the
+     * hash-consing table, see below), so the count is exact; but the release
+     * of the last other reference, possibly on another thread, must still be
+     * ordered before our writes to the node, hence the acquire fence. Any
+     * other value is at worst stale, which only costs a needless copy. */
+    if (this->use_count() == 1 && !std::shared_ptr<T>::get()->interned)
+    {
+      std::atomic_thread_fence(std::memory_order_acquire);
       return; // No point remunging oneself if we're the only user of the ptr.
+    }
+    // Hash-consed nodes are never written to, as the intern table holds a
+    // (weak) reference to them that the count above doesn't see.
 
     // Assign-operate ourself into containing a fresh copy of the data. This
     // creates a new reference counted object, and assigns it to ourself,
@@ -303,17 +311,18 @@ public:
     std::shared_ptr<T>::swap(b);
   }
 
+  // Only expressions simplify, see simplify_cached()
   irep_container simplify() const
   {
-    const T *foo = get();
-    return foo->simplify();
+    return simplify_cached(*this);
   }
 
   size_t crc() const
   {
     const T *foo = get();
-    if (foo->crc_val != 0)
-      return foo->crc_val;
+    size_t crc = foo->crc_val.load(std::memory_order_relaxed);
+    if (crc != 0)
+      return crc;
 
     return foo->do_crc();
   }
@@ -340,6 +349,10 @@ public:
     if (!a || !b)
       return false;
 
+    // Equal hash-consed nodes are one and the same, see hash_cons()
+    if (a->interned && b->interned)
+      return false;
+
     return *a == *b; // different pointees could still compare equal
   }
 
@@ -393,6 +406,38 @@ private:
 typedef irep_container<type2t> type2tc;
 typedef irep_container<expr2t> expr2tc;
 
+/** Hash-consing ("maximal sharing") of irep2 nodes, off by default.
+ *  When enabled, the something2tc / something_type2tc functions look each new
+ *  node up in a global table of weak references and return the live node
+ *  that is structurally equal to it, if there is one. Equal hash-consed nodes
+ *  are then the same object, so comparing two of them only compares pointers,
+ *  and their crc is computed once. Hash-consed nodes are immutable: writing
+ *  through a container always detaches a private copy first. */
+extern bool irep2_hash_consing;
+
+expr2tc hash_cons(expr2tc &&e);
+type2tc hash_cons(type2tc &&t);
+
+/** Memoisation of expr2tc::simplify(). Each thread remembers what the
+ *  simplifier answered for the expressions it was asked about, including
+ *  "nothing to simplify", so that subterms shared between many expressions,
+ *  such as guards, are only simplified once. At most
+ *  irep2_simplify_cache_size answers are kept, those unused for longest are
+ *  dropped first; 0 turns the cache off. */
+extern size_t irep2_simplify_cache_size;
+
+struct simplify_cache_statst
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evicted = 0;
+};
+
+/** Counters of the calling thread's cache */
+simplify_cache_statst simplify_cache_stats();
+
+expr2tc simplify_cached(const expr2tc &e);
+
 typedef std::pair<std::string, std::string> member_entryt;
 typedef std::list<member_entryt> list_of_memberst;
 
@@ -453,8 +498,8 @@ protected:
    */
   type2t(type_ids id);
 
-  /** Copy constructor */
-  type2t(const type2t &ref) = default;
+  /** Copy constructor, the copy isn't hash-consed */
+  type2t(const type2t &ref);
 
   virtual void foreach_subtype_impl_const(const_subtype_delegate &t) const = 0;
   virtual void foreach_subtype_impl(subtype_delegate &t) = 0;
@@ -600,7 +645,12 @@ public:
   // XXX XXX XXX this should be const
   type_ids type_id;
 
-  mutable size_t crc_val;
+  /** Cached crc, 0 if not computed yet. Threads sharing the node may race
+   *  to compute it, but they all publish the same value. */
+  mutable std::atomic<size_t> crc_val;
+
+  /** Whether this node is in the hash-consing table. */
+  mutable bool interned;
 };
 
 /** Fetch identifying name for a type.
@@ -855,7 +905,12 @@ public:
   /** Type of this expr. All exprs have a type. */
   type2tc type;
 
-  mutable size_t crc_val;
+  /** Cached crc, 0 if not computed yet. Threads sharing the node may race
+   *  to compute it, but they all publish the same value. */
+  mutable std::atomic<size_t> crc_val;
+
+  /** Whether this node is in the hash-consing table. */
+  mutable bool interned;
 };
 
 inline bool is_nil_expr(const expr2tc &exp)
@@ -1167,7 +1222,7 @@ protected:
     unsigned int indent) const;
   bool cmp_rec(const base2t &ref) const;
   int lt_rec(const base2t &ref) const;
-  void do_crc_rec() const;
+  void do_crc_rec(size_t &crc) const;
   void hash_rec(crypto_hash &hash) const;
 
   // These methods are specific to expressions rather than types, and are
@@ -1236,8 +1291,9 @@ protected:
     return 0;
   }
 
-  void do_crc_rec() const
+  void do_crc_rec(size_t &crc) const
   {
+    (void)crc;
   }
 
   void hash_rec(crypto_hash &hash) const
@@ -1,4 +1,6 @@
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <boost/functional/hash.hpp>
 #include <util/fixedbv.h>
 #include <util/i2string.h>
@@ -119,15 +121,88 @@ static_assert(
   sizeof(expr_names) == (expr2t::end_expr_id * sizeof(char *)),
   "Missing expr name");
 
+/******************************** Hash-consing ********************************/
+
+bool irep2_hash_consing = false;
+
+namespace
+{
+/* Live hash-consed nodes of one kind, by crc. The table only holds weak
+ * references, so nodes die as usual once the last container lets go of them;
+ * their entries are swept whenever the table has doubled in size. */
+template <typename T>
+class hash_cons_tablet
+{
+public:
+  irep_container<T> intern(irep_container<T> &&e)
+  {
+    // Only read through this one, writing would detach
+    const irep_container<T> &ce = e;
+    if (!ce || ce->interned)
+      return std::move(e);
+
+    size_t h = ce.crc();
+
+    std::lock_guard lock(mutex);
+    auto range = table.equal_range(h);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+      std::shared_ptr<const irep2t> p = it->second.lock();
+      if (!p)
+        continue;
+
+      const T *node = static_cast<const T *>(p.get());
+      if (*node == *ce)
+        return irep_container<T>(
+          std::const_pointer_cast<T>(std::static_pointer_cast<const T>(p)));
+    }
+
+    ce->interned = true;
+    table.emplace(h, ce->weak_from_this());
+
+    if (table.size() >= sweep_at)
+    {
+      for (auto it = table.begin(); it != table.end();)
+        it = it->second.expired() ? table.erase(it) : std::next(it);
+      sweep_at = std::max<size_t>(1024, 2 * table.size());
+    }
+
+    return std::move(e);
+  }
+
+private:
+  std::mutex mutex;
+  std::unordered_multimap<size_t, std::weak_ptr<const irep2t>> table;
+  size_t sweep_at = 1024;
+};
+
+hash_cons_tablet<expr2t> expr_table;
+hash_cons_tablet<type2t> type_table;
+} // namespace
+
+expr2tc hash_cons(expr2tc &&e)
+{
+  return expr_table.intern(std::move(e));
+}
+
+type2tc hash_cons(type2tc &&t)
+{
+  return type_table.intern(std::move(t));
+}
+
 /*************************** Base expr2t definitions **************************/
 
 expr2t::expr2t(const type2tc &_type, expr_ids id)
-  : expr_id(id), type(_type), crc_val(0)
+  : expr_id(id), type(_type), crc_val(0), interned(false)
 {
 }
 
 expr2t::expr2t(const expr2t &ref)
-  : expr_id(ref.expr_id), type(ref.type), crc_val(ref.crc_val)
+  : irep2t(ref),
+    expr_id(ref.expr_id),
+    type(ref.type),
+    crc_val(ref.crc_val.load(std::memory_order_relaxed)),
+    interned(false)
 {
 }
 
@@ -192,9 +267,11 @@ size_t expr2t::crc() const
 
 size_t expr2t::do_crc() const
 {
-  boost::hash_combine(this->crc_val, type->do_crc());
-  boost::hash_combine(this->crc_val, (uint8_t)expr_id);
-  return this->crc_val;
+  size_t crc = 0;
+  boost::hash_combine(crc, type->do_crc());
+  boost::hash_combine(crc, (uint8_t)expr_id);
+  crc_val.store(crc, std::memory_order_relaxed);
+  return crc;
 }
 
 void expr2t::hash(crypto_hash &hash) const
@@ -283,6 +360,45 @@ std::string symbol_data::get_symbol_name() const
   }
 }
 
+symbol_keyt symbol_data::get_symbol_key() const
+{
+  // Mirrors get_symbol_name(): only the numbers it prints take part, and
+  // levels that print the same fields share a tag
+  symbol_keyt key{thename.get_no(), 0, 0, 0};
+  switch (rlevel)
+  {
+  case level0:
+  case level1_global:
+    break;
+  case level1:
+    key.level = 1;
+    key.l1 = (uint64_t(level1_num) << 32) | thread_num;
+    break;
+  case level2:
+    key.level = 2;
+    key.l1 = (uint64_t(level1_num) << 32) | thread_num;
+    key.l2 = (uint64_t(node_num) << 32) | level2_num;
+    break;
+  case level2_global:
+    key.level = 3;
+    key.l2 = (uint64_t(node_num) << 32) | level2_num;
+    break;
+  default:
+    assert(0 && "Unrecognized renaming level enum");
+    abort();
+  }
+  return key;
+}
+
+size_t symbol_key_hash::operator()(const symbol_keyt &key) const
+{
+  size_t h = key.name;
+  boost::hash_combine(h, key.level);
+  boost::hash_combine(h, key.l1);
+  boost::hash_combine(h, key.l2);
+  return h;
+}
+
 expr2tc constant_string2t::to_array() const
 {
   std::vector<expr2tc> contents;
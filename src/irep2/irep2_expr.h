@@ -1,6 +1,7 @@
 #ifndef IREP2_EXPR_H_
 #define IREP2_EXPR_H_
 
+#include <cstdint>
 #include <util/config.h>
 #include <util/c_types.h>
 #include <util/fixedbv.h>
@@ -199,6 +200,35 @@ public:
   typedef esbmct::expr2t_traits<value_field> traits;
 };
 
+/**
+ * Identity of a renamed symbol: two symbols have equal keys exactly when
+ * get_symbol_name() gives them the same name, but making a key builds no
+ * string. Meant for sets and maps of symbols that don't need the name.
+ */
+struct symbol_keyt
+{
+  unsigned int name; // thename's number in the string table
+  unsigned int level;
+  uint64_t l1; // level1_num and thread_num, if part of the name
+  uint64_t l2; // node_num and level2_num, if part of the name
+
+  bool operator==(const symbol_keyt &ref) const
+  {
+    return name == ref.name && level == ref.level && l1 == ref.l1 &&
+           l2 == ref.l2;
+  }
+
+  bool operator!=(const symbol_keyt &ref) const
+  {
+    return !(*this == ref);
+  }
+};
+
+struct symbol_key_hash
+{
+  size_t operator()(const symbol_keyt &key) const;
+};
+
 class symbol_data : public expr2t
 {
 public:
@@ -232,6 +262,7 @@ public:
   symbol_data(const symbol_data &ref) = default;
 
   virtual std::string get_symbol_name() const;
+  symbol_keyt get_symbol_key() const;
 
   // So: I want to make this private, however then all the templates accessing
   // it can't access it; and the typedef for symbol_expr_methods further down
@@ -1394,8 +1425,11 @@ public:
   template <typename... Args>                                                  \
   inline expr2tc basename##2tc(Args && ...args)                                \
   {                                                                            \
-    return expr2tc(std::static_pointer_cast<expr2t>(                           \
+    expr2tc e(std::static_pointer_cast<expr2t>(                                \
       std::make_shared<basename##2t>(std::forward<Args>(args)...)));           \
+    if (irep2_hash_consing)                                                    \
+      return hash_cons(std::move(e));                                          \
+    return e;                                                                  \
   }                                                                            \
   typedef esbmct::expr_methods2<basename##2t, superclass, superclass::traits>  \
     basename##_expr_methods;                                                   \
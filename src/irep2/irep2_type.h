@@ -309,8 +309,11 @@ public:
   template <typename... Args>                                                  \
   inline type2tc basename##_type2tc(Args &&...args)                            \
   {                                                                            \
-    return type2tc(std::static_pointer_cast<type2t>(                           \
+    type2tc t(std::static_pointer_cast<type2t>(                                \
       std::make_shared<basename##_type2t>(std::forward<Args>(args)...)));      \
+    if (irep2_hash_consing)                                                    \
+      return hash_cons(std::move(t));                                          \
+    return t;                                                                  \
   }                                                                            \
   typedef esbmct::                                                             \
     type_methods2<basename##_type2t, superclass, superclass::traits>           \
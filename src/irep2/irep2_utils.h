@@ -6,6 +6,7 @@
 #include <irep2/irep2_expr.h>
 #include <util/migrate.h>
 #include <util/message.h>
+#include <utility>
 
 std::string indent_str_irep2(unsigned int indent);
 
@@ -292,7 +293,7 @@ inline const type2tc &get_base_array_subtype(const type2tc &type)
 
 inline bool simplify(expr2tc &expr)
 {
-  expr2tc tmp = expr->simplify();
+  expr2tc tmp = std::as_const(expr).simplify();
   if (!is_nil_expr(tmp))
   {
     expr = tmp;
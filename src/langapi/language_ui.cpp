@@ -1,7 +1,9 @@
 #include <fstream>
 #include <langapi/language_ui.h>
 #include <langapi/mode.h>
+#include <algorithm>
 #include <memory>
+#include <thread>
 #include <util/i2string.h>
 #include <util/message.h>
 #include <util/show_symbol_table.h>
@@ -10,18 +12,76 @@ language_uit::language_uit(const cmdlinet &__cmdline) : _cmdline(__cmdline)
 {
 }
 
+unsigned language_uit::frontend_jobs() const
+{
+  // "frontend-jobs 0" uses one job per hardware thread
+  const std::string jobs = config.options.get_option("frontend-jobs");
+  if (jobs.empty())
+    return 1;
+
+  const int n = stoi(jobs);
+  if (n < 0)
+  {
+    log_error("the value of frontend-jobs should be positive!");
+    abort();
+  }
+
+  return n ? n : std::max(1u, std::thread::hardware_concurrency());
+}
+
 bool language_uit::parse()
 {
+  const unsigned jobs = frontend_jobs();
+  if (jobs <= 1 || _cmdline.args.size() <= 1)
+  {
+    for (const auto &arg : _cmdline.args)
+    {
+      if (parse(arg))
+        return true;
+    }
+
+    return false;
+  }
+
+  // Set up every file first, then parse them all at once
   for (const auto &arg : _cmdline.args)
   {
-    if (parse(arg))
+    if (!add_file(arg))
       return true;
   }
 
+  log_progress(
+    "Parsing {} files with {} parallel jobs", _cmdline.args.size(), jobs);
+
+  if (language_files.parse(jobs))
+  {
+    log_error("PARSING ERROR");
+    return true;
+  }
+
   return false;
 }
 
 bool language_uit::parse(const std::string &filename)
+{
+  language_filet *lf = add_file(filename);
+  if (!lf)
+    return true;
+
+  log_progress("Parsing {}", filename);
+
+  if (lf->language->parse(filename))
+  {
+    log_error("PARSING ERROR");
+    return true;
+  }
+
+  lf->get_modules();
+
+  return false;
+}
+
+language_filet *language_uit::add_file(const std::string &filename)
 {
   language_idt lang = language_id_by_path(filename);
   int mode = get_mode(lang);
@@ -29,7 +89,7 @@ bool language_uit::parse(const std::string &filename)
   if (mode < 0)
   {
     log_error("failed to figure out type of file {}", filename);
-    return true;
+    return nullptr;
   }
 
   if (config.options.get_bool_option("old-frontend"))
@@ -38,7 +98,7 @@ bool language_uit::parse(const std::string &filename)
     if (mode == -1)
     {
       log_error("old-frontend was not built on this version of ESBMC");
-      return true;
+      return nullptr;
     }
   }
 
@@ -49,7 +109,7 @@ bool language_uit::parse(const std::string &filename)
   if (!infile)
   {
     log_error("failed to open input file {}", filename);
-    return true;
+    return nullptr;
   }
 
   std::pair<language_filest::filemapt::iterator, bool> result =
@@ -62,20 +122,19 @@ bool language_uit::parse(const std::string &filename)
   language_filet &lf = result.first->second;
   lf.filename = filename;
   lf.language = mode_table[mode].new_language();
-  languaget &language = *lf.language;
-
-  log_progress("Parsing {}", filename);
 
 #ifdef ENABLE_SOLIDITY_FRONTEND
   if (mode == get_mode(language_idt::SOLIDITY))
   {
+    languaget &language = *lf.language;
+
     if (!config.options.get_option("function").empty())
       language.set_func_name(_cmdline.vm["function"].as<std::string>());
 
     if (config.options.get_option("sol") == "")
     {
       log_error("Please set the smart contract source file.");
-      return true;
+      return nullptr;
     }
     else
     {
@@ -84,22 +143,14 @@ bool language_uit::parse(const std::string &filename)
   }
 #endif
 
-  if (language.parse(filename))
-  {
-    log_error("PARSING ERROR");
-    return true;
-  }
-
-  lf.get_modules();
-
-  return false;
+  return &lf;
 }
 
 bool language_uit::typecheck()
 {
   log_progress("Converting");
 
-  if (language_files.typecheck(context))
+  if (language_files.typecheck(context, frontend_jobs()))
   {
     log_error("CONVERSION ERROR");
     return true;
@@ -29,6 +29,11 @@ public:
   virtual void show_symbol_table_xml_ui();
 
 protected:
+  /// Registers filename in language_files, with a language to parse it
+  language_filet *add_file(const std::string &filename);
+  /// Number of threads for parsing and converting, see --frontend-jobs
+  unsigned frontend_jobs() const;
+
   const cmdlinet &_cmdline;
 };
 
@@ -23,7 +23,7 @@
 #include <util/type_byte_size.h>
 
 // global data, horrible
-unsigned int dereferencet::invalid_counter = 0;
+thread_local unsigned int dereferencet::invalid_counter = 0;
 
 static inline const array_type2t get_arr_type(const expr2tc &expr)
 {
@@ -276,7 +276,7 @@ private:
   dereference_callbackt &dereference_callback;
   /** The number of failed symbols that we've generated (they're numbered
    *  individually. */
-  static unsigned invalid_counter;
+  static thread_local unsigned invalid_counter;
   /** Whether or not we're operating in a big endian environment. Value for this
    *  is taken from config.ansi_c.endianness. */
   bool is_big_endian;
@@ -18,8 +18,8 @@
 #include <util/std_expr.h>
 #include <util/type_byte_size.h>
 
-object_numberingt value_sett::object_numbering;
-object_number_numberingt value_sett::obj_numbering_refset;
+thread_local object_numberingt value_sett::object_numbering;
+thread_local object_number_numberingt value_sett::obj_numbering_refset;
 
 void value_sett::output(std::ostream &out) const
 {
@@ -128,25 +128,31 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
 {
   bool result = false;
 
+  // Entries that both sets still share can't add anything; only look at the
+  // ones that differ. They're collected first, as merging writes to values.
+  std::vector<std::pair<irep_idt, const entryt *>> changed;
+  values.for_each_difference(
+    new_values,
+    [&changed](const irep_idt &name, const entryt *, const entryt *new_e) {
+      if (new_e != nullptr)
+        changed.emplace_back(name, new_e);
+    });
+
   // Iterate over all new values; if they're in the current value set, merge
   // them. If not, only merge it in if keepnew is true.
-  for (const auto &new_value : new_values)
+  for (const auto &[name, new_e] : changed)
   {
-    valuest::iterator it2 = values.find(new_value.first);
-
     // If the new variable isnt in this' set,
-    if (it2 == values.end())
+    if (values.count(name) == 0)
     {
       // We always track these when merging value sets, as these store data
       // that's transfered back and forth between function calls. So, the
       // variables not existing in the state we're merging into is irrelevant.
       if (
-        has_prefix(
-          id2string(new_value.second.identifier),
-          "value_set::dynamic_object") ||
-        new_value.second.identifier == "value_set::return_value" || keepnew)
+        has_prefix(id2string(new_e->identifier), "value_set::dynamic_object") ||
+        new_e->identifier == "value_set::return_value" || keepnew)
       {
-        values.insert(new_value);
+        values.insert({name, *new_e});
         result = true;
       }
 
@@ -154,10 +160,7 @@ bool value_sett::make_union(const value_sett::valuest &new_values, bool keepnew)
     }
 
     // The variable was in this' set, merge the values.
-    entryt &e = it2->second;
-    const entryt &new_e = new_value.second;
-
-    if (make_union(e.object_map, new_e.object_map))
+    if (make_union(values[name].object_map, new_e->object_map))
       result = true;
   }
 
@@ -1168,8 +1171,8 @@ void value_sett::do_free(const expr2tc &op)
   }
 
   // mark these as 'may be invalid'
-  // this, unfortunately, destroys the sharing
-  for (auto &value : values)
+  std::vector<std::pair<irep_idt, object_mapt>> updates;
+  for (const auto &value : values)
   {
     object_mapt new_object_map;
 
@@ -1203,8 +1206,12 @@ void value_sett::do_free(const expr2tc &op)
     }
 
     if (changed)
-      value.second.object_map = new_object_map;
+      updates.emplace_back(value.first, std::move(new_object_map));
   }
+
+  // Only the entries that changed lose their sharing
+  for (auto &[name, object_map] : updates)
+    values[name].object_map = std::move(object_map);
 }
 
 void value_sett::assign_rec(
@@ -7,6 +7,7 @@
 #include <util/mp_arith.h>
 #include <util/namespace.h>
 #include <util/numbering.h>
+#include <util/persistent_map.h>
 #include <util/type_byte_size.h>
 
 /** Code for tracking "value sets" across assignments in ESBMC.
@@ -245,8 +246,9 @@ public:
 
   /** Type of the value-set containing structure. A hash map mapping variables
    *  to an entryt, storing the value set of objects a variable might point
-   *  at. */
-  typedef std::unordered_map<irep_idt, entryt, irep_id_hash> valuest;
+   *  at. It is persistent: copies share their entries until written to, so
+   *  that the copy symex takes at every branch is cheap. */
+  typedef persistent_mapt<irep_idt, entryt, irep_id_hash> valuest;
 
   /** Get the natural alignment unit of a reference to e. I don't know a more
    *  appropriate term, but if we were to have an offset into e, then what is
@@ -474,10 +476,7 @@ public:
   {
     std::string index = id2string(e.identifier) + e.suffix;
 
-    std::pair<valuest::iterator, bool> r =
-      values.insert(std::pair<irep_idt, entryt>(index, e));
-
-    return r.first->second;
+    return *values.insert(std::pair<const irep_idt, entryt>(index, e)).first;
   }
 
   /** Add a value set for each variable in the given list. */
@@ -654,9 +653,10 @@ public:
   /** Some crazy static analysis tool. */
   unsigned location_number;
   /** Object to assign numbers to objects -- i.e., the numbers in the map of
-   *  a @ref object_mapt. Static and bad. */
-  static object_numberingt object_numbering;
-  static object_number_numberingt obj_numbering_refset;
+   *  a @ref object_mapt. Static and bad; per thread, so that parallel
+   *  symbolic executions don't race on it. */
+  static thread_local object_numberingt object_numbering;
+  static thread_local object_number_numberingt obj_numbering_refset;
 
   /** Storage for all the value sets for all the variables in the program. See
    *  @ref entryt for the format of the string used as an index. */
@@ -9,14 +9,14 @@ def import_module_by_name(module_name):
         module = importlib.import_module(module_name)
         return module
     except ImportError:
-        print(f"Error: Module '{module_name}' not found.")
-        print(f"Please install it with: pip3 install {module_name}")
+        print(f"Error: Module '{module_name}' not found.", file=sys.stderr)
+        print(f"Please install it with: pip3 install {module_name}", file=sys.stderr)
         sys.exit(1)
 
 
 def check_usage():
-    if len(sys.argv) != 3:
-        print("Usage: python astgen.py <file path> <output directory>")
+    if len(sys.argv) not in (2, 3):
+        print("Usage: python astgen.py <file path> [output directory]", file=sys.stderr)
         sys.exit(2)
 
 
@@ -25,10 +25,6 @@ def main():
 
     check_usage()
     filename = sys.argv[1]
-    output_dir = sys.argv[2]
-
-    if not os.path.exists(output_dir):
-        os.makedirs(output_dir)
 
     with open(filename, "r") as source:
         tree = ast.parse(source.read())
@@ -38,6 +34,15 @@ def main():
     # Add the filename to the JSON as ast2json does not include it automatically.
     ast_json["filename"] = filename
 
+    # Without an output directory, the JSON goes to stdout
+    if len(sys.argv) == 2:
+        json.dump(ast_json, sys.stdout)
+        return
+
+    output_dir = sys.argv[2]
+    if not os.path.exists(output_dir):
+        os.makedirs(output_dir)
+
     json_filename = os.path.join(output_dir, "ast.json")
 
     with open(json_filename, "w") as json_file:
@@ -2,11 +2,10 @@
 #include <python-frontend/python_converter.h>
 #include <python-frontend/python_annotation.h>
 #include <util/message.h>
-#include <util/filesystem.h>
 #include <util/c_expr2string.h>
 
 #include <cstdlib>
-#include <fstream>
+#include <iterator>
 
 #include <boost/filesystem.hpp>
 #include <boost/process.hpp>
@@ -20,22 +19,17 @@ extern "C"
 #undef ESBMC_FLAIL
 }
 
-static const std::string &dump_python_script()
+static const std::string &python_script()
 {
-  // Dump astgen.py into a temporary directory
-  static bool dumped = false;
-  static auto p =
-    file_operations::create_tmp_dir("esbmc-python-astgen-%%%%-%%%%-%%%%");
-  if (!dumped)
-  {
-    dumped = true;
-#define ESBMC_FLAIL(body, size, ...)                                           \
-  std::ofstream(p.path() + "/" #__VA_ARGS__).write(body, size);
-
+  // astgen.py is run with 'python3 -c', so it never needs to be on disk
+  static const std::string script = [] {
+    std::string s;
+#define ESBMC_FLAIL(body, size, ...) s.append(body, size);
 #include <pythonastgen.h>
 #undef ESBMC_FLAIL
-  }
-  return p.path();
+    return s;
+  }();
+  return script;
 }
 
 languaget *new_python_language()
@@ -51,16 +45,16 @@ bool python_languaget::parse(const std::string &path)
   if (!fs::exists(script))
     return true;
 
-  ast_output_dir = dump_python_script();
-  const std::string python_script_path = ast_output_dir + "/astgen.py";
-
-  // Execute python script to generate json file from AST
-  std::vector<std::string> args = {python_script_path, path, ast_output_dir};
+  // Execute python script to generate the AST as json on its stdout
+  std::vector<std::string> args = {"-c", python_script(), path};
+  bp::ipstream out;
 
   // Create a child process to execute Python
-  bp::child process(bp::search_path("python3"), args);
+  bp::child process(bp::search_path("python3"), args, bp::std_out > out);
 
-  // Wait for execution
+  // Read everything before waiting, the pipe may be smaller than the AST
+  std::string ast_json(
+    (std::istreambuf_iterator<char>(out)), std::istreambuf_iterator<char>());
   process.wait();
 
   if (process.exit_code())
@@ -70,7 +64,6 @@ bool python_languaget::parse(const std::string &path)
   }
 
   // Parse and generate AST
-  std::ifstream ast_json(ast_output_dir + "/ast.json");
   ast = nlohmann::json::parse(ast_json);
 
   // Add annotation
@@ -40,7 +40,6 @@ public:
   }
 
 private:
-  std::string ast_output_dir;
   nlohmann::json ast;
 };
 
@@ -12,7 +12,6 @@ CC_DIAGNOSTIC_POP()
 #include <clang-cpp-frontend/clang_cpp_adjust.h>
 #include <clang-c-frontend/clang_c_convert.h>
 #include <c2goto/cprover_library.h>
-#include <util/c_link.h>
 
 languaget *new_solidity_language()
 {
@@ -98,9 +97,8 @@ bool solidity_languaget::convert_intrinsics(contextt &context)
   return false;
 }
 
-bool solidity_languaget::typecheck(contextt &context, const std::string &module)
+bool solidity_languaget::convert(contextt &new_context)
 {
-  contextt new_context;
   convert_intrinsics(
     new_context); // Add ESBMC and TACAS intrinsic symbols to the context
   log_progress("Done conversion of intrinsics...");
@@ -118,12 +116,6 @@ bool solidity_languaget::typecheck(contextt &context, const std::string &module)
   if (adjuster.adjust())
     return true;
 
-  if (c_link(
-        context,
-        new_context,
-        module)) // also populates language_uit::context
-    return true;
-
   return false;
 }
 
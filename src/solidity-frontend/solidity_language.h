@@ -15,7 +15,7 @@ public:
 
   bool final(contextt &context) override;
 
-  bool typecheck(contextt &context, const std::string &module) override;
+  bool convert(contextt &new_context) override;
 
   std::string id() const override
   {
@@ -30,6 +30,12 @@ bitwuzla_convt::bitwuzla_convt(const namespacet &ns, const optionst &options)
   bitwuzla_set_option(bitw_options, BITWUZLA_OPT_PRODUCE_MODELS, 1);
   bitwuzla_set_abort_callback(bitwuzla_error_handler);
   bitw = bitwuzla_new(bitw_options);
+  bitwuzla_set_termination_callback(
+    bitw,
+    [](void *flag) -> int32_t {
+      return *static_cast<std::atomic_bool *>(flag);
+    },
+    &interrupted);
 }
 
 bitwuzla_convt::~bitwuzla_convt()
@@ -54,6 +60,7 @@ void bitwuzla_convt::pop_ctx()
 
 smt_convt::resultt bitwuzla_convt::dec_solve()
 {
+  interrupted = false;
   pre_solve();
 
   BitwuzlaResult result = bitwuzla_check_sat(bitw);
@@ -67,6 +74,11 @@ smt_convt::resultt bitwuzla_convt::dec_solve()
   return P_ERROR;
 }
 
+void bitwuzla_convt::interrupt()
+{
+  interrupted = true;
+}
+
 const std::string bitwuzla_convt::solver_text()
 {
   std::string ss = "Bitwuzla ";
@@ -1,6 +1,7 @@
 #ifndef _ESBMC_SOLVERS_BITWUZLA_BITWUZLA_CONV_H_
 #define _ESBMC_SOLVERS_BITWUZLA_BITWUZLA_CONV_H_
 
+#include <atomic>
 #include <cstdio>
 #include <solvers/smt/smt_conv.h>
 #include <irep2/irep2.h>
@@ -29,6 +30,7 @@ public:
   void push_ctx() override;
   void pop_ctx() override;
   resultt dec_solve() override;
+  void interrupt() override;
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
@@ -106,6 +108,8 @@ public:
 
   // Members
   Bitwuzla *bitw;
+  /** Polled by bitwuzla while solving, set by interrupt() */
+  std::atomic_bool interrupted = false;
   BitwuzlaOptions *bitw_options;
 
   typedef std::unordered_map<std::string, smt_astt> symtable_type;
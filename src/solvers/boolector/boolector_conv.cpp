@@ -35,9 +35,18 @@ boolector_convt::boolector_convt(const namespacet &ns, const optionst &options)
   btor = boolector_new();
   boolector_set_opt(btor, BTOR_OPT_MODEL_GEN, 1);
   boolector_set_opt(btor, BTOR_OPT_AUTO_CLEANUP, 1);
-  if (options.get_bool_option("smt-during-symex"))
+  if (
+    options.get_bool_option("smt-during-symex") ||
+    options.get_bool_option("multi-property-incremental") ||
+    options.get_bool_option("reuse-solver"))
     boolector_set_opt(btor, BTOR_OPT_INCREMENTAL, 1);
   boolector_set_abort(error_handler);
+  boolector_set_term(
+    btor,
+    [](void *flag) -> int32_t {
+      return *static_cast<std::atomic_bool *>(flag);
+    },
+    &interrupted);
 }
 
 boolector_convt::~boolector_convt()
@@ -60,6 +69,7 @@ void boolector_convt::pop_ctx()
 
 smt_convt::resultt boolector_convt::dec_solve()
 {
+  interrupted = false;
   pre_solve();
 
   int result = boolector_sat(btor);
@@ -73,6 +83,11 @@ smt_convt::resultt boolector_convt::dec_solve()
   return P_ERROR;
 }
 
+void boolector_convt::interrupt()
+{
+  interrupted = true;
+}
+
 const std::string boolector_convt::solver_text()
 {
   std::string ss = "Boolector ";
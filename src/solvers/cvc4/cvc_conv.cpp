@@ -28,6 +28,22 @@ cvc_convt::cvc_convt(const namespacet &ns, const optionst &options)
   // Already initialized stuff in the constructor list,
   smt.setOption("produce-models", true);
   smt.setOption("produce-assertions", true);
+  if (
+    options.get_bool_option("multi-property-incremental") ||
+    options.get_bool_option("reuse-solver"))
+    smt.setOption("incremental", true);
+}
+
+void cvc_convt::push_ctx()
+{
+  smt_convt::push_ctx();
+  smt.push();
+}
+
+void cvc_convt::pop_ctx()
+{
+  smt.pop();
+  smt_convt::pop_ctx();
 }
 
 smt_convt::resultt cvc_convt::dec_solve()
@@ -44,6 +60,11 @@ smt_convt::resultt cvc_convt::dec_solve()
   return P_UNSATISFIABLE;
 }
 
+void cvc_convt::interrupt()
+{
+  smt.interrupt();
+}
+
 bool cvc_convt::get_bool(smt_astt a)
 {
   auto const *ca = to_solver_smt_ast<cvc_smt_ast>(a);
@@ -18,7 +18,10 @@ public:
   cvc_convt(const namespacet &ns, const optionst &options);
   ~cvc_convt() override = default;
 
+  void push_ctx() override;
+  void pop_ctx() override;
   smt_convt::resultt dec_solve() override;
+  void interrupt() override;
   const std::string solver_text() override;
 
   bool get_bool(smt_astt a) override;
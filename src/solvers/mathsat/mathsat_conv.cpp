@@ -58,6 +58,12 @@ mathsat_convt::mathsat_convt(const namespacet &ns, const optionst &options)
   cfg = msat_parse_config(mathsat_config);
   msat_set_option(cfg, "model_generation", "true");
   env = msat_create_env(cfg);
+  msat_set_termination_test(
+    env,
+    [](void *flag) -> int {
+      return *static_cast<std::atomic_bool *>(flag);
+    },
+    &interrupted);
 }
 
 mathsat_convt::~mathsat_convt()
@@ -85,6 +91,7 @@ void mathsat_convt::assert_ast(smt_astt a)
 
 smt_convt::resultt mathsat_convt::dec_solve()
 {
+  interrupted = false;
   pre_solve();
 
   msat_result r = msat_solve(env);
@@ -97,6 +104,11 @@ smt_convt::resultt mathsat_convt::dec_solve()
   return smt_convt::P_ERROR;
 }
 
+void mathsat_convt::interrupt()
+{
+  interrupted = true;
+}
+
 bool mathsat_convt::get_bool(smt_astt a)
 {
   const mathsat_smt_ast *mast = to_solver_smt_ast<mathsat_smt_ast>(a);
@@ -1,153 +1,94 @@
-#include <set>
-#include <sstream>
-#include <util/c_types.h>
 #include <minisat_conv.h>
 
 smt_convt *create_new_minisat_solver(
-  bool int_encoding,
-  const namespacet &ns,
   const optionst &options,
+  const namespacet &ns,
   tuple_iface **tuple_api [[maybe_unused]],
   array_iface **array_api [[maybe_unused]],
-  fp_iface **fp_api [[maybe_unused]])
+  fp_convt **fp_api [[maybe_unused]])
 {
-  minisat_convt *conv = new minisat_convt(int_encoding, ns, options);
-  return conv;
+  // Tuples, arrays and floating-point are all left to the flatteners
+  return new minisat_convt(ns, options);
 }
 
-literalt minisat_convt::new_variable()
+literalt minisat_cnft::new_variable()
 {
-  literalt l;
-  Minisat::Var tmp = solver.newVar();
-  l.set(tmp, false);
-  return l;
+  return literalt(solver.newVar(), false);
 }
 
-void minisat_convt::convert(const bvt &bv, Minisat::vec<Lit> &dest)
+void minisat_cnft::convert(const bvt &bv, Minisat::vec<Minisat::Lit> &dest)
+  const
 {
   dest.capacity(bv.size());
 
-  for (unsigned int i = 0; i < bv.size(); i++)
-  {
-    if (!bv[i].is_false())
-      dest.push(Minisat::mkLit(bv[i].var_no(), bv[i].sign()));
-  }
-  return;
+  for (literalt l : bv)
+    dest.push(Minisat::mkLit(l.var_no(), l.sign()));
 }
 
-void minisat_convt::setto(literalt a, bool val)
+void minisat_cnft::lcnf(const bvt &bv)
 {
-  bvt b;
-  if (val)
-    b.push_back(a);
-  else
-    b.push_back(cnf_convt::lnot(a));
-
-  Minisat::vec<Lit> l;
-  convert(b, l);
-  solver.addClause_(l);
-  return;
-}
-
-void minisat_convt::lcnf(const bvt &bv)
-{
-  bvt new_bv;
-
-  if (process_clause(bv, new_bv))
-    return;
-
-  if (new_bv.empty())
-    return;
-
-  Minisat::vec<Lit> c;
+  Minisat::vec<Minisat::Lit> c;
   convert(bv, c);
   solver.addClause_(c);
-  return;
-}
-
-minisat_convt::minisat_convt(
-  bool int_encoding,
-  const namespacet &_ns,
-  const optionst &_opts)
-  : cnf_iface(),
-    cnf_convt(static_cast<cnf_iface *>(this)),
-    bitblast_convt(int_encoding, _ns, static_cast<sat_iface *>(this)),
-    solver(),
-    options(_opts),
-    false_asserted(false)
-{
+  n_clauses++;
 }
 
-minisat_convt::~minisat_convt(void)
+tvt minisat_cnft::solve(const bvt &assumptions)
 {
+  Minisat::vec<Minisat::Lit> assumps;
+  convert(assumptions, assumps);
+
+  Minisat::lbool res = solver.solveLimited(assumps);
+  if (res == l_True)
+    return tvt(true);
+  if (res == l_False)
+    return tvt(false);
+  return tvt(tvt::TV_UNKNOWN);
 }
 
-smt_convt::resultt minisat_convt::dec_solve()
+tvt minisat_cnft::l_get(literalt a)
 {
-  pre_solve();
-
-  if (false_asserted)
-    // Then the formula can never be satisfied.
-    return smt_convt::P_UNSATISFIABLE;
+  // Variables made since the last solve aren't in the model
+  if (a.var_no() >= (unsigned)solver.model.size())
+    return tvt(tvt::TV_UNKNOWN);
 
-  bool res = solver.solve();
-  if (res)
-    return smt_convt::P_SATISFIABLE;
-  else
-    return smt_convt::P_UNSATISFIABLE;
+  Minisat::lbool val = solver.modelValue(Minisat::mkLit(a.var_no(), a.sign()));
+  if (val == l_True)
+    return tvt(true);
+  if (val == l_False)
+    return tvt(false);
+  return tvt(tvt::TV_UNKNOWN);
 }
 
-void minisat_convt::dump_bv(const bvt &bv) const
+minisat_convt::minisat_convt(const namespacet &ns, const optionst &options)
+  : bitblast_convt(ns, options, &aig), aig(&cnf)
 {
-  for (unsigned int i = 0; i < bv.size(); i++)
-  {
-    if (bv[i] == const_literal(false))
-      std::cerr << "0";
-    else if (bv[i] == const_literal(true))
-      std::cerr << "1";
-    else
-      std::cerr << "?";
-  }
-
-  std::cerr << " " << bv.size() << "\n";
-  return;
 }
 
-const std::string minisat_convt::solver_text()
+smt_convt::resultt minisat_convt::dec_solve()
 {
-  return "MiniSAT";
+  // An interrupt only ever stops the solve it was meant for
+  cnf.solver.clearInterrupt();
+  resultt res = bitblast_convt::dec_solve();
+
+  log_debug(
+    "minisat",
+    "AIG of {} nodes, {} ANDs shared by structural hashing; {} vars, {} "
+    "clauses",
+    aig.graph().size(),
+    aig.graph().shared_ands(),
+    cnf.solver.nVars(),
+    cnf.n_clauses);
+
+  return res;
 }
 
-tvt minisat_convt::l_get(const literalt &l)
+void minisat_convt::interrupt()
 {
-  if (l == const_literal(true))
-    return tvt(tvt::TV_TRUE);
-  else if (l == const_literal(false))
-    return tvt(tvt::TV_FALSE);
-
-  Minisat::lbool val = solver.modelValue(Minisat::mkLit(l.var_no(), l.sign()));
-  int v = Minisat::toInt(val);
-  if (v == 0)
-    return tvt(tvt::TV_TRUE);
-  else if (v == 1)
-    return tvt(tvt::TV_FALSE);
-  else
-    return tvt(tvt::TV_UNKNOWN);
+  cnf.solver.interrupt();
 }
 
-void minisat_convt::assert_lit(const literalt &l)
+const std::string minisat_convt::solver_text()
 {
-  if (l.is_true())
-    return;
-
-  if (l.is_false())
-  {
-    false_asserted = true;
-    return;
-  }
-
-  Minisat::vec<Lit> c;
-  c.push(Minisat::mkLit(l.var_no(), l.sign()));
-  solver.addClause_(c);
-  return;
+  return "MiniSAT";
 }
@@ -1,57 +1,44 @@
-#ifndef _ESBMC_SOLVERS_SMTLIB_CONV_H_
-#define _ESBMC_SOLVERS_SMTLIB_CONV_H_
-
-// For the sake of...
-#define __STDC_LIMIT_MACROS
-#define __STDC_FORMAT_MACROS
-
-#include <limits.h>
-#include <stdint.h>
-#include <inttypes.h>
-#include <solvers/smt/smt_conv.h>
-#include <solvers/smt/smt_tuple_flat.h>
-#include <solvers/smt/array_conv.h>
-#include <solvers/sat/bitblast_conv.h>
-#include <solvers/sat/cnf_conv.h>
-#include <core/Solver.h>
+#ifndef _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
+#define _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
 
-typedef Minisat::Lit Lit;
-typedef Minisat::lbool lbool;
-typedef std::vector<literalt> bvt;
+#include <solvers/sat/aig_conv.h>
+#include <solvers/sat/bitblast_conv.h>
+#include <solvers/sat/cnf_iface.h>
+#include <minisat/core/Solver.h>
 
-class minisat_convt : public cnf_iface, public cnf_convt, public bitblast_convt
+/** MiniSat, at the bottom of the bitblasting pipeline */
+class minisat_cnft : public cnf_iface
 {
 public:
-  typedef enum
-  {
-    LEFT,
-    LRIGHT,
-    ARIGHT
-  } shiftt;
-
-  minisat_convt(bool int_encoding, const namespacet &_ns, const optionst &opts);
-  ~minisat_convt();
+  literalt new_variable() override;
+  void lcnf(const bvt &bv) override;
+  tvt solve(const bvt &assumptions) override;
+  tvt l_get(literalt a) override;
 
-  // Things definitely to be done by the solver:
-  virtual resultt dec_solve();
-  virtual const std::string solver_text();
-  virtual tvt l_get(const literalt &a);
-  virtual literalt new_variable();
-  virtual void assert_lit(const literalt &l);
-  virtual void lcnf(const bvt &bv);
+  void convert(const bvt &bv, Minisat::vec<Minisat::Lit> &dest) const;
 
-  virtual void setto(literalt a, bool val);
-
-  // Internal gunk
+  Minisat::Solver solver;
+  uint64_t n_clauses = 0;
+};
 
-  void convert(const bvt &bv, Minisat::vec<Lit> &dest);
-  void dump_bv(const bvt &bv) const;
+/**
+ * The native SAT backend: bit-vector operations are blasted into an
+ * And-Inverter Graph, which is turned into CNF for MiniSat as it gets
+ * asserted. MiniSat stays alive across dec_solve() calls, and solver contexts
+ * are assumptions, so it solves incrementally.
+ */
+class minisat_convt : public bitblast_convt
+{
+public:
+  minisat_convt(const namespacet &ns, const optionst &options);
+  ~minisat_convt() override = default;
 
-  // Members
+  resultt dec_solve() override;
+  void interrupt() override;
+  const std::string solver_text() override;
 
-  Minisat::Solver solver;
-  const optionst &options;
-  bool false_asserted;
+  minisat_cnft cnf;
+  aig_convt aig;
 };
 
-#endif /* _ESBMC_SOLVERS_SMTLIB_CONV_H_ */
+#endif /* _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_ */
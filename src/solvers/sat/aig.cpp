@@ -0,0 +1,108 @@
+#include <solvers/sat/aig.h>
+#include <cassert>
+#include <utility>
+
+literalt aigt::new_input()
+{
+  nodet n;
+  n.a = const_literal(false);
+  n.b = const_literal(false);
+  nodes.push_back(n);
+  return literalt(nodes.size() - 1, false);
+}
+
+literalt aigt::mk_and(literalt a, literalt b)
+{
+  // Constant propagation and the one-level rules
+  if (a.is_false() || b.is_false())
+    return const_literal(false);
+  if (a.is_true())
+    return b;
+  if (b.is_true())
+    return a;
+  if (a == b)
+    return a;
+  if (a == neg(b))
+    return const_literal(false);
+
+  // Two-level rules, where one operand is itself an AND. Try both ways round.
+  for (unsigned i = 0; i < 2; i++, std::swap(a, b))
+  {
+    const nodet &n = nodes[a.var_no()];
+    if (n.is_input())
+      continue;
+
+    if (!a.sign())
+    {
+      // (x & y) & x == x & y, and (x & y) & !x == false
+      if (b == n.a || b == n.b)
+        return a;
+      if (b == neg(n.a) || b == neg(n.b))
+        return const_literal(false);
+    }
+    else
+    {
+      // !(x & y) & !x == !x, and !(x & y) & x == !y & x
+      if (b == neg(n.a) || b == neg(n.b))
+        return b;
+      if (b == n.a)
+        return mk_and(neg(n.b), b);
+      if (b == n.b)
+        return mk_and(neg(n.a), b);
+    }
+  }
+
+  // Operands are ordered, so that a & b and b & a hash the same
+  if (b < a)
+    std::swap(a, b);
+
+  uint64_t key = (uint64_t(a.get()) << 32) | b.get();
+  auto it = ands.find(key);
+  if (it != ands.end())
+  {
+    hits++;
+    return literalt(it->second, false);
+  }
+
+  nodet n;
+  n.a = a;
+  n.b = b;
+  nodes.push_back(n);
+  unsigned idx = nodes.size() - 1;
+  ands.emplace(key, idx);
+  return literalt(idx, false);
+}
+
+literalt aigt::mk_xor(literalt a, literalt b)
+{
+  if (a.is_constant())
+    return b.cond_negation(a.is_true());
+  if (b.is_constant())
+    return a.cond_negation(b.is_true());
+
+  // Pull the inversions out, so that all four sign combinations of a pair of
+  // nodes share one xor circuit
+  bool inv = a.sign() != b.sign();
+  a = literalt(a.var_no(), false);
+  b = literalt(b.var_no(), false);
+
+  literalt both = mk_and(a, b);
+  literalt neither = mk_and(neg(a), neg(b));
+  return mk_and(neg(both), neg(neither)).cond_negation(inv);
+}
+
+literalt aigt::mk_ite(literalt c, literalt t, literalt f)
+{
+  if (c.is_constant())
+    return c.is_true() ? t : f;
+  if (t == f)
+    return t;
+  if (t == neg(f))
+    return mk_eq(c, t);
+  if (t.is_constant())
+    return t.is_true() ? mk_or(c, f) : mk_and(neg(c), f);
+  if (f.is_constant())
+    return f.is_true() ? mk_or(neg(c), t) : mk_and(c, t);
+
+  return mk_or(mk_and(c, t), mk_and(neg(c), f));
+}
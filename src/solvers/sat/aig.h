@@ -0,0 +1,83 @@
+#ifndef _ESBMC_SOLVERS_SAT_AIG_H_
+#define _ESBMC_SOLVERS_SAT_AIG_H_
+
+#include <solvers/prop/literal.h>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * And-Inverter Graph: the bit-blaster builds every gate out of two-input ANDs
+ * and inverted edges, stored here.
+ *
+ * A literal names a node by its var_no() and an inversion by its sign(); the
+ * constants are const_literal(). A node is either an input or the AND of two
+ * literals, and is only ever created after its operands, so node indices are
+ * a topological order of the graph.
+ *
+ * mk_and() folds constants and trivial cases, and is structurally hashed:
+ * asking twice for the same AND returns the same node, so sub-circuits that
+ * the bit-blaster builds repeatedly (e.g. the same comparison from several
+ * assertions) are only ever encoded once.
+ */
+class aigt
+{
+public:
+  struct nodet
+  {
+    // Both constant for inputs; an AND node never has constant operands
+    literalt a, b;
+
+    bool is_input() const
+    {
+      return a.is_constant();
+    }
+  };
+
+  literalt new_input();
+
+  literalt mk_and(literalt a, literalt b);
+
+  literalt mk_or(literalt a, literalt b)
+  {
+    return neg(mk_and(neg(a), neg(b)));
+  }
+
+  literalt mk_xor(literalt a, literalt b);
+
+  literalt mk_eq(literalt a, literalt b)
+  {
+    return neg(mk_xor(a, b));
+  }
+
+  literalt mk_implies(literalt a, literalt b)
+  {
+    return mk_or(neg(a), b);
+  }
+
+  literalt mk_ite(literalt c, literalt t, literalt f);
+
+  const nodet &node(unsigned n) const
+  {
+    return nodes[n];
+  }
+
+  unsigned size() const
+  {
+    return nodes.size();
+  }
+
+  /** Number of requests answered by the structural hash rather than by a new
+   *  node */
+  uint64_t shared_ands() const
+  {
+    return hits;
+  }
+
+private:
+  std::vector<nodet> nodes;
+  std::unordered_map<uint64_t, unsigned> ands;
+  uint64_t hits = 0;
+};
+
+#endif /* _ESBMC_SOLVERS_SAT_AIG_H_ */
@@ -0,0 +1,181 @@
+#include <solvers/sat/aig_conv.h>
+#include <cassert>
+#include <utility>
+
+aig_convt::aig_convt(cnf_iface *_cnf_api) : cnf_api(_cnf_api)
+{
+}
+
+literalt aig_convt::lnot(literalt a)
+{
+  return neg(a);
+}
+
+literalt aig_convt::lselect(literalt a, literalt b, literalt c)
+{
+  return aig.mk_ite(a, b, c);
+}
+
+literalt aig_convt::lequal(literalt a, literalt b)
+{
+  return aig.mk_eq(a, b);
+}
+
+literalt aig_convt::limplies(literalt a, literalt b)
+{
+  return aig.mk_implies(a, b);
+}
+
+literalt aig_convt::lxor(literalt a, literalt b)
+{
+  return aig.mk_xor(a, b);
+}
+
+literalt aig_convt::land(literalt a, literalt b)
+{
+  return aig.mk_and(a, b);
+}
+
+literalt aig_convt::lor(literalt a, literalt b)
+{
+  return aig.mk_or(a, b);
+}
+
+literalt aig_convt::new_variable()
+{
+  return aig.new_input();
+}
+
+literalt aig_convt::cnf_lit(literalt a)
+{
+  unsigned n = a.var_no();
+  if (var_map.size() <= n)
+  {
+    var_map.resize(aig.size(), unmapped);
+    encoded.resize(aig.size(), 0);
+  }
+
+  if (var_map[n] == unmapped)
+    var_map[n] = cnf_api->new_variable().var_no();
+
+  return literalt(var_map[n], a.sign());
+}
+
+literalt aig_convt::encode(literalt a)
+{
+  assert(!a.is_constant());
+  literalt result = cnf_lit(a);
+
+  // Nodes still to encode, with the polarity they are needed in
+  std::vector<std::pair<unsigned, uint8_t>> todo;
+  todo.emplace_back(a.var_no(), a.sign() ? NEG : POS);
+
+  bvt clause;
+  while (!todo.empty())
+  {
+    auto [n, pol] = todo.back();
+    todo.pop_back();
+
+    const aigt::nodet &node = aig.node(n);
+    if (node.is_input() || (encoded[n] & pol))
+      continue;
+    encoded[n] |= pol;
+
+    literalt o = cnf_lit(literalt(n, false));
+    literalt x = cnf_lit(node.a);
+    literalt y = cnf_lit(node.b);
+
+    if (pol == POS)
+    {
+      // o -> x & y
+      clause = {neg(o), x};
+      cnf_api->lcnf(clause);
+      clause = {neg(o), y};
+      cnf_api->lcnf(clause);
+
+      // ... so the operands are needed in the polarity they appear in
+      todo.emplace_back(node.a.var_no(), node.a.sign() ? NEG : POS);
+      todo.emplace_back(node.b.var_no(), node.b.sign() ? NEG : POS);
+    }
+    else
+    {
+      // x & y -> o
+      clause = {o, neg(x), neg(y)};
+      cnf_api->lcnf(clause);
+
+      todo.emplace_back(node.a.var_no(), node.a.sign() ? POS : NEG);
+      todo.emplace_back(node.b.var_no(), node.b.sign() ? POS : NEG);
+    }
+  }
+
+  return result;
+}
+
+void aig_convt::assert_lit(literalt a)
+{
+  if (a.is_true())
+    return;
+
+  bvt clause;
+  if (!a.is_false())
+    clause.push_back(encode(a));
+
+  // An asserted false is the empty clause, which is unsatisfiable for good
+  cnf_api->lcnf(clause);
+}
+
+tvt aig_convt::solve(const bvt &assumptions)
+{
+  has_model = false;
+  n_evaluated = 0;
+
+  bvt lits;
+  lits.reserve(assumptions.size());
+  for (literalt a : assumptions)
+  {
+    if (a.is_false())
+      return tvt(false);
+    if (!a.is_true())
+      lits.push_back(encode(a));
+  }
+
+  tvt res = cnf_api->solve(lits);
+  has_model = res.is_true();
+  return res;
+}
+
+bool aig_convt::eval(literalt a)
+{
+  if (a.is_constant())
+    return a.is_true();
+
+  // Nodes are in topological order, so evaluate all of them up to a's in one
+  // sweep, and keep those for later queries against the same model.
+  unsigned n = a.var_no();
+  if (n >= n_evaluated)
+  {
+    values.resize(aig.size());
+    for (unsigned i = n_evaluated; i <= n; i++)
+    {
+      const aigt::nodet &node = aig.node(i);
+      if (node.is_input())
+        // Inputs the solver never saw are unconstrained; pick false
+        values[i] = i < var_map.size() && var_map[i] != unmapped &&
+                    cnf_api->l_get(literalt(var_map[i], false)).is_true();
+      else
+        values[i] = (values[node.a.var_no()] != node.a.sign()) &&
+                    (values[node.b.var_no()] != node.b.sign());
+    }
+    n_evaluated = n + 1;
+  }
+
+  return values[n] != a.sign();
+}
+
+tvt aig_convt::l_get(literalt a)
+{
+  if (!has_model)
+    return tvt(tvt::TV_UNKNOWN);
+
+  return tvt(eval(a));
+}
@@ -0,0 +1,71 @@
+#ifndef _ESBMC_SOLVERS_SAT_AIG_CONV_H_
+#define _ESBMC_SOLVERS_SAT_AIG_CONV_H_
+
+#include <solvers/sat/aig.h>
+#include <solvers/sat/cnf_iface.h>
+#include <solvers/sat/sat_iface.h>
+
+/**
+ * The SAT api the bitblaster works against, building an And-Inverter Graph
+ * and handing clauses to a cnf_iface only for what gets asserted.
+ *
+ * Clauses are generated with polarity-aware Tseitin encoding: a node whose
+ * value is only ever needed to be true (say) gets just the clauses forcing
+ * its operands when it is true. Each node remembers the polarities it has
+ * been encoded in, so asserting more of the graph later only adds the
+ * clauses that are still missing, and solver variables are only made for
+ * nodes that are encoded at all.
+ *
+ * As the encoding of a node may be one-sided, solver values of gates can't be
+ * trusted: l_get() reads the values of the inputs and evaluates the graph.
+ */
+class aig_convt : public sat_iface
+{
+public:
+  aig_convt(cnf_iface *cnf_api);
+
+  literalt lnot(literalt a) override;
+  literalt lselect(literalt a, literalt b, literalt c) override;
+  literalt lequal(literalt a, literalt b) override;
+  literalt limplies(literalt a, literalt b) override;
+  literalt lxor(literalt a, literalt b) override;
+  literalt land(literalt a, literalt b) override;
+  literalt lor(literalt a, literalt b) override;
+  literalt new_variable() override;
+  void assert_lit(literalt a) override;
+  tvt solve(const bvt &assumptions) override;
+  tvt l_get(literalt a) override;
+
+  const aigt &graph() const
+  {
+    return aig;
+  }
+
+  cnf_iface *cnf_api;
+
+protected:
+  enum
+  {
+    POS = 1,
+    NEG = 2
+  };
+
+  /** Encode the cone of a so that the solver literal returned implies a. */
+  literalt encode(literalt a);
+  /** Solver literal of an AIG literal, making a variable if need be */
+  literalt cnf_lit(literalt a);
+  bool eval(literalt a);
+
+  aigt aig;
+  // Per node: solver variable, or unmapped, and polarities encoded so far
+  std::vector<unsigned> var_map;
+  std::vector<uint8_t> encoded;
+  static constexpr unsigned unmapped = ~0u;
+
+  // Values of the model, evaluated for the first n_evaluated nodes
+  bool has_model = false;
+  std::vector<bool> values;
+  unsigned n_evaluated = 0;
+};
+
+#endif /* _ESBMC_SOLVERS_SAT_AIG_CONV_H_ */
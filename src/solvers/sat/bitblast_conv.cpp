@@ -1,539 +1,424 @@
-#include <set>
-#include <bitblast_conv.h>
+#include <solvers/sat/bitblast_conv.h>
+
+#define new_ast new_solver_ast<bitblast_smt_ast>
 
 bitblast_convt::bitblast_convt(
-  bool int_encoding,
   const namespacet &_ns,
+  const optionst &options,
   sat_iface *_sat_api)
-  : smt_convt(int_encoding, _ns), sat_api(_sat_api)
+  : smt_convt(_ns, options), sat_api(_sat_api)
+{
+  if (options.get_bool_option("int-encoding"))
+  {
+    log_error("The bitblaster does not support integer encoding mode");
+    abort();
+  }
+}
+
+void bitblast_convt::push_ctx()
 {
+  smt_convt::push_ctx();
+  ctx_activations.push_back(sat_api->new_variable());
 }
 
-bitblast_convt::~bitblast_convt()
+void bitblast_convt::pop_ctx()
 {
+  // Everything asserted in this context is guarded by its activation literal;
+  // switching that off for good retracts all of it.
+  sat_api->assert_lit(sat_api->lnot(ctx_activations.back()));
+  ctx_activations.pop_back();
+  smt_convt::pop_ctx();
+}
+
+smt_convt::resultt bitblast_convt::dec_solve()
+{
+  pre_solve();
+
+  tvt res = sat_api->solve(ctx_activations);
+  if (res.is_true())
+    return P_SATISFIABLE;
+  if (res.is_false())
+    return P_UNSATISFIABLE;
+  return P_ERROR;
 }
 
 void bitblast_convt::assert_ast(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_BOOL);
-  const bitblast_smt_ast *ba = bitblast_ast_downcast(a);
-  sat_api->assert_lit(ba->bv[0]);
-  return;
+  literalt l = bits(a)[0];
+  if (!ctx_activations.empty())
+    l = sat_api->limplies(ctx_activations.back(), l);
+  sat_api->assert_lit(l);
 }
 
-smt_astt bitblast_convt::mk_func_app(
-  smt_sortt ressort,
-  smt_func_kind f,
-  const smt_ast *const *_args,
-  unsigned int numargs)
+smt_astt bitblast_convt::mk_bvadd(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *args[4];
-  bitblast_smt_ast *result = NULL;
-  unsigned int i;
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res;
+  literalt carry_out;
+  full_adder(bits(a), bits(b), res, const_literal(false), carry_out);
+  return new_ast(res, a->sort);
+}
 
-  assert(numargs < 4 && "Too many arguments to bitblast_convt::mk_func_app");
-  for (i = 0; i < numargs; i++)
-    args[i] = bitblast_ast_downcast(_args[i]);
+smt_astt bitblast_convt::mk_bvsub(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt op1 = bits(b);
+  invert(op1);
+  bvt res;
+  literalt carry_out;
+  full_adder(bits(a), op1, res, const_literal(true), carry_out);
+  return new_ast(res, a->sort);
+}
 
-  switch (f)
-  {
-  case SMT_FUNC_EQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    break;
-  }
-  case SMT_FUNC_NOTEQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    result->bv[0] = sat_api->lnot(result->bv[0]);
-    break;
-  }
-  case SMT_FUNC_NOT:
-  {
-    literalt res = sat_api->lnot(args[0]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_OR:
-  {
-    literalt res = sat_api->lor(args[0]->bv[0], args[1]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_IMPLIES:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->limplies(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_ITE:
-  {
-    if (ressort->id == SMT_SORT_ARRAY)
-    {
-      return _args[1]->ite(this, _args[0], _args[2]);
-    }
-    else
-    {
-      assert(args[1]->bv.size() == args[2]->bv.size());
-      result = new_ast(ressort);
-      for (unsigned int i = 0; i < args[1]->bv.size(); i++)
-        result->bv.push_back(
-          sat_api->lselect(args[0]->bv[0], args[1]->bv[i], args[2]->bv[i]));
-    }
-    break;
-  }
-  case SMT_FUNC_AND:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->land(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_XOR:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->lxor(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_BVADD:
-  {
-    literalt carry_in = const_literal(false);
-    literalt carry_out;
-    result = new_ast(ressort);
-    full_adder(args[0]->bv, args[1]->bv, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVSUB:
-  {
-    literalt carry_in = const_literal(true);
-    literalt carry_out;
-    result = new_ast(ressort);
-    bvt op1 = args[1]->bv;
-    invert(op1);
-    full_adder(args[0]->bv, op1, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVUGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVULT, args2, 2);
-  }
-  case SMT_FUNC_BVUGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVULT, _args, 2);
-    a = mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-    return a;
-  }
-  case SMT_FUNC_BVULT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(unsigned_less_than(args[0]->bv, args[1]->bv));
-    break;
-  }
-  case SMT_FUNC_BVULTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, false));
-    break;
-  }
-  case SMT_FUNC_BVSGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVSLT, _args, 2);
-    return mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-  }
-  case SMT_FUNC_BVSLTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVSGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVSLT, args2, 2);
-  }
-  case SMT_FUNC_BVSLT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(false, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVMUL:
-  {
-    result = new_ast(ressort);
-    const bitblast_smt_sort *sort0 = bitblast_sort_downcast(args[0]->sort);
-    const bitblast_smt_sort *sort1 = bitblast_sort_downcast(args[1]->sort);
-    if (sort0->sign || sort1->sign)
-    {
-      signed_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    else
-    {
-      unsigned_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    break;
-  }
-  case SMT_FUNC_CONCAT:
-  {
-    result = new_ast(ressort);
-    result->bv.insert(
-      result->bv.begin(), args[0]->bv.begin(), args[0]->bv.end());
-    result->bv.insert(
-      result->bv.begin(), args[1]->bv.begin(), args[1]->bv.end());
-    break;
-  }
-  case SMT_FUNC_BVAND:
-  {
-    result = new_ast(ressort);
-    bvand(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVXOR:
-  {
-    result = new_ast(ressort);
-    bvxor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVOR:
-  {
-    result = new_ast(ressort);
-    bvor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNOT:
-  {
-    result = new_ast(ressort);
-    bvnot(args[0]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVASHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::ARIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVLSHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LRIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSHL:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LEFT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVUDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVSMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVUMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNEG:
-  {
-    result = new_ast(ressort);
-    negate(args[0]->bv, result->bv);
-    break;
-  }
-  default:
-    log_error(
-      "Unimplemented SMT function \"{}\" in bitblast convt",
-      smt_func_name_table[f]);
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvmul(smt_astt a, smt_astt b)
+{
+  // The low half of a product is the same whether signed or not
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res;
+  unsigned_multiplier(bits(a), bits(b), res);
+  return new_ast(res, a->sort);
+}
 
-  return result;
+smt_astt bitblast_convt::mk_bvsmod(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res, rem;
+  signed_divider(bits(a), bits(b), res, rem);
+  return new_ast(rem, a->sort);
 }
 
-smt_sort *bitblast_convt::mk_sort(smt_sort_kind k, ...)
+smt_astt bitblast_convt::mk_bvumod(smt_astt a, smt_astt b)
 {
-  va_list ap;
-  bitblast_smt_sort *s = NULL, *dom, *range;
-  unsigned long uint;
-  int thebool;
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res, rem;
+  unsigned_divider(bits(a), bits(b), res, rem);
+  return new_ast(rem, a->sort);
+}
 
-  va_start(ap, k);
-  switch (k)
-  {
-  case SMT_SORT_INT:
-    log_error("Can't make Int sorts in bitblaster");
-    abort();
-  case SMT_SORT_REAL:
-    log_error("Can't make Real sorts in bitblaster");
-    abort();
-  case SMT_SORT_BV:
-    uint = va_arg(ap, unsigned long);
-    thebool = va_arg(ap, int);
-    s = new bitblast_smt_sort(k, uint, thebool);
-    break;
-  case SMT_SORT_ARRAY:
-    dom = va_arg(ap, bitblast_smt_sort *); // Consider constness?
-    range = va_arg(ap, bitblast_smt_sort *);
-    s = new bitblast_smt_sort(k, range->data_width, dom->data_width);
-    break;
-  case SMT_SORT_BOOL:
-    s = new bitblast_smt_sort(k);
-    break;
-  default:
-    log_error("Unimplemented SMT sort {} in bitblaster conversion", k);
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvsdiv(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res, rem;
+  signed_divider(bits(a), bits(b), res, rem);
+  return new_ast(res, a->sort);
+}
 
-  return s;
+smt_astt bitblast_convt::mk_bvudiv(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  bvt res, rem;
+  unsigned_divider(bits(a), bits(b), res, rem);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *bitblast_convt::mk_smt_int(const BigInt &intval [[maybe_unused]])
+smt_astt bitblast_convt::mk_bvshl(smt_astt a, smt_astt b)
 {
-  log_error("Can't create integers in bitblast solver");
-  abort();
+  bvt res;
+  barrel_shift(bits(a), LEFT, bits(b), res);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *bitblast_convt::mk_smt_real(const std::string &value [[maybe_unused]])
+smt_astt bitblast_convt::mk_bvashr(smt_astt a, smt_astt b)
 {
-  log_error("Can't create reals in bitblast solver");
-  abort();
+  bvt res;
+  barrel_shift(bits(a), ARIGHT, bits(b), res);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *
-bitblast_convt::mk_smt_bvint(const BigInt &intval, bool sign, unsigned int w)
+smt_astt bitblast_convt::mk_bvlshr(smt_astt a, smt_astt b)
 {
-  smt_sort *s = mk_sort(SMT_SORT_BV, w, sign);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.resize(w);
-  int u = intval.to_int64();
-  for (unsigned int i = 0; i < w; i++)
-  {
-    int mask = (1ULL << i);
-    bool val = u & mask;
-    a->bv[i] = const_literal(val);
-  }
+  bvt res;
+  barrel_shift(bits(a), LRIGHT, bits(b), res);
+  return new_ast(res, a->sort);
+}
 
-  return a;
+smt_astt bitblast_convt::mk_bvneg(smt_astt a)
+{
+  bvt res;
+  negate(bits(a), res);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *bitblast_convt::mk_smt_bool(bool boolval)
+smt_astt bitblast_convt::mk_bvnot(smt_astt a)
 {
-  literalt l = const_literal(boolval);
+  bvt res;
+  bvnot(bits(a), res);
+  return new_ast(res, a->sort);
+}
 
-  smt_sort *s = mk_sort(SMT_SORT_BOOL);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.push_back(l);
-  return a;
+smt_astt bitblast_convt::mk_bvnxor(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvxor(bits(a), bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
 }
 
-smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt sort)
+smt_astt bitblast_convt::mk_bvnor(smt_astt a, smt_astt b)
 {
-  // Otherwise, we need to build this AST ourselves.
-  bitblast_smt_ast *a = new_ast(sort);
-  smt_astt result = a;
-  const bitblast_smt_sort *s = bitblast_sort_downcast(sort);
-  switch (sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt l = sat_api->new_variable();
-    a->bv.push_back(l);
-    break;
-  }
-  case SMT_SORT_BV:
-  {
-    // Bunch of fresh variables
-    for (unsigned int i = 0; i < s->data_width; i++)
-      a->bv.push_back(sat_api->new_variable());
-    break;
-  }
-  default:
-    log_error(
-      "Unimplemented symbol type {} in bitblast symbol creation", sort->id);
-    abort();
-  }
+  bvt res;
+  bvor(bits(a), bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
+}
 
-  return result;
+smt_astt bitblast_convt::mk_bvnand(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvand(bits(a), bits(b), res);
+  invert(res);
+  return new_ast(res, a->sort);
 }
 
-smt_sort *bitblast_convt::mk_struct_sort(const type2tc &t [[maybe_unused]])
+smt_astt bitblast_convt::mk_bvxor(smt_astt a, smt_astt b)
 {
-  abort();
+  bvt res;
+  bvxor(bits(a), bits(b), res);
+  return new_ast(res, a->sort);
 }
 
-smt_ast *bitblast_convt::mk_extract(
-  smt_astt src,
-  unsigned int high,
-  unsigned int low,
-  smt_sortt s)
+smt_astt bitblast_convt::mk_bvor(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(src);
-  bitblast_smt_ast *result = new_ast(s);
-  for (unsigned int i = low; i <= high; i++)
-    result->bv.push_back(mast->bv[i]);
+  bvt res;
+  bvor(bits(a), bits(b), res);
+  return new_ast(res, a->sort);
+}
 
-  return result;
+smt_astt bitblast_convt::mk_bvand(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bvand(bits(a), bits(b), res);
+  return new_ast(res, a->sort);
 }
 
-bitblast_smt_ast *
-bitblast_convt::mk_ast_equality(smt_astt _a, smt_astt _b, smt_sortt ressort)
+smt_astt bitblast_convt::mk_implies(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *a = bitblast_ast_downcast(_a);
-  const bitblast_smt_ast *b = bitblast_ast_downcast(_b);
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast({sat_api->limplies(bits(a)[0], bits(b)[0])}, boolean_sort);
+}
 
-  switch (a->sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt res = sat_api->lequal(a->bv[0], b->bv[0]);
-    bitblast_smt_ast *n = new_ast(a->sort);
-    n->bv.push_back(res);
-    return n;
-  }
-  case SMT_SORT_BV:
-  {
-    bitblast_smt_ast *n = new_ast(ressort);
-    n->bv.push_back(equal(a->bv, b->bv));
-    return n;
-  }
-  case SMT_SORT_ARRAY:
-  {
-    // XXX - so, if we have different array encodings in the future then this
-    // might get quite funky. Leave it until then, though.
-    log_error("No direct array equality support in bitblast converter");
-    abort();
-  }
-  default:
-    log_error("Invalid sort {} for equality in bitblast", a->sort->id);
-    abort();
-  }
+smt_astt bitblast_convt::mk_xor(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast({sat_api->lxor(bits(a)[0], bits(b)[0])}, boolean_sort);
 }
 
-expr2tc bitblast_convt::get_bool(smt_astt a)
+smt_astt bitblast_convt::mk_or(smt_astt a, smt_astt b)
 {
-  tvt t = l_get(a);
-  if (t.is_true())
-    return gen_true_expr();
-  else if (t.is_false())
-    return gen_false_expr();
-  else
-    return expr2tc();
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast({sat_api->lor(bits(a)[0], bits(b)[0])}, boolean_sort);
 }
 
-tvt bitblast_convt::l_get(smt_astt a)
+smt_astt bitblast_convt::mk_and(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  return sat_api->l_get(mast->bv[0]);
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast({sat_api->land(bits(a)[0], bits(b)[0])}, boolean_sort);
 }
 
-expr2tc bitblast_convt::get_bv(const type2tc &t, smt_astt a)
+smt_astt bitblast_convt::mk_not(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  unsigned int sz = t->get_width();
-  assert(sz <= 64 && "Your integers are larger than a uint64_t");
-  assert(mast->bv.size() == sz);
-  uint64_t accuml = 0;
-  for (unsigned int i = 0; i < sz; i++)
-  {
-    uint64_t mask = 1 << i;
-    tvt t = sat_api->l_get(mast->bv[i]);
-    if (t.is_true())
-    {
-      accuml |= mask;
-    }
-    else if (t.is_false())
-    {
-      ; // It's zero
-    }
-    else
-    {
-      ; // It's undefined in this model. So may as well be zero.
-    }
-  }
+  assert(a->sort->id == SMT_SORT_BOOL);
+  return new_ast({sat_api->lnot(bits(a)[0])}, boolean_sort);
+}
 
-  return constant_int2tc(t, BigInt(accuml));
+smt_astt bitblast_convt::mk_bvult(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({lt_or_le(false, bits(a), bits(b), false)}, boolean_sort);
 }
 
-// ******************************  Bitblast foo *******************************
+smt_astt bitblast_convt::mk_bvslt(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({lt_or_le(false, bits(a), bits(b), true)}, boolean_sort);
+}
 
-bool bitblast_convt::process_clause(const bvt &bv, bvt &dest)
+smt_astt bitblast_convt::mk_bvule(smt_astt a, smt_astt b)
 {
-  dest.clear();
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({lt_or_le(true, bits(a), bits(b), false)}, boolean_sort);
+}
 
-  // empty clause! this is UNSAT
-  if (bv.empty())
-    return false;
+smt_astt bitblast_convt::mk_bvsle(smt_astt a, smt_astt b)
+{
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({lt_or_le(true, bits(a), bits(b), true)}, boolean_sort);
+}
 
-  std::set<literalt> s;
+smt_astt bitblast_convt::mk_eq(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id != SMT_SORT_ARRAY);
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({equal(bits(a), bits(b))}, boolean_sort);
+}
 
-  dest.reserve(bv.size());
+smt_astt bitblast_convt::mk_neq(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id != SMT_SORT_ARRAY);
+  assert(a->sort->get_data_width() == b->sort->get_data_width());
+  return new_ast({sat_api->lnot(equal(bits(a), bits(b)))}, boolean_sort);
+}
 
-  for (bvt::const_iterator it = bv.begin(); it != bv.end(); it++)
-  {
-    literalt l = *it;
+smt_sortt bitblast_convt::mk_bool_sort()
+{
+  return new smt_sort(SMT_SORT_BOOL, 1);
+}
 
-    if (l.is_true())
-      return true; // clause satisfied
+smt_sortt bitblast_convt::mk_bv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_BV, width);
+}
 
-    if (l.is_false())
-      continue;
+smt_sortt bitblast_convt::mk_fbv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_FIXEDBV, width);
+}
 
-    // prevent duplicate literals
-    if (s.insert(l).second)
-      dest.push_back(l);
+smt_sortt bitblast_convt::mk_array_sort(smt_sortt domain, smt_sortt range)
+{
+  // Only ever seen by array_convt, which flattens these into bits
+  return new smt_sort(SMT_SORT_ARRAY, domain->get_data_width(), range);
+}
 
-    if (s.find(sat_api->lnot(l)) != s.end())
-      return true; // clause satisfied
-  }
+smt_sortt bitblast_convt::mk_bvfp_sort(std::size_t ew, std::size_t sw)
+{
+  return new smt_sort(SMT_SORT_BVFP, ew + sw + 1, sw + 1);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_rm_sort()
+{
+  return new smt_sort(SMT_SORT_BVFP_RM, 3);
+}
+
+smt_astt bitblast_convt::mk_smt_int(const BigInt &theint [[maybe_unused]])
+{
+  log_error("Can't create integers in bitblast solver");
+  abort();
+}
+
+smt_astt bitblast_convt::mk_smt_real(const std::string &str [[maybe_unused]])
+{
+  log_error("Can't create reals in bitblast solver");
+  abort();
+}
+
+smt_astt bitblast_convt::mk_smt_bv(const BigInt &theint, smt_sortt s)
+{
+  std::size_t w = s->get_data_width();
+  std::string str = integer2binary(theint, w);
+
+  bvt bv(w);
+  for (std::size_t i = 0; i < w; i++)
+    bv[i] = const_literal(str[w - 1 - i] == '1');
 
-  return false;
+  return new_ast(bv, s);
 }
 
-void bitblast_convt::eliminate_duplicates(const bvt &bv, bvt &dest)
+smt_astt bitblast_convt::mk_smt_bool(bool val)
 {
-  std::set<literalt> s;
+  return new_ast({const_literal(val)}, boolean_sort);
+}
 
-  dest.reserve(bv.size());
+smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt s)
+{
+  auto it = symtable.find(name);
+  if (it != symtable.end())
+    return new_ast(it->second, s);
 
-  for (bvt::const_iterator it = bv.begin(); it != bv.end(); it++)
+  bvt bv;
+  switch (s->id)
   {
-    if (s.insert(*it).second)
-      dest.push_back(*it);
+  case SMT_SORT_BOOL:
+  case SMT_SORT_BV:
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_BVFP_RM:
+    // Bunch of fresh variables
+    bv.reserve(s->get_data_width());
+    for (std::size_t i = 0; i < s->get_data_width(); i++)
+      bv.push_back(sat_api->new_variable());
+    break;
+
+  default:
+    log_error("Unimplemented symbol type {} in bitblast symbol creation", s->id);
+    abort();
   }
+
+  symtable.emplace(name, bv);
+  return new_ast(bv, s);
+}
+
+smt_astt
+bitblast_convt::mk_extract(smt_astt a, unsigned int high, unsigned int low)
+{
+  const bvt &src = bits(a);
+  assert(low <= high && high < src.size());
+  bvt bv(src.begin() + low, src.begin() + high + 1);
+  return new_ast(bv, mk_bv_sort(high - low + 1));
 }
 
+smt_astt bitblast_convt::mk_sign_ext(smt_astt a, unsigned int topwidth)
+{
+  bvt bv = bits(a);
+  literalt top = bv.back();
+  bv.insert(bv.end(), topwidth, top);
+  return new_ast(bv, mk_bv_sort(bv.size()));
+}
+
+smt_astt bitblast_convt::mk_zero_ext(smt_astt a, unsigned int topwidth)
+{
+  bvt bv = bits(a);
+  bv.insert(bv.end(), topwidth, const_literal(false));
+  return new_ast(bv, mk_bv_sort(bv.size()));
+}
+
+smt_astt bitblast_convt::mk_concat(smt_astt a, smt_astt b)
+{
+  // a is the top half, and bits are stored least significant first
+  bvt bv = bits(b);
+  bv.insert(bv.end(), bits(a).begin(), bits(a).end());
+  return new_ast(bv, mk_bv_sort(bv.size()));
+}
+
+smt_astt bitblast_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
+{
+  assert(cond->sort->id == SMT_SORT_BOOL);
+  assert(t->sort->get_data_width() == f->sort->get_data_width());
+
+  literalt c = bits(cond)[0];
+  const bvt &tv = bits(t), &fv = bits(f);
+  bvt bv(tv.size());
+  for (std::size_t i = 0; i < tv.size(); i++)
+    bv[i] = sat_api->lselect(c, tv[i], fv[i]);
+
+  return new_ast(bv, t->sort);
+}
+
+tvt bitblast_convt::l_get(smt_astt a)
+{
+  return sat_api->l_get(bits(a)[0]);
+}
+
+bool bitblast_convt::get_bool(smt_astt a)
+{
+  // Bits the model doesn't care about may as well be false
+  return l_get(a).is_true();
+}
+
+BigInt bitblast_convt::get_bv(smt_astt a, bool is_signed)
+{
+  const bvt &bv = bits(a);
+  std::string str(bv.size(), '0');
+  for (std::size_t i = 0; i < bv.size(); i++)
+    if (sat_api->l_get(bv[i]).is_true())
+      str[bv.size() - 1 - i] = '1';
+
+  return binary2integer(str, is_signed);
+}
+
+// ******************************  Bitblast foo *******************************
+
 void bitblast_convt::full_adder(
   const bvt &op0,
   const bvt &op1,
@@ -542,6 +427,7 @@ void bitblast_convt::full_adder(
   literalt &carry_out)
 {
   assert(op0.size() == op1.size());
+  output.clear();
   output.reserve(op0.size());
 
   carry_out = carry_in;
@@ -551,25 +437,15 @@ void bitblast_convt::full_adder(
     output.push_back(sat_api->lxor(sat_api->lxor(op0[i], op1[i]), carry_out));
     carry_out = carry(op0[i], op1[i], carry_out);
   }
-
-  return;
 }
 
 literalt bitblast_convt::carry(literalt a, literalt b, literalt c)
 {
-  bvt tmp;
-  tmp.reserve(3);
-  tmp.push_back(sat_api->land(a, b));
-  tmp.push_back(sat_api->land(a, c));
-  tmp.push_back(sat_api->land(b, c));
-  return lor(tmp);
-}
-
-literalt bitblast_convt::unsigned_less_than(const bvt &arg0, const bvt &arg1)
-{
-  bvt tmp = arg1;
-  invert(tmp);
-  return sat_api->lnot(carry_out(arg0, tmp, const_literal(true)));
+  // (a & b) | (c & (a ^ b)). Both a & b and a ^ b are part of the sum bit's
+  // circuit already, which the structural hashing picks up.
+  literalt gen = sat_api->land(a, b);
+  literalt prop = sat_api->land(c, sat_api->lxor(a, b));
+  return sat_api->lor(gen, prop);
 }
 
 void bitblast_convt::unsigned_multiplier(
@@ -577,51 +453,33 @@ void bitblast_convt::unsigned_multiplier(
   const bvt &op1,
   bvt &output)
 {
-  output.resize(op0.size());
-
-  for (unsigned int i = 0; i < op0.size(); i++)
-    output[i] = const_literal(false);
-
-  for (unsigned int i = 0; i < op0.size(); i++)
-  {
-    if (op0[i] != const_literal(false))
-    {
-      bvt tmpop;
-      tmpop.reserve(op0.size());
+  assert(op0.size() == op1.size());
 
-      for (unsigned int idx = 0; idx < i; idx++)
-        tmpop.push_back(const_literal(false));
+  // Rows for the zero bits of a constant factor cost nothing
+  const bvt &f0 = is_constant(op1) ? op1 : op0;
+  const bvt &f1 = is_constant(op1) ? op0 : op1;
 
-      for (unsigned int idx = i; idx < op0.size(); idx++)
-        tmpop.push_back(sat_api->land(op1[idx - i], op0[i]));
+  output.assign(f0.size(), const_literal(false));
 
-      bvt tmpadd;
-      literalt dummy;
-      full_adder(output, tmpop, tmpadd, const_literal(false), dummy);
-      output = tmpadd;
-    }
-  }
-}
+  for (unsigned int i = 0; i < f0.size(); i++)
+  {
+    if (f0[i] == const_literal(false))
+      continue;
 
-void bitblast_convt::signed_multiplier(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &output)
-{
-  assert(op0.size() == op1.size() && op0.size() != 0);
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
+    bvt tmpop;
+    tmpop.reserve(f0.size());
 
-  bvt neg0, neg1;
-  cond_negate(op0, neg0, sign0);
-  cond_negate(op1, neg1, sign1);
+    for (unsigned int idx = 0; idx < i; idx++)
+      tmpop.push_back(const_literal(false));
 
-  bvt tmp;
-  unsigned_multiplier(neg0, neg1, tmp);
+    for (unsigned int idx = i; idx < f0.size(); idx++)
+      tmpop.push_back(sat_api->land(f1[idx - i], f0[i]));
 
-  literalt res_sign = sat_api->lxor(sign0, sign1);
-
-  cond_negate(tmp, output, res_sign);
+    bvt tmpadd;
+    literalt dummy;
+    full_adder(output, tmpop, tmpadd, const_literal(false), dummy);
+    output.swap(tmpadd);
+  }
 }
 
 void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
@@ -633,37 +491,25 @@ void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
 
   for (unsigned int i = 0; i < vals.size(); i++)
     out[i] = sat_api->lselect(cond, inv[i], vals[i]);
-
-  return;
 }
 
 void bitblast_convt::negate(const bvt &inp, bvt &oup)
 {
-  oup.resize(inp.size());
   bvt inv = inp;
   invert(inv);
-
-  literalt dummy;
-  incrementer(inv, const_literal(true), dummy, oup);
-  return;
+  incrementer(inv, const_literal(true), oup);
 }
 
-void bitblast_convt::incrementer(
-  const bvt &inp,
-  const literalt &carryin,
-  literalt carryout,
-  bvt &oup)
+void bitblast_convt::incrementer(const bvt &inp, literalt carryin, bvt &oup)
 {
-  carryout = carryin;
+  oup.resize(inp.size());
+  literalt carry = carryin;
 
   for (unsigned int i = 0; i < inp.size(); i++)
   {
-    literalt new_carry = sat_api->land(carryout, inp[i]);
-    oup[i] = sat_api->lxor(inp[i], carryout);
-    carryout = new_carry;
+    oup[i] = sat_api->lxor(inp[i], carry);
+    carry = sat_api->land(carry, inp[i]);
   }
-
-  return;
 }
 
 void bitblast_convt::signed_divider(
@@ -674,41 +520,21 @@ void bitblast_convt::signed_divider(
 {
   assert(op0.size() == op1.size());
 
-  bvt _op0;
-  bvt _op1;
-  _op0.resize(op0.size());
-  _op1.resize(op1.size());
-
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
-
-  bvt neg0;
-  bvt neg1;
-  negate(op0, neg0);
-  negate(op1, neg1);
-
-  for (unsigned int i = 0; i < op0.size(); i++)
-    _op0[i] = sat_api->lselect(sign0, neg0[i], op0[i]);
-
-  for (unsigned int i = 0; i < op1.size(); i++)
-    _op1[i] = sat_api->lselect(sign1, neg1[i], op1[i]);
-
-  unsigned_divider(_op0, _op1, res, rem);
-
-  bvt neg_res;
-  bvt neg_rem;
-  negate(res, neg_res);
-  negate(rem, neg_rem);
-
-  literalt result_sign = sat_api->lxor(sign0, sign1);
+  literalt sign0 = op0.back();
+  literalt sign1 = op1.back();
 
-  for (unsigned int i = 0; i < res.size(); i++)
-    res[i] = sat_api->lselect(result_sign, neg_res[i], res[i]);
+  bvt abs0, abs1;
+  cond_negate(op0, abs0, sign0);
+  cond_negate(op1, abs1, sign1);
 
-  for (unsigned int i = 0; i < rem.size(); i++)
-    rem[i] = sat_api->lselect(result_sign, neg_rem[i], rem[i]);
+  bvt ures, urem;
+  unsigned_divider(abs0, abs1, ures, urem);
 
-  return;
+  // Division truncates towards zero, so the remainder takes the sign of the
+  // dividend. The zero-divisor results of bvsdiv / bvsrem come out of the
+  // unsigned ones by the same rules.
+  cond_negate(ures, res, sat_api->lxor(sign0, sign1));
+  cond_negate(urem, rem, sign0);
 }
 
 void bitblast_convt::unsigned_divider(
@@ -719,38 +545,40 @@ void bitblast_convt::unsigned_divider(
 {
   assert(op0.size() == op1.size());
   unsigned int width = op0.size();
-  res.resize(width);
-  rem.resize(width);
 
   literalt is_not_zero = lor(op1);
 
+  bvt q, r;
   for (unsigned int i = 0; i < width; i++)
   {
-    res[i] = sat_api->new_variable();
-    rem[i] = sat_api->new_variable();
+    q.push_back(sat_api->new_variable());
+    r.push_back(sat_api->new_variable());
   }
 
-  bvt product;
-  unsigned_multiplier_no_overflow(res, op1, product);
+  // These constraints only define q and r, whatever op0 and op1 are, so they
+  // hold in every context and are asserted unguarded.
 
-  // "res*op1 + rem = op0"
+  // "q*op1 + r = op0"
+  bvt product;
+  unsigned_multiplier_no_overflow(q, op1, product);
 
   bvt sum;
-  adder_no_overflow(product, rem, sum);
-
-  literalt is_equal = equal(sum, op0);
-
-  sat_api->assert_lit(sat_api->limplies(is_not_zero, is_equal));
+  adder_no_overflow(product, r, sum);
 
-  // "op1 != 0 => rem < op1"
+  sat_api->assert_lit(sat_api->limplies(is_not_zero, equal(sum, op0)));
 
+  // "op1 != 0 => r < op1"
   sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(false, rem, op1, false)));
+    sat_api->limplies(is_not_zero, lt_or_le(false, r, op1, false)));
 
-  // "op1 != 0 => res <= op0"
-
-  sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(true, rem, op0, false)));
+  // Dividing by zero gives all ones and leaves op0 as the remainder
+  res.resize(width);
+  rem.resize(width);
+  for (unsigned int i = 0; i < width; i++)
+  {
+    res[i] = sat_api->lselect(is_not_zero, q[i], const_literal(true));
+    rem[i] = sat_api->lselect(is_not_zero, r[i], op0[i]);
+  }
 }
 
 void bitblast_convt::unsigned_multiplier_no_overflow(
@@ -759,109 +587,39 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
   bvt &res)
 {
   assert(op0.size() == op1.size());
-  bvt _op0 = op0, _op1 = op1;
+  const bvt &f0 = is_constant(op1) ? op1 : op0;
+  const bvt &f1 = is_constant(op1) ? op0 : op1;
 
-  if (is_constant(_op1))
-    std::swap(_op0, _op1);
+  res.assign(f0.size(), const_literal(false));
 
-  res.resize(op0.size());
-
-  for (unsigned int i = 0; i < res.size(); i++)
-    res[i] = const_literal(false);
-
-  for (unsigned int sum = 0; sum < op0.size(); sum++)
+  for (unsigned int sum = 0; sum < f0.size(); sum++)
   {
-    if (op0[sum] != const_literal(false))
-    {
-      bvt tmpop;
-
-      tmpop.reserve(res.size());
-
-      for (unsigned int idx = 0; idx < sum; idx++)
-        tmpop.push_back(const_literal(false));
+    if (f0[sum] == const_literal(false))
+      continue;
 
-      for (unsigned int idx = sum; idx < res.size(); idx++)
-        tmpop.push_back(sat_api->land(op1[idx - sum], op0[sum]));
+    bvt tmpop;
+    tmpop.reserve(res.size());
 
-      bvt copy = res;
-      adder_no_overflow(copy, tmpop, res);
+    for (unsigned int idx = 0; idx < sum; idx++)
+      tmpop.push_back(const_literal(false));
 
-      for (unsigned int idx = op1.size() - sum; idx < op1.size(); idx++)
-      {
-        literalt tmp = sat_api->land(op1[idx], op0[sum]);
-        tmp.invert();
-        sat_api->assert_lit(tmp);
-      }
-    }
-  }
-}
+    for (unsigned int idx = sum; idx < res.size(); idx++)
+      tmpop.push_back(sat_api->land(f1[idx - sum], f0[sum]));
 
-void bitblast_convt::adder_no_overflow(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &res,
-  bool subtract,
-  bool is_signed)
-{
-  assert(op0.size() == op1.size());
-  unsigned int width = op0.size();
-  bvt tmp_op1 = op1;
-  if (subtract)
-    negate(op1, tmp_op1);
+    bvt copy = res;
+    adder_no_overflow(copy, tmpop, res);
 
-  if (is_signed)
-  {
-    literalt old_sign = op0[width - 1];
-    literalt sign_the_same =
-      sat_api->lequal(op0[width - 1], tmp_op1[width - 1]);
-    literalt carry;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry);
-    literalt stop_overflow =
-      sat_api->land(sign_the_same, sat_api->lxor(op0[width - 1], old_sign));
-    stop_overflow.invert();
-    sat_api->assert_lit(stop_overflow);
-  }
-  else
-  {
-    literalt carry_out;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry_out);
-    if (subtract)
-    {
-      sat_api->assert_lit(carry_out);
-    }
-    else
-    {
-      carry_out.invert();
-      sat_api->assert_lit(carry_out);
-    }
+    // Bits shifted out of this row must be zero
+    for (unsigned int idx = f1.size() - sum; idx < f1.size(); idx++)
+      sat_api->assert_lit(sat_api->lnot(sat_api->land(f1[idx], f0[sum])));
   }
-
-  return;
 }
 
 void bitblast_convt::adder_no_overflow(const bvt &op0, const bvt &op1, bvt &res)
 {
-  res.resize(op0.size());
-
-  literalt carry_out = const_literal(false);
-  for (unsigned int i = 0; i < op0.size(); i++)
-  {
-    literalt op0_bit = op0[i];
-
-    res[i] = sat_api->lxor(sat_api->lxor(op0_bit, op1[i]), carry_out);
-    carry_out = carry(op0_bit, op1[i], carry_out);
-  }
-
-  carry_out.invert();
-  sat_api->assert_lit(carry_out);
-}
-
-bool bitblast_convt::is_constant(const bvt &bv)
-{
-  for (unsigned int i = 0; i < bv.size(); i++)
-    if (!bv[i].is_constant())
-      return false;
-  return true;
+  literalt carry_out;
+  full_adder(op0, op1, res, const_literal(false), carry_out);
+  sat_api->assert_lit(sat_api->lnot(carry_out));
 }
 
 literalt bitblast_convt::carry_out(const bvt &a, const bvt &b, literalt c)
@@ -883,8 +641,7 @@ literalt bitblast_convt::equal(const bvt &op0, const bvt &op1)
   for (unsigned int i = 0; i < op0.size(); i++)
     tmp.push_back(sat_api->lequal(op0[i], op1[i]));
 
-  literalt res = land(tmp);
-  return res;
+  return land(tmp);
 }
 
 literalt bitblast_convt::lt_or_le(
@@ -894,8 +651,9 @@ literalt bitblast_convt::lt_or_le(
   bool is_signed)
 {
   assert(bv0.size() == bv1.size());
-  literalt top0 = bv0[bv0.size() - 1], top1 = bv1[bv1.size() - 1];
+  literalt top0 = bv0.back(), top1 = bv1.back();
 
+  // bv0 - bv1 carries out iff bv0 >= bv1, unsigned
   bvt inv_op1 = bv1;
   invert(inv_op1);
   literalt carry = carry_out(bv0, inv_op1, const_literal(true));
@@ -924,12 +682,20 @@ void bitblast_convt::barrel_shift(
   const bvt &dist,
   bvt &out)
 {
-  unsigned long d = 1;
   out = op;
 
-  // FIXME: clip this on oversized shifts?
+  // Distance bits worth the whole width or more shift everything out
+  bvt overflow;
+  unsigned long d = 1;
+
   for (unsigned int pos = 0; pos < dist.size(); pos++)
   {
+    if (d >= op.size())
+    {
+      overflow.push_back(dist[pos]);
+      continue;
+    }
+
     if (dist[pos] != const_literal(false))
     {
       bvt tmp;
@@ -941,6 +707,11 @@ void bitblast_convt::barrel_shift(
 
     d <<= 1;
   }
+
+  literalt too_far = lor(overflow);
+  literalt fill = (s == ARIGHT) ? op.back() : const_literal(false);
+  for (unsigned int i = 0; i < op.size(); i++)
+    out[i] = sat_api->lselect(too_far, fill, out[i]);
 }
 
 void bitblast_convt::shift(
@@ -970,8 +741,6 @@ void bitblast_convt::shift(
 
     out[i] = l;
   }
-
-  return;
 }
 
 void bitblast_convt::bvand(const bvt &bv0, const bvt &bv1, bvt &output)
@@ -982,8 +751,6 @@ void bitblast_convt::bvand(const bvt &bv0, const bvt &bv1, bvt &output)
 
   for (unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->land(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvor(const bvt &bv0, const bvt &bv1, bvt &output)
@@ -994,114 +761,56 @@ void bitblast_convt::bvor(const bvt &bv0, const bvt &bv1, bvt &output)
 
   for (unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->lor(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvxor(const bvt &bv0, const bvt &bv1, bvt &output)
 {
+  assert(bv0.size() == bv1.size());
   output.clear();
   output.reserve(bv0.size());
 
   for (unsigned int i = 0; i < bv0.size(); i++)
     output.push_back(sat_api->lxor(bv0[i], bv1[i]));
-
-  return;
 }
 
 void bitblast_convt::bvnot(const bvt &bv0, bvt &output)
 {
-  output.clear();
-  output.reserve(bv0.size());
-
-  for (unsigned int i = 0; i < bv0.size(); i++)
-    output.push_back(sat_api->lnot(bv0[i]));
-
-  return;
+  output = bv0;
+  invert(output);
 }
 
 literalt bitblast_convt::land(const bvt &bv)
 {
-  if (bv.size() == 0)
-    return const_literal(true);
-  else if (bv.size() == 1)
-    return bv[0];
-  else if (bv.size() == 2)
-    return sat_api->land(bv[0], bv[1]);
-
-  unsigned int trues = 0;
-  for (unsigned int i = 0; i < bv.size(); i++)
-  {
-    if (bv[i] == const_literal(false))
-      return const_literal(false);
-    else if (bv[i] == const_literal(true))
-      trues++;
-  }
-
-  if (trues == bv.size())
+  if (bv.empty())
     return const_literal(true);
 
-  bvt new_bv;
-
-  eliminate_duplicates(bv, new_bv);
-
-  literalt lit = sat_api->new_variable();
-
-  for (unsigned int i = 0; i < new_bv.size(); i++)
+  // Reduce as a balanced tree, rather than a chain as deep as bv is wide
+  bvt layer = bv;
+  while (layer.size() > 1)
   {
-    bvt lits;
-    lits.reserve(2);
-    lits.push_back(pos(new_bv[i]));
-    lits.push_back(neg(lit));
-    sat_api->lcnf(lits);
+    bvt next;
+    next.reserve((layer.size() + 1) / 2);
+    for (std::size_t i = 0; i + 1 < layer.size(); i += 2)
+      next.push_back(sat_api->land(layer[i], layer[i + 1]));
+    if (layer.size() % 2)
+      next.push_back(layer.back());
+    layer.swap(next);
   }
 
-  bvt lits;
-  lits.reserve(new_bv.size() + 1);
-
-  for (unsigned int i = 0; i < new_bv.size(); i++)
-    lits.push_back(neg(new_bv[i]));
-
-  lits.push_back(pos(lit));
-  sat_api->lcnf(lits);
-
-  return lit;
+  return layer[0];
 }
 
 literalt bitblast_convt::lor(const bvt &bv)
 {
-  if (bv.size() == 0)
-    return const_literal(false);
-  else if (bv.size() == 1)
-    return bv[0];
-  else if (bv.size() == 2)
-    return sat_api->lor(bv[0], bv[1]);
+  bvt inv = bv;
+  invert(inv);
+  return sat_api->lnot(land(inv));
+}
 
+bool bitblast_convt::is_constant(const bvt &bv)
+{
   for (unsigned int i = 0; i < bv.size(); i++)
-    if (bv[i] == const_literal(true))
-      return const_literal(true);
-
-  bvt new_bv;
-  eliminate_duplicates(bv, new_bv);
-
-  literalt literal = sat_api->new_variable();
-  for (unsigned int i = 0; i < new_bv.size(); i++)
-  {
-    bvt lits;
-    lits.reserve(2);
-    lits.push_back(neg(new_bv[i]));
-    lits.push_back(pos(literal));
-    sat_api->lcnf(lits);
-  }
-
-  bvt lits;
-  lits.reserve(new_bv.size() + 1);
-
-  for (unsigned int i = 0; i < new_bv.size(); i++)
-    lits.push_back(pos(new_bv[i]));
-
-  lits.push_back(neg(literal));
-  sat_api->lcnf(lits);
-
-  return literal;
+    if (!bv[i].is_constant())
+      return false;
+  return true;
 }
@@ -1,11 +1,25 @@
 #ifndef _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 
+#include <solvers/prop/literal.h>
+#include <util/threeval.h>
+
+// A SAT solver taking clauses, at the bottom of the bitblasting pipeline.
+// Literals here are solver variables, as handed out by new_variable().
+
 class cnf_iface
 {
 public:
-  virtual void setto(literalt a, bool val) = 0;
+  virtual ~cnf_iface() = default;
+
+  virtual literalt new_variable() = 0;
   virtual void lcnf(const bvt &bv) = 0;
+
+  /** Solve under the given assumptions: true if satisfiable, false if not,
+   *  unknown if the solver was interrupted */
+  virtual tvt solve(const bvt &assumptions) = 0;
+
+  virtual tvt l_get(literalt a) = 0;
 };
 
 #endif /* _ESBMC_SOLVERS_SAT_CNF_IFACE_H_ */
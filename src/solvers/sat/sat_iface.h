@@ -1,14 +1,19 @@
 #ifndef _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 
+#include <solvers/prop/literal.h>
+#include <util/threeval.h>
+
 // An interface for defining a SAT interface within ESBMC, as used by the
-// SAT bitblaster. I anticipate that nothing else actually needs to use this
-// interface, except perhaps sat solvers that have non-cnf inputs.
+// SAT bitblaster. Literals handed out by it are opaque to the bitblaster:
+// they may be gates of a circuit rather than solver variables, which is how
+// aig_convt implements it.
 
 class sat_iface
 {
 public:
-  virtual void lcnf(const bvt &bv) = 0;
+  virtual ~sat_iface() = default;
+
   virtual literalt lnot(literalt a) = 0;
   virtual literalt lselect(literalt a, literalt b, literalt c) = 0;
   virtual literalt lequal(literalt a, literalt b) = 0;
@@ -16,10 +21,17 @@ public:
   virtual literalt lxor(literalt a, literalt b) = 0;
   virtual literalt land(literalt a, literalt b) = 0;
   virtual literalt lor(literalt a, literalt b) = 0;
-  virtual void set_equal(literalt a, literalt b) = 0;
-  virtual void assert_lit(const literalt &a) = 0;
-  virtual tvt l_get(const literalt &a) = 0;
   virtual literalt new_variable() = 0;
+
+  /** Constrain a to be true in every model from now on */
+  virtual void assert_lit(literalt a) = 0;
+
+  /** Solve under the given assumptions: true if satisfiable, false if not,
+   *  unknown if the solver was interrupted */
+  virtual tvt solve(const bvt &assumptions) = 0;
+
+  /** Value of a in the model found by the last satisfiable solve() */
+  virtual tvt l_get(literalt a) = 0;
 };
 
 #endif /* _ESBMC_SOLVERS_SAT_SAT_IFACE_H_ */
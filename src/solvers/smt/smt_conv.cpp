@@ -67,6 +67,7 @@ smt_convt::smt_convt(const namespacet &_ns, const optionst &_options)
   : ctx_level(0), boolean_sort(nullptr), ns(_ns), options(_options)
 {
   int_encoding = options.get_bool_option("int-encoding");
+  linear_addr_space = options.get_bool_option("linear-address-space");
   tuple_api = nullptr;
   array_api = nullptr;
   fp_api = nullptr;
@@ -249,6 +249,14 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Ask a dec_solve() running in another thread to give up, it then returns
+   *  P_ERROR unless it finishes first. This is only a request: a solver that
+   *  hasn't started searching yet may miss it, and solvers that can't be
+   *  interrupted ignore it. It never affects later calls to dec_solve(). */
+  virtual void interrupt()
+  {
+  }
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -665,6 +673,9 @@ public:
    *  number. Essentially, this asserts that all the objects to date don't
    *  overlap with /this/ one. */
   void finalize_pointer_chain(unsigned int obj_num);
+  /** The same, but with a constant number of constraints: the object is
+   *  placed above the last live one allocated before it. */
+  void finalize_pointer_chain_linear(unsigned int obj_num);
 
   /** Typecast data to bools */
   smt_astt convert_typecast_to_bool(const typecast2t &cast);
@@ -802,6 +813,9 @@ public:
   smt_sortt boolean_sort;
   /** Whether we are encoding expressions in integer mode or not. */
   bool int_encoding;
+  /** Whether objects are laid out in allocation order, see
+   *  finalize_pointer_chain. */
+  bool linear_addr_space;
   /** A namespace containing all the types in the program. Used to resolve the
    *  rare case where we're doing some pointer arithmetic and need to have the
    *  concrete type of a pointer. */
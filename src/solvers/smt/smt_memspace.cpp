@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <atomic>
 #include <sstream>
 #include <solvers/smt/smt_conv.h>
 #include <util/message/format.h>
@@ -387,6 +388,9 @@ smt_astt smt_convt::init_pointer_obj(unsigned int obj_num, const expr2tc &size)
 
 void smt_convt::finalize_pointer_chain(unsigned int objnum)
 {
+  if (linear_addr_space)
+    return finalize_pointer_chain_linear(objnum);
+
   type2tc inttype = ptraddr_type2();
   unsigned int num_ptrs = addr_space_data.back().size();
   if (num_ptrs == 0)
@@ -440,6 +444,50 @@ void smt_convt::finalize_pointer_chain(unsigned int objnum)
   }
 }
 
+void smt_convt::finalize_pointer_chain_linear(unsigned int objnum)
+{
+  /* Objects are stacked in the order they are registered in. Each object i
+   * gets a floor, below which all objects live at the time lie:
+   *   floor_i = __ESBMC_alloc[j] ? j_end : floor_j
+   * where j is the object registered before i, and i starts above it:
+   *   i_start > floor_i
+   * Like the pairwise constraints, a free'd object j no longer restricts i,
+   * but only so far as everything allocated after j has been free'd too:
+   * its space is reused like that of a stack. This costs two constraints
+   * per object instead of one per pair of objects. Reusing the space of an
+   * object free'd out of order would take the highest end of all objects
+   * still alive, which is a constraint per pair again. */
+  const std::map<unsigned, unsigned> &objs = addr_space_data.back();
+
+  // The last object registered, skipping INVALID (1) which overlaps
+  // everything. NULL (0) is always there and ends at address 0.
+  auto prev = objs.rbegin();
+  while (prev != objs.rend() && prev->first == 1)
+    ++prev;
+  if (prev == objs.rend())
+    return;
+  unsigned int j = prev->first;
+
+  type2tc inttype = ptraddr_type2();
+  auto obj_sym = [&inttype](const char *what, unsigned int n) {
+    return symbol2tc(
+      inttype, std::string("__ESBMC_ptr_obj_") + what + std::to_string(n));
+  };
+
+  expr2tc floor_i = obj_sym("floor_", objnum);
+  expr2tc floor = obj_sym("end_", j);
+  if (j && current_valid_objects_sym)
+  {
+    // See finalize_pointer_chain() as to which __ESBMC_alloc this is
+    expr2tc alive =
+      index2tc(get_bool_type(), current_valid_objects_sym, gen_ulong(j));
+    floor = if2tc(inttype, alive, floor, obj_sym("floor_", j));
+  }
+
+  assert_expr(equality2tc(floor_i, floor));
+  assert_expr(greaterthan2tc(obj_sym("start_", objnum), floor_i));
+}
+
 smt_astt smt_convt::convert_addr_of(const expr2tc &expr)
 {
   const address_of2t &obj = to_address_of2t(expr);
@@ -488,7 +536,7 @@ smt_astt smt_convt::convert_addr_of(const expr2tc &expr)
     // along the way.
     // The pointer will remain consistent because any pointer taken to the
     // same constant array will be picked up in the expression cache
-    static unsigned int constarr_num = 0;
+    static std::atomic<unsigned int> constarr_num = 0;
     std::stringstream ss;
     ss << "address_of_arr_const(" << constarr_num++ << ")";
     return convert_identifier_pointer(obj.ptr_obj, ss.str());
@@ -7,13 +7,17 @@
 
 #include <solvers/smt/tuple/smt_tuple_node.h>
 
+#include <algorithm>
 #include <cinttypes>
 #include <regex>
 #include <sstream>
 
 #ifndef _WIN32
-#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #endif
 
 // clang-format off
@@ -196,22 +200,15 @@ smtlib_convt::file_emitter::~file_emitter() noexcept
     fclose(out_stream);
 }
 
-smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
-  : out_stream(nullptr), in_stream(nullptr), org_sigpipe_handler(nullptr)
+#ifndef _WIN32
+static smtlib_convt::process_emitter::solver_process
+spawn_solver(const std::string &cmd)
 {
-  if (cmd == "")
-    return;
-
   // Setup: open a pipe to the smtlib solver. There seems to be no standard C++
   // way of opening a stream from an fd, so use C file streams.
 
   int inpipe[2], outpipe[2];
 
-#ifdef _WIN32
-  // TODO: The current implementation uses UNIX Process
-  log_error("smtlib works only in unix systems");
-  abort();
-#else
   if (pipe(inpipe) != 0)
   {
     log_error("Couldn't open a pipe for smtlib solver");
@@ -249,26 +246,60 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
       strerror(errno));
     abort();
   }
-  else
-  {
-    close(outpipe[0]);
-    close(inpipe[1]);
-    out_stream = fdopen(outpipe[1], "w");
-    in_stream = fdopen(inpipe[0], "r");
 
-    org_sigpipe_handler = reinterpret_cast<void *>(signal(SIGPIPE, SIG_IGN));
-    if (org_sigpipe_handler == SIG_ERR)
-    {
-      log_error("registering SIGPIPE handler: {}", strerror(errno));
-      abort();
-    }
+  close(outpipe[0]);
+  close(inpipe[1]);
+
+  // Solvers forked later must not hold on to this one's pipes, or it would
+  // never see the end of its input. Writes don't block, so that flush() can
+  // feed all solvers at once.
+  fcntl(outpipe[1], F_SETFD, FD_CLOEXEC);
+  fcntl(inpipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(outpipe[1], F_SETFL, fcntl(outpipe[1], F_GETFL) | O_NONBLOCK);
+
+  return {cmd, solver_proc_pid, outpipe[1], fdopen(inpipe[0], "r")};
+}
+
+static void kill_solver(
+  const smtlib_convt::process_emitter::solver_process &proc)
+{
+  kill(proc.pid, SIGKILL);
+  if (proc.out_fd != -1)
+    close(proc.out_fd);
+  fclose(proc.in_stream);
+  waitpid(proc.pid, nullptr, 0);
+}
+#endif
+
+smtlib_convt::process_emitter::process_emitter(const std::string &cmds)
+  : org_sigpipe_handler(nullptr)
+{
+  if (cmds == "")
+    return;
+
+#ifdef _WIN32
+  // TODO: The current implementation uses UNIX Process
+  log_error("smtlib works only in unix systems");
+  abort();
+#else
+  std::istringstream lines(cmds);
+  for (std::string cmd; std::getline(lines, cmd);)
+    if (!cmd.empty())
+      procs.push_back(spawn_solver(cmd));
+
+  org_sigpipe_handler = reinterpret_cast<void *>(signal(SIGPIPE, SIG_IGN));
+  if (org_sigpipe_handler == SIG_ERR)
+  {
+    log_error("registering SIGPIPE handler: {}", strerror(errno));
+    abort();
   }
   // Execution continues as the parent ESBMC process. Child dying will
   // trigger SIGPIPE or an EOF eventually, which we'll be able to detect
   // and crash upon.
 
-  // Point lexer input at output stream
-  smtlib_tokin = in_stream;
+  // Point lexer input at output stream. With several solvers, dec_solve()
+  // points it at whichever answers first.
+  smtlib_tokin = procs.front().in_stream;
 
   // Fetch solver name and version.
 #if 0
@@ -328,26 +359,90 @@ smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
     "Using external solver '{}' version '{}' with PID {}",
     solver_name,
     solver_version,
-    solver_proc_pid);
+    procs.front().pid);
 #else
-  log_status(
-    "Using external solver cmd '{}' with PID {}", cmd, solver_proc_pid);
+  for (const solver_process &proc : procs)
+    log_status(
+      "Using external solver cmd '{}' with PID {}", proc.cmd, proc.pid);
 #endif
 #endif
 }
 
 smtlib_convt::process_emitter::~process_emitter() noexcept
 {
-  if (out_stream)
-    fclose(out_stream);
-  if (in_stream)
-    fclose(in_stream);
 #ifndef _WIN32
+  for (const solver_process &proc : procs)
+  {
+    if (proc.out_fd != -1)
+      close(proc.out_fd);
+    fclose(proc.in_stream);
+  }
   if (org_sigpipe_handler)
     signal(SIGPIPE, reinterpret_cast<void (*)(int)>(org_sigpipe_handler));
 #endif
 }
 
+size_t smtlib_convt::process_emitter::wait_for_answer()
+{
+#ifndef _WIN32
+  while (procs.size() > 1)
+  {
+    std::vector<pollfd> fds;
+    for (const solver_process &proc : procs)
+      fds.push_back({fileno(proc.in_stream), POLLIN, 0});
+
+    if (poll(fds.data(), fds.size(), -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      log_error("Waiting for smtlib solvers: {}", strerror(errno));
+      abort();
+    }
+
+    for (size_t i = 0; i < fds.size(); i++)
+    {
+      if (fds[i].revents & POLLIN)
+        return i;
+    }
+
+    // Only hang-ups, i.e. solvers that exited without answering
+    for (size_t i = fds.size(); i-- > 0;)
+    {
+      if (fds[i].revents && procs.size() > 1)
+      {
+        log_warning("[smtlib] solver '{}' exited early", procs[i].cmd);
+        drop(i);
+      }
+    }
+  }
+#endif
+  return 0;
+}
+
+void smtlib_convt::process_emitter::drop(size_t i)
+{
+#ifndef _WIN32
+  kill_solver(procs[i]);
+  procs.erase(procs.begin() + i);
+#endif
+}
+
+void smtlib_convt::process_emitter::keep_only(size_t i)
+{
+#ifndef _WIN32
+  if (procs.size() == 1)
+    return;
+
+  log_status("[smtlib] '{}' answered first", procs[i].cmd);
+  for (size_t j = 0; j < procs.size(); j++)
+  {
+    if (j != i)
+      kill_solver(procs[j]);
+  }
+  procs = {procs[i]};
+#endif
+}
+
 smtlib_convt::smtlib_convt(const namespacet &_ns, const optionst &_options)
   : smt_convt(_ns, _options),
     array_iface(true, false),
@@ -564,7 +659,7 @@ void smtlib_smt_ast::dump() const
    * and we're restoring its state at the end of this function. */
   smtlib_convt *ctx_m = const_cast<smtlib_convt *>(ctx);
   FILE *tmp_file = std::exchange(ctx_m->emit_opt_output.out_stream, stderr);
-  FILE *tmp_proc = std::exchange(ctx_m->emit_proc.out_stream, nullptr);
+  auto tmp_proc = std::exchange(ctx_m->emit_proc.procs, {});
 
   ctx->emit_ast(this);
   ctx->emit("%s", "\n");
@@ -573,7 +668,7 @@ void smtlib_smt_ast::dump() const
   ctx->flush();
 
   ctx_m->emit_opt_output.out_stream = tmp_file;
-  ctx_m->emit_proc.out_stream = tmp_proc;
+  ctx_m->emit_proc.procs = std::move(tmp_proc);
 }
 
 smt_convt::resultt smtlib_convt::dec_solve()
@@ -594,26 +689,46 @@ smt_convt::resultt smtlib_convt::dec_solve()
   if (!emit_proc)
     return smt_convt::P_SMTLIB;
 
-  // And read in the output
-  smtlib_send_start_code = 1;
-  smtlibparse(TOK_START_SAT);
-
-  // This should generate on sexpr. See what it is.
-  if (smtlib_output->token == TOK_KW_SAT)
-  {
-    return smt_convt::P_SATISFIABLE;
-  }
-  if (smtlib_output->token == TOK_KW_UNSAT)
-  {
-    return smt_convt::P_UNSATISFIABLE;
-  }
-  else if (smtlib_output->token == TOK_KW_ERROR)
-  {
-    log_error("SMTLIB solver returned: \"{}\"", smtlib_output->data);
-    return smt_convt::P_ERROR;
-  }
-  else
+  for (;;)
   {
+    // And read in the output, from whichever solver has one first
+    size_t i = emit_proc.wait_for_answer();
+    // The lexer buffers its input, so it has to start afresh on another
+    // solver's stream rather than carry on with what it read from the last
+    if (smtlib_tokin != emit_proc.procs[i].in_stream)
+      smtlib_tokrestart(emit_proc.procs[i].in_stream);
+    smtlib_send_start_code = 1;
+    smtlibparse(TOK_START_SAT);
+
+    // This should generate on sexpr. See what it is. The first sat or unsat
+    // wins, the model is then only ever fetched from that solver.
+    if (smtlib_output->token == TOK_KW_SAT)
+    {
+      emit_proc.keep_only(i);
+      return smt_convt::P_SATISFIABLE;
+    }
+    if (smtlib_output->token == TOK_KW_UNSAT)
+    {
+      emit_proc.keep_only(i);
+      return smt_convt::P_UNSATISFIABLE;
+    }
+
+    // Other solvers may still come up with an answer
+    if (emit_proc.procs.size() > 1)
+    {
+      log_warning(
+        "[smtlib] solver '{}' gave no sat/unsat answer",
+        emit_proc.procs[i].cmd);
+      emit_proc.drop(i);
+      continue;
+    }
+
+    if (smtlib_output->token == TOK_KW_ERROR)
+    {
+      log_error("SMTLIB solver returned: \"{}\"", smtlib_output->data);
+      return smt_convt::P_ERROR;
+    }
+
     log_error("Unrecognized check-sat output from smtlib solver");
     abort();
   }
@@ -730,24 +845,89 @@ void smtlib_convt::flush() const
 
 smtlib_convt::process_emitter::operator bool() const noexcept
 {
-  return out_stream != nullptr;
+  return !procs.empty();
 }
 
 template <typename... Ts>
 void smtlib_convt::process_emitter::emit(const char *fmt, Ts &&...ts) const
 {
-  /* TODO: other error handling */
-  errno = 0;
-  if (fprintf(out_stream, fmt, ts...) < 0 && errno == EPIPE)
-    throw external_process_died(read_all(in_stream));
+  // Formatted once, however many solvers there are
+  size_t old_size = pending.size();
+  int len = snprintf(nullptr, 0, fmt, ts...);
+  pending.resize(old_size + len + 1);
+  snprintf(&pending[old_size], len + 1, fmt, ts...);
+  pending.resize(old_size + len);
+
+  // Don't hold on to a whole formula
+  if (pending.size() >= (1 << 20))
+    flush();
 }
 
 void smtlib_convt::process_emitter::flush() const
 {
-  /* TODO: other error handling */
-  errno = 0;
-  if (fflush(out_stream) == EOF && errno == EPIPE)
-    throw external_process_died(read_all(in_stream));
+#ifndef _WIN32
+  // Feed all solvers at once: one slow to read its input must not hold back
+  // the others
+  std::vector<size_t> written(procs.size(), 0);
+  for (;;)
+  {
+    std::vector<pollfd> fds;
+    std::vector<size_t> fd_proc;
+    for (size_t i = 0; i < procs.size(); i++)
+    {
+      if (procs[i].out_fd != -1 && written[i] < pending.size())
+      {
+        fds.push_back({procs[i].out_fd, POLLOUT, 0});
+        fd_proc.push_back(i);
+      }
+    }
+    if (fds.empty())
+      break;
+
+    if (poll(fds.data(), fds.size(), -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      log_error("Writing to smtlib solvers: {}", strerror(errno));
+      abort();
+    }
+
+    for (size_t k = 0; k < fds.size(); k++)
+    {
+      if (!fds[k].revents)
+        continue;
+
+      solver_process &proc = procs[fd_proc[k]];
+      size_t &done = written[fd_proc[k]];
+      ssize_t n =
+        write(proc.out_fd, pending.data() + done, pending.size() - done);
+      if (n >= 0)
+      {
+        done += n;
+        continue;
+      }
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+
+      /* TODO: other error handling */
+      size_t alive = std::count_if(
+        procs.begin(), procs.end(), [](const solver_process &p) {
+          return p.out_fd != -1;
+        });
+      if (alive == 1)
+        throw external_process_died(read_all(proc.in_stream));
+
+      // Leave it to wait_for_answer() to notice it's gone
+      log_warning(
+        "[smtlib] solver '{}' stopped reading: {}",
+        proc.cmd,
+        strerror(errno));
+      close(proc.out_fd);
+      proc.out_fd = -1;
+    }
+  }
+#endif
+  pending.clear();
 }
 
 smtlib_convt::file_emitter::operator bool() const noexcept
@@ -809,7 +989,12 @@ bool smtlib_convt::get_bool(smt_astt a)
 const std::string smtlib_convt::solver_text()
 {
   if (emit_proc)
-    return "'" + options.get_option("smtlib-solver-prog") + "'";
+  {
+    std::string text;
+    for (const auto &proc : emit_proc.procs)
+      text += (text.empty() ? "'" : ", '") + proc.cmd + "'";
+    return text;
+  }
 
   if (emit_opt_output)
     return "Text output";
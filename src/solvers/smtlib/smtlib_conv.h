@@ -4,6 +4,7 @@
 #include <list>
 #include <solvers/smt/smt_conv.h>
 #include <string>
+#include <vector>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -297,14 +298,26 @@ public:
 
   struct process_emitter
   {
-    FILE *out_stream;
-    FILE *in_stream;
+    struct solver_process
+    {
+      std::string cmd;
+      int pid;
+      int out_fd;
+      FILE *in_stream;
+    };
+
+    /* All solvers are sent the same commands and race on check-sat, after
+     * which only the first one to answer is kept. Emitting only appends to
+     * the pending buffer, hence both being mutable. */
+    mutable std::vector<solver_process> procs;
+    mutable std::string pending;
     void *org_sigpipe_handler; /* TODO: static */
 
     std::string solver_name;
     std::string solver_version;
 
-    explicit process_emitter(const std::string &cmd);
+    /* One solver command per line of cmds */
+    explicit process_emitter(const std::string &cmds);
     process_emitter(const process_emitter &) = delete;
 
     ~process_emitter() noexcept;
@@ -315,6 +328,12 @@ public:
     void emit(const char *fmt, Ts &&...) const;
     void flush() const;
 
+    /* Index of the first solver with something to say */
+    size_t wait_for_answer();
+    /* Kill solver i, or all solvers but i */
+    void drop(size_t i);
+    void keep_only(size_t i);
+
     explicit operator bool() const noexcept;
   } emit_proc;
 
@@ -47,6 +47,7 @@ public:
   ~yices_convt() override;
 
   resultt dec_solve() override;
+  void interrupt() override;
   const std::string solver_text() override;
 
   void assert_ast(smt_astt a) override;
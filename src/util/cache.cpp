@@ -1,3 +1,6 @@
+#include <ac_config.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
 #include <util/cache.h>
 #include <util/message.h>
 #include <utility>
@@ -27,3 +30,175 @@ bool assertion_cache::run(symex_target_equationt::SSA_stepst &eq)
     total);
   return true;
 }
+
+namespace
+{
+/* Rewrites every renamed symbol of an expression so that its L1/L2, thread
+ * and node numbers are replaced by the order in which the symbol first
+ * occurs. The renaming is injective, so the resulting formula is
+ * equisatisfiable to the original one. */
+class canonical_renamert
+{
+public:
+  expr2tc rename(const expr2tc &e)
+  {
+    if (is_nil_expr(e))
+      return e;
+
+    auto it = done.find(e.get());
+    if (it != done.end())
+      return it->second;
+
+    expr2tc res = e;
+    if (is_symbol2t(e))
+    {
+      const symbol2t &sym = to_symbol2t(e);
+      if (sym.rlevel != symbol2t::level0)
+      {
+        auto [id, ins] = ids.emplace(sym.get_symbol_key(), ids.size());
+        res = symbol2tc(sym.type, sym.thename, sym.rlevel, id->second);
+      }
+    }
+    else
+      res->Foreach_operand([this](expr2tc &op) { op = rename(op); });
+
+    done.emplace(e.get(), res);
+    return res;
+  }
+
+protected:
+  std::unordered_map<symbol_keyt, unsigned int, symbol_key_hash> ids;
+  std::unordered_map<const expr2t *, expr2tc> done;
+};
+
+void hash_expr(canonical_renamert &renamer, const expr2tc &e, crypto_hash &h)
+{
+  if (is_nil_expr(e))
+  {
+    uint8_t nil = 0;
+    h.ingest(&nil, sizeof(nil));
+    return;
+  }
+
+  renamer.rename(e)->hash(h);
+}
+} // namespace
+
+verification_cachet::verification_cachet(
+  const std::string &_dir,
+  const optionst &options)
+  : dir(_dir)
+{
+  boost::filesystem::create_directories(dir);
+
+  // Options that change what the solver is asked or how it is encoded
+  static const char *const relevant_options[] = {
+    "int-encoding",
+    "ir",
+    "bv",
+    "fixedbv",
+    "floatbv",
+    "fp2bv",
+    "tuple-node-flattener",
+    "tuple-sym-flattener",
+    "array-flattener",
+    "linear-address-space",
+    "boolector",
+    "z3",
+    "mathsat",
+    "cvc",
+    "yices",
+    "bitwuzla",
+    "minisat",
+    "smtlib",
+    "smtlib-solver-prog",
+    "default-solver",
+    "16",
+    "32",
+    "64",
+    "little-endian",
+    "big-endian",
+    "cheri",
+    "cheri-uncompressed"};
+
+  std::string fingerprint = ESBMC_VERSION;
+  for (const char *opt : relevant_options)
+    fingerprint += std::string("\n") + opt + "=" + options.get_option(opt);
+
+  crypto_hash h;
+  h.ingest(fingerprint.data(), fingerprint.size());
+  h.fin();
+  options_key = h.to_string();
+}
+
+std::string verification_cachet::key(
+  const symex_target_equationt::SSA_stepst &steps,
+  const std::vector<bool> &ignored) const
+{
+  assert(ignored.size() == steps.size());
+  canonical_renamert renamer;
+  crypto_hash h;
+  h.ingest(options_key.data(), options_key.size());
+
+  for (size_t i = 0; i < steps.size(); i++)
+  {
+    const auto &step = steps[i];
+    if (ignored[i] || step.is_output() || step.is_skip())
+      continue;
+
+    uint8_t type = step.type;
+    h.ingest(&type, sizeof(type));
+    hash_expr(renamer, step.guard, h);
+
+    if (step.is_renumber())
+    {
+      hash_expr(renamer, step.lhs, h);
+      hash_expr(renamer, step.rhs, h);
+    }
+    else
+      hash_expr(renamer, step.cond, h);
+  }
+
+  h.fin();
+  return h.to_string();
+}
+
+tvt verification_cachet::lookup(const std::string &key) const
+{
+  std::ifstream in((boost::filesystem::path(dir) / key).string());
+  std::string verdict;
+  if (!(in >> verdict))
+    return tvt(tvt::TV_UNKNOWN);
+
+  if (verdict == "holds")
+    return tvt(true);
+  if (verdict == "fails")
+    return tvt(false);
+
+  log_warning("Ignoring corrupted verification cache entry {}", key);
+  return tvt(tvt::TV_UNKNOWN);
+}
+
+void verification_cachet::store(const std::string &key, bool holds) const
+{
+  // Write to a private file first and rename it into place, so that
+  // concurrent runs sharing the directory never see a partial entry
+  boost::filesystem::path entry = boost::filesystem::path(dir) / key;
+  boost::filesystem::path tmp =
+    boost::filesystem::path(dir) /
+    boost::filesystem::unique_path(key + "-%%%%-%%%%.tmp");
+  {
+    std::ofstream out(tmp.string());
+    out << (holds ? "holds" : "fails") << "\n";
+    if (!out)
+    {
+      log_warning("Could not write verification cache entry {}", key);
+      return;
+    }
+  }
+
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp, entry, ec);
+  if (ec)
+    boost::filesystem::remove(tmp, ec);
+}
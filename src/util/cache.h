@@ -1,8 +1,13 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <util/algorithms.h>
+#include <util/options.h>
+#include <util/threeval.h>
 #include <util/time_stopping.h>
 #include <util/crypto_hash.h>
 #include <util/cache_defs.h>
@@ -38,3 +43,36 @@ private:
   BigInt hits = 0;
   BigInt total = 0;
 };
+
+/**
+ * @Brief On-disk store of verdicts for sliced claims, shared between runs
+ *        (and processes) through a directory with one file per claim.
+ *
+ *        A claim is identified by a hash of the non-ignored steps of its
+ *        sliced equation, together with the ESBMC version and the options
+ *        that affect the encoding. SSA symbols are numbered by order of
+ *        first occurrence before hashing, so that the key does not depend
+ *        on the L1/L2 counters of the symbolic execution that produced it.
+ */
+class verification_cachet
+{
+public:
+  verification_cachet(const std::string &dir, const optionst &options);
+
+  /// Hash of the claim left in \p steps, usable with lookup() and store().
+  /// A step takes part unless its bit in \p ignored is set.
+  std::string key(
+    const symex_target_equationt::SSA_stepst &steps,
+    const std::vector<bool> &ignored) const;
+
+  /// TV_TRUE if the claim is known to hold, TV_FALSE if it is known to
+  /// fail, TV_UNKNOWN if it is not in the cache
+  tvt lookup(const std::string &key) const;
+
+  void store(const std::string &key, bool holds) const;
+
+protected:
+  std::string dir;
+  /// hash of everything besides the formula that the verdict depends on
+  std::string options_key;
+};
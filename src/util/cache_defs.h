@@ -1,4 +1,5 @@
 #pragma once
+#include <boost/functional/hash.hpp>
 #include <irep2/irep2.h>
 
 // This header will prevent the dependency hell
@@ -14,14 +15,10 @@ struct hash<assert_pair>
 {
   auto operator()(const assert_pair &p) const -> size_t
   {
-    const expr2tc &e1 = p.first;
-    const expr2tc &e2 = p.second;
-    crypto_hash h1, h2;
-    e1->hash(h1);
-    h1.fin();
-    e2->hash(h2);
-    h2.fin();
-    return h1.to_size_t() ^ h2.to_size_t();
+    // The crc is cached in the nodes, unlike a crypto_hash
+    size_t seed = p.first.crc();
+    boost::hash_combine(seed, p.second.crc());
+    return seed;
   }
 };
 } // namespace std
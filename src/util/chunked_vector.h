@@ -0,0 +1,315 @@
+#ifndef UTIL_CHUNKED_VECTOR_H_
+#define UTIL_CHUNKED_VECTOR_H_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * A sequence stored in fixed size chunks that are shared between copies.
+ *
+ * Elements never move once appended, so references to them stay valid
+ * while the sequence grows, and indexing is O(1). Copying the sequence only
+ * copies one pointer per chunk: a chunk is duplicated the first time a
+ * copy writes to it. Writing means any non-const access, including
+ * dereferencing a non-const iterator; read through a const reference to
+ * keep the chunks shared.
+ *
+ * Iterators are (sequence, index) pairs, they remain valid across push_back
+ * but, like the indices they are made of, not across erase.
+ */
+template <class T, unsigned ChunkBits = 10>
+class chunked_vectort
+{
+  static constexpr size_t chunk_size = size_t(1) << ChunkBits;
+  static constexpr size_t chunk_mask = chunk_size - 1;
+
+  // Reserved to chunk_size up front, so that it never reallocates
+  typedef std::vector<T> chunkt;
+
+  template <bool Const>
+  class basic_iterator
+  {
+    typedef std::conditional_t<Const, const chunked_vectort, chunked_vectort>
+      containert;
+
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::conditional_t<Const, const T *, T *> pointer;
+    typedef std::conditional_t<Const, const T &, T &> reference;
+
+    basic_iterator() = default;
+
+    basic_iterator(containert *c, size_t i) : c(c), i(i)
+    {
+    }
+
+    // Any iterator converts to a const_iterator
+    template <bool C, class = std::enable_if_t<Const && !C>>
+    basic_iterator(const basic_iterator<C> &other) : c(other.c), i(other.i)
+    {
+    }
+
+    reference operator*() const
+    {
+      return (*c)[i];
+    }
+
+    pointer operator->() const
+    {
+      return &(*c)[i];
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return (*c)[i + n];
+    }
+
+    basic_iterator &operator++()
+    {
+      ++i;
+      return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+      return basic_iterator(c, i++);
+    }
+
+    basic_iterator &operator--()
+    {
+      --i;
+      return *this;
+    }
+
+    basic_iterator operator--(int)
+    {
+      return basic_iterator(c, i--);
+    }
+
+    basic_iterator &operator+=(difference_type n)
+    {
+      i += n;
+      return *this;
+    }
+
+    basic_iterator &operator-=(difference_type n)
+    {
+      i -= n;
+      return *this;
+    }
+
+    basic_iterator operator+(difference_type n) const
+    {
+      return basic_iterator(c, i + n);
+    }
+
+    basic_iterator operator-(difference_type n) const
+    {
+      return basic_iterator(c, i - n);
+    }
+
+    template <bool C>
+    difference_type operator-(const basic_iterator<C> &other) const
+    {
+      return difference_type(i) - difference_type(other.i);
+    }
+
+    template <bool C>
+    bool operator==(const basic_iterator<C> &other) const
+    {
+      return i == other.i;
+    }
+
+    template <bool C>
+    bool operator!=(const basic_iterator<C> &other) const
+    {
+      return i != other.i;
+    }
+
+    template <bool C>
+    bool operator<(const basic_iterator<C> &other) const
+    {
+      return i < other.i;
+    }
+
+    template <bool C>
+    bool operator>(const basic_iterator<C> &other) const
+    {
+      return i > other.i;
+    }
+
+    template <bool C>
+    bool operator<=(const basic_iterator<C> &other) const
+    {
+      return i <= other.i;
+    }
+
+    template <bool C>
+    bool operator>=(const basic_iterator<C> &other) const
+    {
+      return i >= other.i;
+    }
+
+    /** Position of the element in the sequence. */
+    size_t index() const
+    {
+      return i;
+    }
+
+  private:
+    friend class chunked_vectort;
+    template <bool>
+    friend class basic_iterator;
+
+    containert *c = nullptr;
+    size_t i = 0;
+  };
+
+public:
+  typedef T value_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef size_t size_type;
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  size_t size() const
+  {
+    return num_elements;
+  }
+
+  bool empty() const
+  {
+    return num_elements == 0;
+  }
+
+  void clear()
+  {
+    chunks.clear();
+    num_elements = 0;
+  }
+
+  const T &operator[](size_t i) const
+  {
+    return (*chunks[i >> ChunkBits])[i & chunk_mask];
+  }
+
+  T &operator[](size_t i)
+  {
+    return own(i >> ChunkBits)[i & chunk_mask];
+  }
+
+  const T &front() const
+  {
+    return (*this)[0];
+  }
+
+  T &front()
+  {
+    return (*this)[0];
+  }
+
+  const T &back() const
+  {
+    return (*this)[num_elements - 1];
+  }
+
+  T &back()
+  {
+    return (*this)[num_elements - 1];
+  }
+
+  iterator begin()
+  {
+    return iterator(this, 0);
+  }
+
+  iterator end()
+  {
+    return iterator(this, num_elements);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(this, num_elements);
+  }
+
+  template <class... Args>
+  T &emplace_back(Args &&...args)
+  {
+    if ((num_elements & chunk_mask) == 0)
+    {
+      chunks.push_back(std::make_shared<chunkt>());
+      chunks.back()->reserve(chunk_size);
+    }
+    chunkt &chunk = own(chunks.size() - 1);
+    chunk.emplace_back(std::forward<Args>(args)...);
+    ++num_elements;
+    return chunk.back();
+  }
+
+  void push_back(const T &t)
+  {
+    emplace_back(t);
+  }
+
+  void push_back(T &&t)
+  {
+    emplace_back(std::move(t));
+  }
+
+  void pop_back()
+  {
+    own(chunks.size() - 1).pop_back();
+    if ((--num_elements & chunk_mask) == 0)
+      chunks.pop_back();
+  }
+
+  /** Removes [first, last), moving the elements after it down. Returns an
+   *  iterator to the element that followed the removed ones. */
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    size_t to = first.i;
+    for (size_t from = last.i; from < num_elements; ++from, ++to)
+      (*this)[to] = std::move((*this)[from]);
+    while (num_elements > to)
+      pop_back();
+    return iterator(this, first.i);
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+private:
+  std::vector<std::shared_ptr<chunkt>> chunks;
+  size_t num_elements = 0;
+
+  // Make chunk c private to this sequence, copying it if it's shared
+  chunkt &own(size_t c)
+  {
+    std::shared_ptr<chunkt> &chunk = chunks[c];
+    if (chunk.use_count() > 1)
+    {
+      auto copy = std::make_shared<chunkt>();
+      copy->reserve(chunk_size);
+      copy->insert(copy->end(), chunk->begin(), chunk->end());
+      chunk = std::move(copy);
+    }
+    return *chunk;
+  }
+};
+
+#endif
@@ -128,6 +128,9 @@ bool configt::set(const cmdlinet &cmdline)
   if (cmdline.isset("force"))
     ansi_c.forces = cmdline.get_values("force");
 
+  if (cmdline.isset("frontend-pch-include"))
+    ansi_c.pch_includes = cmdline.get_values("frontend-pch-include");
+
   if (cmdline.isset("warning"))
     ansi_c.warnings = cmdline.get_values("warning");
 
@@ -106,6 +106,7 @@ public:
     std::list<std::string> include_paths;
     std::list<std::string> idirafter_paths;
     std::list<std::string> forces;
+    std::list<std::string> pch_includes;
     std::list<std::string> warnings;
 
     typedef enum
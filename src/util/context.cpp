@@ -1,3 +1,5 @@
+#include <cctype>
+#include <cstdlib>
 #include <util/context.h>
 #include <util/message.h>
 #include <util/message/format.h>
@@ -11,6 +13,7 @@ bool contextt::add(const symbolt &symbol)
     return true;
 
   symbol_base_map.insert(std::pair<irep_idt, irep_idt>(symbol.name, symbol.id));
+  index_suffixes(symbol.id);
 
   ordered_symbols.push_back(&result.first->second);
   return false;
@@ -29,6 +32,7 @@ bool contextt::move(symbolt &symbol, symbolt *&new_symbol)
   }
 
   symbol_base_map.insert(std::pair<irep_idt, irep_idt>(symbol.name, symbol.id));
+  index_suffixes(symbol.id);
 
   ordered_symbols.push_back(&result.first->second);
 
@@ -75,9 +79,46 @@ void contextt::erase_symbol(irep_idt name)
       ordered_symbols.end(),
       [&name](const symbolt *s) { return s->id == name; }),
     ordered_symbols.end());
+  unindex_suffixes(name);
   symbols.erase(it);
 }
 
+unsigned contextt::get_max(const std::string &prefix) const
+{
+  auto it = suffix_index.find(prefix);
+  if (it == suffix_index.end())
+    return 0;
+  return *it->second.rbegin();
+}
+
+// Start of the run of digits ending id
+static size_t suffix_start(const std::string &id)
+{
+  size_t start = id.size();
+  while (start > 0 && isdigit(static_cast<unsigned char>(id[start - 1])))
+    --start;
+  return start;
+}
+
+void contextt::index_suffixes(const irep_idt &id)
+{
+  const std::string &s = id2string(id);
+  for (size_t i = suffix_start(s); i < s.size(); i++)
+    suffix_index[s.substr(0, i)].insert(atoi(s.c_str() + i));
+}
+
+void contextt::unindex_suffixes(const irep_idt &id)
+{
+  const std::string &s = id2string(id);
+  for (size_t i = suffix_start(s); i < s.size(); i++)
+  {
+    auto it = suffix_index.find(s.substr(0, i));
+    it->second.erase(it->second.find(atoi(s.c_str() + i)));
+    if (it->second.empty())
+      suffix_index.erase(it);
+  }
+}
+
 void contextt::foreach_operand_impl_const(const_symbol_delegate &expr) const
 {
   for (const auto &symbol : symbols)
@@ -4,6 +4,9 @@
 #include <functional>
 
 #include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
 #include <util/config.h>
 #include <util/symbol.h>
 #include <util/type.h>
@@ -74,6 +77,7 @@ public:
     symbols.clear();
     symbol_base_map.clear();
     ordered_symbols.clear();
+    suffix_index.clear();
   }
 
   DUMP_METHOD void dump() const;
@@ -83,6 +87,7 @@ public:
     symbols.swap(other.symbols);
     symbol_base_map.swap(other.symbol_base_map);
     ordered_symbols.swap(other.ordered_symbols);
+    suffix_index.swap(other.suffix_index);
   }
 
   symbolt *find_symbol(const char *name)
@@ -94,6 +99,12 @@ public:
 
   void erase_symbol(irep_idt name);
 
+  /**
+   * Largest number that, appended to \p prefix, gives the id of a symbol,
+   * or 0 if there is none. Takes time linear in the length of the prefix.
+   */
+  unsigned get_max(const std::string &prefix) const;
+
   template <typename T>
   void foreach_operand_in_order(T &&t) const
   {
@@ -131,6 +142,13 @@ private:
   symbolst symbols;
   ordered_symbolst ordered_symbols;
 
+  // The numbers ending each symbol id, keyed by what precedes them: "x_12"
+  // is listed as 12 under "x_" and as 2 under "x_1"
+  std::unordered_map<std::string, std::multiset<unsigned>> suffix_index;
+
+  void index_suffixes(const irep_idt &id);
+  void unindex_suffixes(const irep_idt &id);
+
   void foreach_operand_impl_const(const_symbol_delegate &expr) const;
   void foreach_operand_impl(symbol_delegate &expr);
 
@@ -1,6 +1,8 @@
 #include <util/filesystem.h>
 #include <boost/filesystem.hpp>
 #include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 using namespace file_operations;
 
@@ -142,4 +144,61 @@ void file_operations::create_path_and_write(
     boost::filesystem::create_directories(p.parent_path());
 
   std::ofstream(path).write(s, n);
-}
\ No newline at end of file
+}
+
+std::string file_operations::virtual_dir(const std::string &name)
+{
+  static const boost::filesystem::path root =
+    boost::filesystem::temp_directory_path() / "esbmc-virtual";
+  return (root / name).generic_string();
+}
+
+namespace
+{
+struct virtual_filest
+{
+  std::mutex mutex;
+  std::unordered_map<std::string, std::string_view> by_path;
+  std::vector<std::pair<std::string, std::string_view>> in_order;
+};
+} // namespace
+
+static virtual_filest &virtual_files_()
+{
+  static virtual_filest files;
+  return files;
+}
+
+void file_operations::add_virtual_file(
+  const std::string &path,
+  const char *s,
+  size_t n)
+{
+  virtual_filest &files = virtual_files_();
+  std::lock_guard lock(files.mutex);
+  if (files.by_path.emplace(path, std::string_view(s, n)).second)
+    files.in_order.emplace_back(path, std::string_view(s, n));
+}
+
+std::vector<std::pair<std::string, std::string_view>>
+file_operations::virtual_files(size_t from)
+{
+  virtual_filest &files = virtual_files_();
+  std::lock_guard lock(files.mutex);
+  if (from >= files.in_order.size())
+    return {};
+  return {files.in_order.begin() + from, files.in_order.end()};
+}
+
+bool file_operations::get_virtual_file(
+  const std::string &path,
+  std::string_view &contents)
+{
+  virtual_filest &files = virtual_files_();
+  std::lock_guard lock(files.mutex);
+  auto it = files.by_path.find(path);
+  if (it == files.by_path.end())
+    return false;
+  contents = it->second;
+  return true;
+}
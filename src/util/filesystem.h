@@ -2,6 +2,9 @@
 
 #include <cstdio> /* FILE */
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 /**
  * @brief this file will contains helper functions for manipulating
@@ -109,4 +112,41 @@ tmp_path create_tmp_dir(const std::string &format = "esbmc.%%%%-%%%%-%%%%");
  * contents
  */
 void create_path_and_write(const std::string &path, const char *s, size_t n);
+
+/**
+ * @brief Absolute path of a directory that only exists in memory
+ *
+ * The files bundled into ESBMC (clang's headers, the internal libc headers,
+ * ...) are registered below such directories with add_virtual_file() instead
+ * of being written out, and the clang frontends see them through an in-memory
+ * file system layered on top of the real one. The path is under the temporary
+ * directory so that it is absolute on every platform, but nothing is created
+ * there.
+ *
+ * @param name The name of the directory, unique per bundle
+ */
+std::string virtual_dir(const std::string &name);
+
+/**
+ * @brief Registers a file that only exists in memory
+ *
+ * The contents are not copied, they must outlive the process, which the
+ * buffers generated by the build system do. Registering a path twice keeps
+ * the first contents. May be called from several threads.
+ */
+void add_virtual_file(const std::string &path, const char *s, size_t n);
+
+/**
+ * @brief The files registered by add_virtual_file(), in order of
+ *        registration, starting from the from-th one
+ */
+std::vector<std::pair<std::string, std::string_view>>
+virtual_files(size_t from = 0);
+
+/**
+ * @brief Looks up the contents of a file registered by add_virtual_file()
+ *
+ * @return false if no file was registered at path
+ */
+bool get_virtual_file(const std::string &path, std::string_view &contents);
 } // namespace file_operations
@@ -45,8 +45,6 @@ void irept::detatch()
   {
     dt *old_data(data);
     data = new dt(*old_data);
-
-    data->ref_count = 1;
     remove_ref(old_data);
   }
 
@@ -72,11 +70,8 @@ void irept::remove_ref(dt *old_data)
 
   assert(old_data->ref_count != 0);
 
-  old_data->ref_count--;
-  if (old_data->ref_count == 0)
-  {
+  if (old_data->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
     delete old_data;
-  }
 }
 #endif
 
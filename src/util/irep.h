@@ -1,6 +1,7 @@
 #ifndef CPROVER_IREP_H
 #define CPROVER_IREP_H
 
+#include <atomic>
 #include <cassert>
 #include <list>
 #include <map>
@@ -66,7 +67,7 @@ public:
     if (data != nullptr)
     {
       assert(data->ref_count != 0);
-      data->ref_count++;
+      data->ref_count.fetch_add(1, std::memory_order_relaxed);
     }
   }
 
@@ -77,7 +78,7 @@ public:
     tmp = data;
     data = irep.data;
     if (data != nullptr)
-      data->ref_count++;
+      data->ref_count.fetch_add(1, std::memory_order_relaxed);
     remove_ref(tmp);
     return *this;
   }
@@ -1288,7 +1289,9 @@ public:
   {
   public:
 #ifdef SHARING
-    unsigned ref_count;
+    // Atomic so that threads may share (and drop) the same nodes, e.g. the
+    // goto program read by every parallel k-induction worker
+    std::atomic<unsigned> ref_count;
 #endif
 
     dstring data;
@@ -1317,6 +1320,16 @@ public:
     dt() : ref_count(1)
     {
     }
+
+    // A copy is a fresh, unshared node
+    dt(const dt &d)
+      : ref_count(1),
+        data(d.data),
+        named_sub(d.named_sub),
+        comments(d.comments),
+        sub(d.sub)
+    {
+    }
 #else
     dt()
     {
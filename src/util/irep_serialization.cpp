@@ -131,10 +131,11 @@ void write_string(std::ostream &out, const std::string &s)
 
 dstring irep_serializationt::read_string(std::istream &in)
 {
-  char c;
+  int c;
   unsigned i = 0;
 
-  while ((c = in.get()) != 0)
+  // Stop at the end of the stream too, so that truncated input ends the string
+  while ((c = in.get()) != 0 && c != std::istream::traits_type::eof())
   {
     if (i >= read_buffer.size())
       read_buffer.resize(read_buffer.size() * 2, 0);
@@ -43,6 +43,26 @@ public:
   // type check a module in the currently parsed file
   virtual bool typecheck(contextt &context, const std::string &module) = 0;
 
+  // Languages whose files are converted independently of each other return
+  // true, and then typecheck() must be the same as convert() followed by
+  // link(). This lets language_filest convert several files at once.
+  virtual bool separate_conversion() const
+  {
+    return false;
+  }
+
+  // convert the currently parsed file into a context of its own
+  virtual bool convert(contextt &)
+  {
+    return true;
+  }
+
+  // link a context made by convert() into context
+  virtual bool link(contextt &, contextt &, const std::string &)
+  {
+    return true;
+  }
+
   // language id / description
   virtual std::string id() const
   {
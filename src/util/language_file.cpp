@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <util/language.h>
 #include <util/language_file.h>
 #include <util/message.h>
@@ -21,8 +26,60 @@ void language_filest::show_parse(std::ostream &out)
     it.second.language->show_parse(out);
 }
 
-bool language_filest::parse()
+/* Runs job(i) for every i below n, on up to `jobs` threads. Jobs return true
+ * on error, after which no further jobs are started. Returns the index of the
+ * first failed job, or n if there is none. */
+template <typename F>
+static size_t run_jobs(size_t n, unsigned jobs, F &&job)
 {
+  if (jobs <= 1 || n <= 1)
+  {
+    for (size_t i = 0; i < n; i++)
+      if (job(i))
+        return i;
+    return n;
+  }
+
+  std::vector<char> failed(n, false);
+  std::atomic_bool stop = false;
+  std::atomic_size_t next_job = 0;
+  std::exception_ptr error;
+  std::mutex error_mutex;
+
+  auto worker = [&]() {
+    for (size_t i = next_job++; i < n && !stop; i = next_job++)
+    {
+      try
+      {
+        failed[i] = job(i);
+      }
+      catch (...)
+      {
+        std::lock_guard lock(error_mutex);
+        if (!error)
+          error = std::current_exception();
+        failed[i] = true;
+      }
+      if (failed[i])
+        stop = true;
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t i = 0; i < std::min<size_t>(jobs, n); i++)
+    pool.emplace_back(worker);
+  for (std::thread &t : pool)
+    t.join();
+
+  if (error)
+    std::rethrow_exception(error);
+
+  return std::find(failed.begin(), failed.end(), true) - failed.begin();
+}
+
+bool language_filest::parse(unsigned jobs)
+{
+  std::vector<filemapt::value_type *> files;
   for (auto &it : filemap)
   {
     // Check that file exists
@@ -35,25 +92,30 @@ bool language_filest::parse()
       return true;
     }
 
-    // parse it
+    files.push_back(&it);
+  }
 
-    languaget &language = *(it.second.language);
+  // parse them, each into its own languaget
 
-    if (language.parse(it.first))
-    {
-      log_error("Parsing of {} failed", it.first);
-      return true;
-    }
+  size_t failed = run_jobs(files.size(), jobs, [&files](size_t i) {
+    return files[i]->second.language->parse(files[i]->first);
+  });
 
-    // what is provided?
-
-    it.second.get_modules();
+  if (failed < files.size())
+  {
+    log_error("Parsing of {} failed", files[failed]->first);
+    return true;
   }
 
+  // what is provided?
+
+  for (auto *it : files)
+    it->second.get_modules();
+
   return false;
 }
 
-bool language_filest::typecheck(contextt &context)
+bool language_filest::typecheck(contextt &context, unsigned jobs)
 {
 // typecheck interfaces
 #if 0
@@ -80,13 +142,41 @@ bool language_filest::typecheck(contextt &context)
     }
   }
 
+  // With several jobs, the files that allow it are first converted into
+  // contexts of their own in parallel, and then linked in the usual order
+
+  std::vector<languaget *> separate;
+  if (jobs > 1)
+    for (auto &it : filemap)
+    {
+      languaget *language = it.second.language;
+      if (it.second.modules.empty() && language->separate_conversion())
+        separate.push_back(language);
+    }
+
+  std::vector<contextt> converted(separate.size());
+  if (
+    run_jobs(separate.size(), jobs, [&separate, &converted](size_t i) {
+      return separate[i]->convert(converted[i]);
+    }) < separate.size())
+    return true;
+
   // typecheck files
 
+  size_t next = 0;
   for (auto &it : filemap)
   {
-    if (it.second.modules.empty())
-      if (it.second.language->typecheck(context, ""))
+    if (!it.second.modules.empty())
+      continue;
+
+    languaget &language = *it.second.language;
+    if (next < separate.size() && separate[next] == &language)
+    {
+      if (language.link(context, converted[next++], ""))
         return true;
+    }
+    else if (language.typecheck(context, ""))
+      return true;
   }
 
   // typecheck modules
@@ -48,11 +48,14 @@ public:
     filemap.clear();
   }
 
-  bool parse();
+  /// Parses all files, on up to jobs threads
+  bool parse(unsigned jobs = 1);
 
   void show_parse(std::ostream &out);
 
-  bool typecheck(contextt &context);
+  /// Typechecks all files into context. Files whose language allows it are
+  /// converted on up to jobs threads, and linked in order afterwards.
+  bool typecheck(contextt &context, unsigned jobs = 1);
 
   bool final(contextt &context);
 
@@ -19,9 +19,18 @@
 // Why is this a global? Because there are over three hundred call sites to
 // migrate_expr, and it's a huge task to fix them all up to pass a namespace
 // down.
-const namespacet *migrate_namespace_lookup = nullptr;
+static const namespacet *program_namespace = nullptr;
+thread_local const namespacet *migrate_namespace_lookup = program_namespace;
 
-static std::map<irep_idt, BigInt> bin2int_map_signed, bin2int_map_unsigned;
+void set_migrate_namespace(const namespacet *ns)
+{
+  program_namespace = ns;
+  migrate_namespace_lookup = ns;
+}
+
+// Per thread, as symex and the frontends migrate on several threads at once
+static thread_local std::map<irep_idt, BigInt> bin2int_map_signed,
+  bin2int_map_unsigned;
 
 const BigInt &binary2bigint(irep_idt binary, bool is_signed)
 {
@@ -11,7 +11,11 @@
 
 // Don't ask
 class namespacet;
-extern const namespacet *migrate_namespace_lookup;
+// Per thread, so that a thread may switch to a namespace of its own for a
+// while (see dereferencet::make_failed_symbol). Threads start out with the
+// namespace last given to set_migrate_namespace().
+extern thread_local const namespacet *migrate_namespace_lookup;
+void set_migrate_namespace(const namespacet *ns);
 
 type2tc migrate_type(const typet &type);
 void migrate_expr(const exprt &expr, expr2tc &new_expr);
@@ -1,18 +1,10 @@
 #include <cassert>
-#include <cstring>
 #include <util/namespace.h>
 #include <util/message.h>
 
 unsigned namespacet::get_max(const std::string &prefix) const
 {
-  unsigned max_nr = 0;
-
-  context->foreach_operand([&prefix, &max_nr](const symbolt &s) {
-    if (!strncmp(s.id.c_str(), prefix.c_str(), prefix.size()))
-      max_nr = std::max(unsigned(atoi(s.id.c_str() + prefix.size())), max_nr);
-  });
-
-  return max_nr;
+  return context->get_max(prefix);
 }
 
 const symbolt *namespacet::lookup(const irep_idt &name) const
@@ -0,0 +1,488 @@
+#ifndef UTIL_PERSISTENT_MAP_H_
+#define UTIL_PERSISTENT_MAP_H_
+
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * A hash map with structural sharing: a hash array mapped trie whose nodes
+ * and entries are reference counted. Copying a map is O(1) and the copies
+ * share everything until one of them is written to, which then only copies
+ * the path from the root to the entry it changes.
+ *
+ * Lookups, insertion and erasure are O(log32 n). Entries are handed out by
+ * const reference only; mutable access goes through operator[] and insert,
+ * which make the entry private to this map first.
+ *
+ * for_each_difference compares two maps that have a common ancestor while
+ * skipping every subtree they still share, so its cost is proportional to
+ * the number of entries written since they were copied.
+ */
+template <
+  class Key,
+  class T,
+  class Hash = std::hash<Key>,
+  class KeyEqual = std::equal_to<Key>>
+class persistent_mapt
+{
+public:
+  typedef Key key_type;
+  typedef T mapped_type;
+  typedef std::pair<const Key, T> value_type;
+
+private:
+  typedef std::shared_ptr<value_type> leaf_ptrt;
+
+  struct nodet;
+  typedef std::shared_ptr<nodet> node_ptrt;
+
+  // Either a leaf or a child node
+  struct slott
+  {
+    size_t hash;
+    leaf_ptrt leaf;
+    node_ptrt child;
+  };
+
+  // Below max_shift a node holds one slot per set bit in bitmap; past it,
+  // where hashes are exhausted, it is a plain list of colliding leaves.
+  struct nodet
+  {
+    uint32_t bitmap = 0;
+    std::vector<slott> slots;
+  };
+
+  static constexpr unsigned bits_per_level = 5;
+  static constexpr unsigned max_shift = sizeof(size_t) * CHAR_BIT;
+
+  static unsigned popcount(uint32_t x)
+  {
+    return std::bitset<32>(x).count();
+  }
+
+  static uint32_t bit_of(size_t hash, unsigned shift)
+  {
+    return uint32_t(1) << ((hash >> shift) & 31);
+  }
+
+  // Position in n.slots of the slot for bit
+  static unsigned index_of(const nodet &n, uint32_t bit)
+  {
+    return popcount(n.bitmap & (bit - 1));
+  }
+
+public:
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename persistent_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      return *stack.back().first->slots[stack.back().second].leaf;
+    }
+
+    pointer operator->() const
+    {
+      return &**this;
+    }
+
+    const_iterator &operator++()
+    {
+      ++stack.back().second;
+      settle();
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      if (stack.empty() || other.stack.empty())
+        return stack.empty() == other.stack.empty();
+      return stack.back() == other.stack.back();
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return !(*this == other);
+    }
+
+  private:
+    friend class persistent_mapt;
+
+    // Path from the root, each node with the position of the slot taken
+    std::vector<std::pair<const nodet *, size_t>> stack;
+
+    // Moves forward until the top of the stack is a leaf, or the end
+    void settle()
+    {
+      while (!stack.empty())
+      {
+        auto &[node, pos] = stack.back();
+        if (pos == node->slots.size())
+        {
+          stack.pop_back();
+          if (!stack.empty())
+            ++stack.back().second;
+        }
+        else if (node->slots[pos].child)
+          stack.emplace_back(node->slots[pos].child.get(), 0);
+        else
+          return;
+      }
+    }
+  };
+
+  typedef const_iterator iterator;
+
+  persistent_mapt() = default;
+
+  size_t size() const
+  {
+    return num_entries;
+  }
+
+  bool empty() const
+  {
+    return num_entries == 0;
+  }
+
+  void clear()
+  {
+    root.reset();
+    num_entries = 0;
+  }
+
+  const_iterator begin() const
+  {
+    const_iterator it;
+    if (root)
+    {
+      it.stack.emplace_back(root.get(), 0);
+      it.settle();
+    }
+    return it;
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+  const_iterator find(const Key &key) const
+  {
+    const_iterator it;
+    const size_t hash = Hash()(key);
+    const nodet *n = root.get();
+    for (unsigned shift = 0; n != nullptr; shift += bits_per_level)
+    {
+      size_t pos;
+      if (shift >= max_shift)
+      {
+        for (pos = 0; pos < n->slots.size(); pos++)
+          if (KeyEqual()(n->slots[pos].leaf->first, key))
+            break;
+        if (pos == n->slots.size())
+          return end();
+      }
+      else
+      {
+        uint32_t bit = bit_of(hash, shift);
+        if (!(n->bitmap & bit))
+          return end();
+        pos = index_of(*n, bit);
+      }
+
+      it.stack.emplace_back(n, pos);
+      const slott &s = n->slots[pos];
+      if (!s.child)
+      {
+        if (s.hash != hash || !KeyEqual()(s.leaf->first, key))
+          return end();
+        return it;
+      }
+      n = s.child.get();
+    }
+    return end();
+  }
+
+  size_t count(const Key &key) const
+  {
+    return find(key) != end();
+  }
+
+  /** Returns the value for key, default constructing it if there is none. */
+  T &operator[](const Key &key)
+  {
+    bool inserted;
+    return locate(key, inserted, [&key] { return value_type(key, T()); })
+      .second;
+  }
+
+  /** Adds v unless its key is already present. Returns the (mutable) value
+   *  stored for the key and whether v was inserted. */
+  std::pair<T *, bool> insert(const value_type &v)
+  {
+    bool inserted;
+    T &t = locate(v.first, inserted, [&v] { return v; }).second;
+    return {&t, inserted};
+  }
+
+  size_t erase(const Key &key)
+  {
+    // Don't unshare anything unless there really is something to remove
+    if (find(key) == end())
+      return 0;
+    erase_rec(root, Hash()(key), 0, key);
+    if (root->slots.empty())
+      root.reset();
+    --num_entries;
+    return 1;
+  }
+
+  /** Calls f(key, mine, theirs) for every key whose entry differs between
+   *  this map and `other`, where mine and theirs point to the respective
+   *  values or are null when the key is absent from that map. Entries and
+   *  subtrees shared by both maps are skipped without being looked at. */
+  template <class F>
+  void for_each_difference(const persistent_mapt &other, F f) const
+  {
+    diff_nodes(root.get(), other.root.get(), 0, f);
+  }
+
+private:
+  node_ptrt root;
+  size_t num_entries = 0;
+
+  // Make n private to this map, copying it if it's shared
+  static nodet &own(node_ptrt &n)
+  {
+    if (!n)
+      n = std::make_shared<nodet>();
+    else if (n.use_count() > 1)
+      n = std::make_shared<nodet>(*n);
+    return *n;
+  }
+
+  static value_type &own(leaf_ptrt &l)
+  {
+    if (l.use_count() > 1)
+      l = std::make_shared<value_type>(*l);
+    return *l;
+  }
+
+  // Put a slot into a node that doesn't have a slot for its hash yet
+  static void place(nodet &n, unsigned shift, slott s)
+  {
+    if (shift >= max_shift)
+    {
+      n.slots.push_back(std::move(s));
+      return;
+    }
+    uint32_t bit = bit_of(s.hash, shift);
+    n.slots.insert(n.slots.begin() + index_of(n, bit), std::move(s));
+    n.bitmap |= bit;
+  }
+
+  template <class Make>
+  value_type &locate(const Key &key, bool &inserted, const Make &make)
+  {
+    inserted = false;
+    value_type &v = locate_rec(root, Hash()(key), 0, key, inserted, make);
+    if (inserted)
+      ++num_entries;
+    return v;
+  }
+
+  template <class Make>
+  static value_type &locate_rec(
+    node_ptrt &np,
+    size_t hash,
+    unsigned shift,
+    const Key &key,
+    bool &inserted,
+    const Make &make)
+  {
+    nodet &n = own(np);
+
+    if (shift >= max_shift)
+    {
+      for (slott &s : n.slots)
+        if (KeyEqual()(s.leaf->first, key))
+          return own(s.leaf);
+    }
+    else if (n.bitmap & bit_of(hash, shift))
+    {
+      slott &s = n.slots[index_of(n, bit_of(hash, shift))];
+      if (s.child)
+        return locate_rec(
+          s.child, hash, shift + bits_per_level, key, inserted, make);
+
+      if (s.hash == hash && KeyEqual()(s.leaf->first, key))
+        return own(s.leaf);
+
+      // Push the leaf down into a new node, next to the new entry
+      s.child = std::make_shared<nodet>();
+      place(*s.child, shift + bits_per_level, {s.hash, std::move(s.leaf), {}});
+      return locate_rec(
+        s.child, hash, shift + bits_per_level, key, inserted, make);
+    }
+
+    leaf_ptrt leaf = std::make_shared<value_type>(make());
+    value_type &v = *leaf;
+    place(n, shift, {hash, std::move(leaf), {}});
+    inserted = true;
+    return v;
+  }
+
+  // The key must be present
+  static void
+  erase_rec(node_ptrt &np, size_t hash, unsigned shift, const Key &key)
+  {
+    nodet &n = own(np);
+
+    if (shift >= max_shift)
+    {
+      for (auto it = n.slots.begin(); it != n.slots.end(); ++it)
+        if (KeyEqual()(it->leaf->first, key))
+        {
+          n.slots.erase(it);
+          return;
+        }
+      return;
+    }
+
+    uint32_t bit = bit_of(hash, shift);
+    auto it = n.slots.begin() + index_of(n, bit);
+    if (it->child)
+    {
+      erase_rec(it->child, hash, shift + bits_per_level, key);
+      const nodet &child = *it->child;
+      // Pull a lone leaf back up, so that the trie stays canonical
+      if (child.slots.size() == 1 && !child.slots[0].child)
+        *it = child.slots[0];
+      return;
+    }
+
+    n.slots.erase(it);
+    n.bitmap &= ~bit;
+  }
+
+  template <class F>
+  static void for_each_leaf(const nodet *n, F &f)
+  {
+    for (const slott &s : n->slots)
+      if (s.child)
+        for_each_leaf(s.child.get(), f);
+      else
+        f(*s.leaf);
+  }
+
+  template <class F>
+  static void diff_nodes(const nodet *a, const nodet *b, unsigned shift, F &f)
+  {
+    if (a == b)
+      return;
+
+    if (a == nullptr || b == nullptr)
+    {
+      auto only = [&f, a](const value_type &v) {
+        if (a)
+          f(v.first, &v.second, nullptr);
+        else
+          f(v.first, nullptr, &v.second);
+      };
+      for_each_leaf(a ? a : b, only);
+      return;
+    }
+
+    if (shift >= max_shift)
+    {
+      for (const slott &sa : a->slots)
+      {
+        const slott *sb = nullptr;
+        for (const slott &s : b->slots)
+          if (KeyEqual()(s.leaf->first, sa.leaf->first))
+            sb = &s;
+        if (sb == nullptr)
+          f(sa.leaf->first, &sa.leaf->second, nullptr);
+        else if (sb->leaf != sa.leaf)
+          f(sa.leaf->first, &sa.leaf->second, &sb->leaf->second);
+      }
+      for (const slott &sb : b->slots)
+      {
+        bool in_a = false;
+        for (const slott &s : a->slots)
+          in_a = in_a || KeyEqual()(s.leaf->first, sb.leaf->first);
+        if (!in_a)
+          f(sb.leaf->first, nullptr, &sb.leaf->second);
+      }
+      return;
+    }
+
+    for (uint32_t bits = a->bitmap | b->bitmap; bits != 0; bits &= bits - 1)
+    {
+      uint32_t bit = bits & (~bits + 1);
+      const slott *sa =
+        (a->bitmap & bit) ? &a->slots[index_of(*a, bit)] : nullptr;
+      const slott *sb =
+        (b->bitmap & bit) ? &b->slots[index_of(*b, bit)] : nullptr;
+      diff_slots(sa, sb, shift + bits_per_level, f);
+    }
+  }
+
+  // Compares two slots at the same position, at the level below shift
+  template <class F>
+  static void
+  diff_slots(const slott *sa, const slott *sb, unsigned shift, F &f)
+  {
+    if (sa && sb && sa->leaf == sb->leaf && sa->child == sb->child)
+      return;
+
+    if (sa && sb && sa->leaf && sb->leaf)
+    {
+      if (sa->hash == sb->hash && KeyEqual()(sa->leaf->first, sb->leaf->first))
+        f(sa->leaf->first, &sa->leaf->second, &sb->leaf->second);
+      else
+      {
+        f(sa->leaf->first, &sa->leaf->second, nullptr);
+        f(sb->leaf->first, nullptr, &sb->leaf->second);
+      }
+      return;
+    }
+
+    // Otherwise compare them as subtrees, a lone leaf being a node of one
+    nodet wrap_a, wrap_b;
+    diff_nodes(
+      as_node(sa, shift, wrap_a), as_node(sb, shift, wrap_b), shift, f);
+  }
+
+  static const nodet *as_node(const slott *s, unsigned shift, nodet &wrap)
+  {
+    if (s == nullptr)
+      return nullptr;
+    if (s->child)
+      return s->child.get();
+    place(wrap, shift, *s);
+    return &wrap;
+  }
+};
+
+#endif
@@ -7,12 +7,93 @@
 #include <irep2/irep2.h>
 #include <irep2/irep2_utils.h>
 #include <util/type_byte_size.h>
+#include <unordered_map>
+#include <utility>
 
 expr2tc expr2t::do_simplify() const
 {
   return expr2tc();
 }
 
+/******************************** Memoisation *********************************/
+
+size_t irep2_simplify_cache_size = 1 << 16;
+
+namespace
+{
+/* Answers are kept in two generations. New ones go into the young
+ * generation, as do old ones when they're used again; once the young one
+ * holds half the capacity, the old one is dropped and the young one takes
+ * its place. That evicts roughly the least recently used half without any
+ * bookkeeping on hits. */
+class simplify_cachet
+{
+public:
+  bool find(const expr2tc &e, expr2tc &res)
+  {
+    auto it = young.find(e);
+    if (it != young.end())
+    {
+      ++stats.hits;
+      res = it->second;
+      return true;
+    }
+
+    it = old.find(e);
+    if (it == old.end())
+    {
+      ++stats.misses;
+      return false;
+    }
+
+    ++stats.hits;
+    res = it->second;
+    old.erase(it);
+    insert(e, res);
+    return true;
+  }
+
+  void insert(const expr2tc &e, const expr2tc &res)
+  {
+    if (young.size() >= std::max<size_t>(1, irep2_simplify_cache_size / 2))
+    {
+      stats.evicted += old.size();
+      old.clear();
+      old.swap(young);
+    }
+    young.emplace(e, res);
+  }
+
+  simplify_cache_statst stats;
+
+private:
+  typedef std::unordered_map<expr2tc, expr2tc, irep2_hash> mapt;
+  mapt young, old;
+};
+
+thread_local simplify_cachet simplify_cache;
+} // namespace
+
+simplify_cache_statst simplify_cache_stats()
+{
+  return simplify_cache.stats;
+}
+
+expr2tc simplify_cached(const expr2tc &e)
+{
+  // Leaves are quicker to simplify than to look up
+  if (irep2_simplify_cache_size == 0 || e->get_num_sub_exprs() == 0)
+    return e->simplify();
+
+  expr2tc res;
+  if (simplify_cache.find(e, res))
+    return res;
+
+  res = e->simplify();
+  simplify_cache.insert(e, res);
+  return res;
+}
+
 expr2tc expr2t::simplify() const
 {
   try
@@ -35,7 +116,7 @@ expr2tc expr2t::simplify() const
       // Woot, we simplified some of this. It may have _additional_ fields that
       // need to get simplified (member2ts in arrays for example), so invoke the
       // simplifier again, to hit those potential subfields.
-      expr2tc res2 = res->simplify();
+      expr2tc res2 = std::as_const(res).simplify();
 
       // If we simplified even further, return res2; otherwise res.
       if (is_nil_expr(res2))
@@ -0,0 +1,157 @@
+#ifndef UTIL_STATE_FINGERPRINT_H_
+#define UTIL_STATE_FINGERPRINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A 128-bit, non-cryptographic fingerprint of a set of elements.
+ *
+ * Each element is fingerprinted with of(), and the fingerprint of the set is
+ * the lane-wise sum of those of its elements. It doesn't depend on the order
+ * the elements were added in, and replacing one element is O(1): subtract
+ * its old fingerprint and add the new one.
+ */
+struct state_fingerprintt
+{
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  /** Fingerprint of an element identified by two words, e.g. key and value
+   *  hashes. Both lanes depend on both words, through different mixes. */
+  static state_fingerprintt of(uint64_t a, uint64_t b)
+  {
+    state_fingerprintt f;
+    f.lo = mix(a ^ mix(b + 0x9e3779b97f4a7c15ULL));
+    f.hi = mix(b ^ mix(a + 0xc2b2ae3d27d4eb4fULL));
+    return f;
+  }
+
+  state_fingerprintt &operator+=(const state_fingerprintt &other)
+  {
+    lo += other.lo;
+    hi += other.hi;
+    return *this;
+  }
+
+  state_fingerprintt &operator-=(const state_fingerprintt &other)
+  {
+    lo -= other.lo;
+    hi -= other.hi;
+    return *this;
+  }
+
+  bool operator==(const state_fingerprintt &other) const
+  {
+    return lo == other.lo && hi == other.hi;
+  }
+
+  bool operator!=(const state_fingerprintt &other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  // Finalizer of MurmurHash3, every input bit affects every output bit
+  static uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+  }
+};
+
+/**
+ * Set of fingerprints in a single flat table, with open addressing and
+ * linear probing. An all-zero slot is empty, so the zero fingerprint is
+ * tracked on the side. Fingerprints are already mixed, their low word is
+ * used as the hash.
+ */
+class fingerprint_sett
+{
+public:
+  /** Adds \p f, returns false if it was already in the set. */
+  bool insert(const state_fingerprintt &f)
+  {
+    if (is_zero(f))
+    {
+      bool inserted = !has_zero;
+      has_zero = true;
+      return inserted;
+    }
+
+    // Keep the load factor under 1/2, probe sequences stay short
+    if (2 * (num_slots_used + 1) > slots.size())
+      grow();
+
+    state_fingerprintt &slot = locate(f);
+    if (!is_zero(slot))
+      return false;
+
+    slot = f;
+    ++num_slots_used;
+    return true;
+  }
+
+  bool contains(const state_fingerprintt &f) const
+  {
+    if (is_zero(f))
+      return has_zero;
+
+    return !slots.empty() && !is_zero(locate(f));
+  }
+
+  size_t size() const
+  {
+    return num_slots_used + has_zero;
+  }
+
+  void clear()
+  {
+    slots.clear();
+    num_slots_used = 0;
+    has_zero = false;
+  }
+
+private:
+  std::vector<state_fingerprintt> slots;
+  size_t num_slots_used = 0;
+  bool has_zero = false;
+
+  static bool is_zero(const state_fingerprintt &f)
+  {
+    return f.lo == 0 && f.hi == 0;
+  }
+
+  // The slot holding f, or the empty slot where it would go
+  const state_fingerprintt &locate(const state_fingerprintt &f) const
+  {
+    const size_t mask = slots.size() - 1;
+    size_t i = f.lo & mask;
+    while (!is_zero(slots[i]) && slots[i] != f)
+      i = (i + 1) & mask;
+    return slots[i];
+  }
+
+  state_fingerprintt &locate(const state_fingerprintt &f)
+  {
+    return const_cast<state_fingerprintt &>(
+      static_cast<const fingerprint_sett *>(this)->locate(f));
+  }
+
+  void grow()
+  {
+    std::vector<state_fingerprintt> old;
+    old.swap(slots);
+    slots.resize(old.empty() ? 1024 : 2 * old.size());
+    for (const state_fingerprintt &f : old)
+      if (!is_zero(f))
+        locate(f) = f;
+  }
+};
+
+#endif
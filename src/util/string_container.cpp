@@ -15,32 +15,25 @@ bool string_ptrt::operator==(const string_ptrt &other) const
   return len == 0 || memcmp(s, other.s, len) == 0;
 }
 
-unsigned string_containert::get(const char *s)
+string_containert::~string_containert()
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-
-  if (it != hash_table.end())
-    return it->second;
-
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.emplace_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
+  for (size_t i = 0; i < max_chunks; i++)
+    delete[] chunks[i].load(std::memory_order_relaxed);
+}
 
-  return r;
+unsigned string_containert::get(const char *s)
+{
+  return insert(string_ptrt(s));
 }
 
 unsigned string_containert::get(const std::string &s)
 {
-  string_ptrt string_ptr(s);
+  return insert(string_ptrt(s));
+}
+
+unsigned string_containert::insert(const string_ptrt &string_ptr)
+{
+  std::lock_guard lock(mutex);
 
   hash_tablet::iterator it = hash_table.find(string_ptr);
 
@@ -48,15 +41,24 @@ unsigned string_containert::get(const std::string &s)
     return it->second;
 
   size_t r = hash_table.size();
+  assert(r < chunk_size * max_chunks);
 
   // these are stable
-  string_list.push_back(s);
+  string_list.emplace_back(string_ptr.s, string_ptr.len);
   string_ptrt result(string_list.back());
 
   hash_table[result] = r;
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  // publish the new string before its number becomes visible
+  std::atomic<const std::string **> &slot = chunks[r >> chunk_bits];
+  const std::string **chunk = slot.load(std::memory_order_relaxed);
+  if (!chunk)
+  {
+    chunk = new const std::string *[chunk_size];
+    slot.store(chunk, std::memory_order_release);
+  }
+  chunk[r & (chunk_size - 1)] = &string_list.back();
+  num_strings.store(r + 1, std::memory_order_release);
 
   return r;
 }
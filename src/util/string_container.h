@@ -1,11 +1,13 @@
 #ifndef STRING_CONTAINER_H
 #define STRING_CONTAINER_H
 
+#include <atomic>
 #include <cassert>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
-#include <vector>
 
 struct string_ptrt
 {
@@ -48,25 +50,26 @@ public:
     return get(s);
   }
 
-  string_containert()
+  string_containert() : chunks(new std::atomic<const std::string **>[max_chunks])
   {
+    for (size_t i = 0; i < max_chunks; i++)
+      chunks[i].store(nullptr, std::memory_order_relaxed);
+
     // allocate empty string -- this gets index 0
     get("");
   }
-  ~string_containert() = default;
+  ~string_containert();
 
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    assert(no < string_vector.size());
-    return string_vector[no]->c_str();
+    return lookup(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    assert(no < string_vector.size());
-    return *string_vector[no];
+    return lookup(no);
   }
 
 protected:
@@ -75,12 +78,29 @@ protected:
 
   unsigned get(const char *s);
   unsigned get(const std::string &s);
+  unsigned insert(const string_ptrt &string_ptr);
+
+  // Interning is serialised by this mutex, while lookups by number are
+  // lock-free: numbers index fixed-size chunks that are never moved once
+  // published, so readers on other threads never see a reallocation.
+  std::mutex mutex;
 
   typedef std::list<std::string> string_listt;
   string_listt string_list;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  static constexpr size_t chunk_bits = 16;
+  static constexpr size_t chunk_size = size_t(1) << chunk_bits;
+  static constexpr size_t max_chunks = size_t(1) << 16;
+  std::unique_ptr<std::atomic<const std::string **>[]> chunks;
+  std::atomic<size_t> num_strings = 0;
+
+  const std::string &lookup(size_t no) const
+  {
+    assert(no < num_strings.load(std::memory_order_acquire));
+    const std::string **chunk =
+      chunks[no >> chunk_bits].load(std::memory_order_acquire);
+    return *chunk[no & (chunk_size - 1)];
+  }
 };
 
 inline string_containert &get_string_container()
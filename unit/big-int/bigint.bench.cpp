@@ -0,0 +1,102 @@
+/*******************************************************************
+ Module: BigInt microbenchmark
+
+ Test Plan:
+   - Workloads typical of the simplifier and the interval domain,
+     which create, combine and compare many small constants
+
+ The benchmarks are hidden from the default test run, execute them
+ with `bigintbench "[!benchmark]"`.
+ \*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+#include <big-int/bigint.hh>
+#include <vector>
+
+namespace
+{
+const unsigned num_values = 4096;
+
+// Array indices, type widths and the like
+std::vector<BigInt> small_values()
+{
+  std::vector<BigInt> values;
+  for (unsigned i = 0; i < num_values; i++)
+    values.emplace_back(BigInt::llong_t(i * 7) - 1000);
+  return values;
+}
+
+// Bounds of 64-bit intervals
+std::vector<BigInt> wide_values()
+{
+  std::vector<BigInt> values;
+  for (unsigned i = 0; i < num_values; i++)
+    values.push_back(BigInt::power2(63) - i);
+  return values;
+}
+} // namespace
+
+TEST_CASE("bigint microbenchmark", "[bigint][!benchmark]")
+{
+  const std::vector<BigInt> small = small_values();
+  const std::vector<BigInt> wide = wide_values();
+
+  BENCHMARK("construct and destroy constants")
+  {
+    unsigned zeros = 0;
+    for (unsigned i = 0; i < num_values; i++)
+    {
+      BigInt b(i);
+      zeros += b.is_zero();
+    }
+    return zeros;
+  };
+
+  BENCHMARK("copy constants")
+  {
+    std::vector<BigInt> copy = small;
+    return copy.size();
+  };
+
+  BENCHMARK("fold additions and multiplications")
+  {
+    // Like simplifying (x + c1) * c2 over constants
+    BigInt sum;
+    for (unsigned i = 0; i + 1 < num_values; i++)
+      sum = (small[i] + small[i + 1]) * 3;
+    return sum.to_int64();
+  };
+
+  BENCHMARK("compare constants")
+  {
+    unsigned less = 0;
+    for (unsigned i = 0; i + 1 < num_values; i++)
+      less += small[i] < small[i + 1] && small[i] >= -1000;
+    return less;
+  };
+
+  BENCHMARK("join 64-bit interval bounds")
+  {
+    BigInt lower = wide[0], upper = wide[0];
+    for (const BigInt &b : wide)
+    {
+      if (b < lower)
+        lower = b;
+      if (b > upper)
+        upper = b;
+    }
+    return (upper - lower).to_uint64();
+  };
+
+  BENCHMARK("wrap around a bit-width")
+  {
+    // Like computing an unsigned overflow modulo 2^32
+    const BigInt modulus = BigInt::power2(32);
+    BigInt r;
+    for (unsigned i = 0; i < num_values; i++)
+      r = (wide[i] + small[i]) % modulus;
+    return r.to_uint64();
+  };
+}
@@ -0,0 +1,176 @@
+/*******************************************************************
+ Module: Goto binary unit test
+
+ Test Plan:
+   - Version 2 binaries read back into the program they were written from,
+     both from memory and from a mapped file
+   - Truncated and corrupt version 2 binaries are rejected
+ \*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+#include <irep2/irep2_utils.h>
+#include <util/arith_tools.h>
+#include <util/filesystem.h>
+#include <util/migrate.h>
+#include <util/namespace.h>
+#include <cstdio>
+#include <sstream>
+
+namespace
+{
+// int x = 5; void main() { x = x + 1; assert(x == 6); }
+void make_program(contextt &context, goto_functionst &functions)
+{
+  signedbv_typet int_type(32);
+
+  symbolt x;
+  x.id = "c:@x";
+  x.name = "x";
+  x.mode = "C";
+  x.type = int_type;
+  x.value = from_integer(5, int_type);
+  x.static_lifetime = true;
+  x.lvalue = true;
+  REQUIRE(!context.add(x));
+
+  code_typet main_type;
+  main_type.return_type() = empty_typet();
+
+  symbolt main;
+  main.id = "c:@F@main";
+  main.name = "main";
+  main.mode = "C";
+  main.type = main_type;
+  REQUIRE(!context.add(main));
+
+  goto_functiont &f = functions.function_map[main.id];
+  f.type = main_type;
+
+  type2tc int32 = get_int_type(32);
+  expr2tc sym = symbol2tc(int32, x.id);
+
+  goto_programt::targett i = f.body.add_instruction(ASSIGN);
+  i->code =
+    code_assign2tc(sym, add2tc(int32, sym, constant_int2tc(int32, BigInt(1))));
+  i = f.body.add_instruction(ASSERT);
+  i->guard = equality2tc(sym, constant_int2tc(int32, BigInt(6)));
+  f.body.add_instruction(END_FUNCTION);
+  f.body_available = true;
+
+  functions.update();
+}
+
+std::string write_program()
+{
+  contextt context;
+  goto_functionst functions;
+  namespacet ns(context);
+  set_migrate_namespace(&ns);
+  make_program(context, functions);
+
+  std::ostringstream out;
+  REQUIRE(!write_goto_binary(out, context, functions));
+  return out.str();
+}
+
+void require_same_program(
+  const contextt &context,
+  const goto_functionst &functions)
+{
+  contextt expected_context;
+  goto_functionst expected_functions;
+  make_program(expected_context, expected_functions);
+
+  REQUIRE(context.size() == expected_context.size());
+  expected_context.foreach_operand([&context](const symbolt &s) {
+    const symbolt *read = context.find_symbol(s.id);
+    REQUIRE(read != nullptr);
+    REQUIRE(read->type == s.type);
+    REQUIRE(read->value == s.value);
+    REQUIRE(read->static_lifetime == s.static_lifetime);
+  });
+
+  const goto_programt &body =
+    functions.function_map.at("c:@F@main").body;
+  const goto_programt &expected_body =
+    expected_functions.function_map.at("c:@F@main").body;
+  REQUIRE(body.instructions.size() == expected_body.instructions.size());
+
+  auto it = body.instructions.begin();
+  for (const auto &expected : expected_body.instructions)
+  {
+    REQUIRE(it->type == expected.type);
+    REQUIRE(it->code == expected.code);
+    REQUIRE(it->guard == expected.guard);
+    ++it;
+  }
+}
+
+bool read_program(const std::string &data)
+{
+  contextt context;
+  goto_functionst functions;
+  namespacet ns(context);
+  set_migrate_namespace(&ns);
+  return read_goto_binary_array(data.data(), data.size(), context, functions);
+}
+} // namespace
+
+SCENARIO("version 2 goto binaries", "[goto-programs][goto-binary]")
+{
+  GIVEN("A program written as a goto binary")
+  {
+    const std::string data = write_program();
+
+    THEN("It should be in the version 2 format")
+    {
+      REQUIRE(data.substr(0, 3) == "GBF");
+      REQUIRE(data.substr(3, 4) == std::string("\0\0\0\2", 4));
+    }
+
+    THEN("Reading it from memory should give the same program")
+    {
+      contextt context;
+      goto_functionst functions;
+      namespacet ns(context);
+      set_migrate_namespace(&ns);
+      REQUIRE(
+        !read_goto_binary_array(data.data(), data.size(), context, functions));
+      require_same_program(context, functions);
+    }
+
+    THEN("Reading it from a mapped file should give the same program")
+    {
+      file_operations::tmp_file file =
+        file_operations::create_tmp_file("esbmc-test-%%%%-%%%%.goto", "wb");
+      REQUIRE(fwrite(data.data(), 1, data.size(), file.file()) == data.size());
+      REQUIRE(fflush(file.file()) == 0);
+      const std::string &path = file.path();
+
+      contextt context;
+      goto_functionst functions;
+      namespacet ns(context);
+      set_migrate_namespace(&ns);
+      REQUIRE(!read_goto_binary(path, context, functions));
+      require_same_program(context, functions);
+    }
+
+    THEN("Truncated copies of it should be rejected")
+    {
+      REQUIRE(read_program(data.substr(0, 7)));
+      REQUIRE(read_program(data.substr(0, data.size() / 2)));
+      REQUIRE(read_program(data.substr(0, data.size() - 1)));
+    }
+
+    THEN("A copy with a section offset out of bounds should be rejected")
+    {
+      // Bytes 11 to 14 hold the offset of the irep pool
+      std::string corrupt = data;
+      corrupt.replace(11, 4, "\x7f\xff\xff\xff", 4);
+      REQUIRE(read_program(corrupt));
+    }
+  }
+}
@@ -3,6 +3,7 @@
 #include <irep2/irep2.h>
 #include <irep2/irep2_utils.h>
 #include <util/crypto_hash.h>
+#include <utility>
 
 namespace
 {
@@ -76,6 +77,19 @@ void test_constructed_differently(const expr2tc e1, const expr2tc e2)
   REQUIRE(c_hash.to_size_t() != c_hash2.to_size_t());
 }
 
+// Turns hash-consing on for as long as it lives, also when a check fails
+struct hash_consing_scopet
+{
+  hash_consing_scopet()
+  {
+    irep2_hash_consing = true;
+  }
+  ~hash_consing_scopet()
+  {
+    irep2_hash_consing = false;
+  }
+};
+
 } // namespace
 
 SCENARIO("irep2 hashing", "[core][irep2]")
@@ -115,3 +129,123 @@ SCENARIO("irep2 hashing", "[core][irep2]")
     }
   }
 }
+
+SCENARIO("irep2 hash-consing", "[core][irep2]")
+{
+  hash_consing_scopet hash_consing;
+
+  GIVEN("Expressions constructed in the same way")
+  {
+    expr2tc e1 = gen_testing_struct(1, 2);
+    expr2tc e2 = gen_testing_struct(1, 2);
+
+    THEN("They should share one node")
+    {
+      REQUIRE(std::as_const(e1).get() == std::as_const(e2).get());
+      test_constructed_equally(e1, e2);
+    }
+    THEN("Different expressions should still be different")
+    {
+      test_constructed_differently(e1, gen_testing_struct(1, 1));
+    }
+  }
+  GIVEN("A hash-consed expression that is written to")
+  {
+    expr2tc e1 = gen_ulong(42);
+    expr2tc e2 = gen_ulong(42);
+    to_constant_int2t(e2).value = BigInt(64);
+
+    THEN("Only the written copy should change")
+    {
+      REQUIRE(std::as_const(e1).get() != std::as_const(e2).get());
+      REQUIRE(to_constant_int2t(e1).value == 42);
+      REQUIRE(e2 == gen_ulong(64));
+      REQUIRE(e1 == gen_ulong(42));
+    }
+  }
+}
+
+SCENARIO("irep2 symbol keys", "[core][irep2]")
+{
+  GIVEN("Symbols renamed to every level")
+  {
+    type2tc t = get_uint_type(32);
+    std::vector<expr2tc> syms;
+    for (auto lev :
+         {symbol2t::level0,
+          symbol2t::level1,
+          symbol2t::level2,
+          symbol2t::level1_global,
+          symbol2t::level2_global})
+      for (unsigned n : {0, 1, 2})
+      {
+        syms.push_back(symbol2tc(t, "x", lev, n, 1, 0, 0));
+        syms.push_back(symbol2tc(t, "x", lev, 1, n, 0, 0));
+        syms.push_back(symbol2tc(t, "x", lev, 1, 1, n, 0));
+        syms.push_back(symbol2tc(t, "x", lev, 1, 1, 0, n));
+        syms.push_back(symbol2tc(t, "y", lev, n, n, n, n));
+      }
+
+    THEN("Keys should be equal exactly when names are")
+    {
+      for (const expr2tc &a : syms)
+        for (const expr2tc &b : syms)
+        {
+          const symbol2t &s1 = to_symbol2t(a), &s2 = to_symbol2t(b);
+          bool same_name = s1.get_symbol_name() == s2.get_symbol_name();
+          REQUIRE((s1.get_symbol_key() == s2.get_symbol_key()) == same_name);
+          if (same_name)
+            REQUIRE(
+              symbol_key_hash()(s1.get_symbol_key()) ==
+              symbol_key_hash()(s2.get_symbol_key()));
+        }
+    }
+  }
+}
+
+SCENARIO("irep2 simplification cache", "[core][irep2]")
+{
+  GIVEN("An expression with a subterm that simplifies")
+  {
+    type2tc t = get_uint_type(32);
+    auto num = [&t](unsigned n) { return constant_int2tc(t, BigInt(n)); };
+    expr2tc x = symbol2tc(t, "x");
+    expr2tc e = add2tc(t, x, add2tc(t, num(1), num(2)));
+
+    THEN("Simplifying it again should hit the cache")
+    {
+      expr2tc first = e.simplify();
+      simplify_cache_statst before = simplify_cache_stats();
+      expr2tc second = e.simplify();
+      simplify_cache_statst after = simplify_cache_stats();
+
+      REQUIRE(first == second);
+      REQUIRE(after.hits == before.hits + 1);
+      REQUIRE(after.misses == before.misses);
+    }
+
+    THEN("The answer should be the same without the cache")
+    {
+      expr2tc cached = e.simplify();
+      size_t old_size = irep2_simplify_cache_size;
+      irep2_simplify_cache_size = 0;
+      expr2tc uncached = e.simplify();
+      irep2_simplify_cache_size = old_size;
+
+      REQUIRE(cached == uncached);
+      REQUIRE(cached == add2tc(t, x, num(3)));
+    }
+
+    THEN("A full cache should drop old answers")
+    {
+      size_t old_size = irep2_simplify_cache_size;
+      irep2_simplify_cache_size = 4;
+      simplify_cache_statst before = simplify_cache_stats();
+      for (unsigned i = 0; i < 16; i++)
+        add2tc(t, x, num(i)).simplify();
+      irep2_simplify_cache_size = old_size;
+
+      REQUIRE(simplify_cache_stats().evicted > before.evicted);
+    }
+  }
+}
@@ -0,0 +1,114 @@
+/*******************************************************************\
+Module: Stress tests for sharing irep2 between threads
+\*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <irep2/irep2.h>
+#include <irep2/irep2_utils.h>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const unsigned num_threads = 8;
+const unsigned num_rounds = 2000;
+
+// ((0 + 1) + 2) + ... + (depth - 1)
+expr2tc gen_sum(unsigned depth)
+{
+  expr2tc sum = gen_ulong(0);
+  for (unsigned i = 1; i < depth; i++)
+    sum = add2tc(sum->type, sum, gen_ulong(i));
+  return sum;
+}
+
+// Runs f(thread number) on num_threads threads at once
+template <typename F>
+void hammer(F f)
+{
+  std::atomic_bool go = false;
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < num_threads; t++)
+    threads.emplace_back([&go, &f, t] {
+      while (!go)
+        std::this_thread::yield();
+      f(t);
+    });
+  go = true;
+  for (auto &thread : threads)
+    thread.join();
+}
+} // namespace
+
+SCENARIO("irep2 shared between threads", "[core][irep2]")
+{
+  GIVEN("An expression whose crc was never computed")
+  {
+    expr2tc shared = gen_sum(64);
+    size_t expected = shared->clone()->crc();
+
+    THEN("Threads computing it concurrently should all agree")
+    {
+      std::atomic<unsigned> mismatches = 0;
+      hammer([&](unsigned) {
+        if (shared.crc() != expected)
+          ++mismatches;
+      });
+      REQUIRE(mismatches == 0);
+      REQUIRE(shared.crc() == expected);
+    }
+  }
+
+  GIVEN("An expression that every thread copies and writes to")
+  {
+    expr2tc shared = gen_sum(16);
+    expr2tc original = shared->clone();
+    size_t expected = original.crc();
+
+    THEN("The shared expression should never change")
+    {
+      std::atomic<unsigned> mismatches = 0;
+      hammer([&](unsigned t) {
+        for (unsigned i = 0; i < num_rounds; i++)
+        {
+          expr2tc local = shared;
+          to_add2t(local).side_2 = gen_ulong(1000 + t);
+          if (local == shared || to_add2t(local).side_2 != gen_ulong(1000 + t))
+            ++mismatches;
+
+          // Writing deeper down detaches every node on the way. The new
+          // value must differ from every operand of gen_sum(16).
+          expr2tc &inner = to_add2t(local).side_1;
+          to_add2t(inner).side_2 = gen_ulong(100 + i);
+          if (to_add2t(std::as_const(shared)).side_1 == inner)
+            ++mismatches;
+        }
+      });
+      REQUIRE(mismatches == 0);
+      REQUIRE(shared == original);
+      REQUIRE(shared.crc() == expected);
+    }
+  }
+
+  GIVEN("Hash-consing turned on")
+  {
+    irep2_hash_consing = true;
+
+    THEN("Threads building the same expression should share one node")
+    {
+      std::vector<expr2tc> built(num_threads);
+      hammer([&](unsigned t) {
+        for (unsigned i = 0; i < num_rounds / 10; i++)
+          built[t] = gen_sum(16);
+      });
+      // Through const references, a non-const get() would detach
+      for (const auto &e : built)
+        REQUIRE(e.get() == std::as_const(built[0]).get());
+    }
+
+    irep2_hash_consing = false;
+  }
+}
@@ -0,0 +1,169 @@
+/// \file Tests for the And-Inverter Graph and its CNF encoding
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <solvers/sat/aig_conv.h>
+#include <vector>
+
+namespace
+{
+// Records clauses, and solves them by trying every assignment
+class brute_force_cnft : public cnf_iface
+{
+public:
+  literalt new_variable() override
+  {
+    return literalt(n_vars++, false);
+  }
+
+  void lcnf(const bvt &bv) override
+  {
+    clauses.push_back(bv);
+  }
+
+  tvt solve(const bvt &assumptions) override
+  {
+    REQUIRE(n_vars < 20);
+    for (unsigned m = 0; m < (1u << n_vars); m++)
+    {
+      model = m;
+      bool sat = true;
+      for (literalt a : assumptions)
+        sat = sat && holds(a);
+      for (const bvt &c : clauses)
+      {
+        bool some = false;
+        for (literalt l : c)
+          some = some || holds(l);
+        sat = sat && some;
+      }
+      if (sat)
+        return tvt(true);
+    }
+    return tvt(false);
+  }
+
+  tvt l_get(literalt a) override
+  {
+    return tvt(holds(a));
+  }
+
+  bool holds(literalt l) const
+  {
+    return ((model >> l.var_no()) & 1) != l.sign();
+  }
+
+  unsigned n_vars = 0;
+  unsigned model = 0;
+  std::vector<bvt> clauses;
+};
+} // namespace
+
+SCENARIO("aigt folds and shares gates", "[core][solvers][aig]")
+{
+  GIVEN("An AIG with two inputs")
+  {
+    aigt aig;
+    literalt a = aig.new_input();
+    literalt b = aig.new_input();
+
+    THEN("Constants and trivial operands should be folded")
+    {
+      REQUIRE(aig.mk_and(a, const_literal(true)) == a);
+      REQUIRE(aig.mk_and(a, const_literal(false)) == const_literal(false));
+      REQUIRE(aig.mk_and(a, a) == a);
+      REQUIRE(aig.mk_and(a, neg(a)) == const_literal(false));
+      REQUIRE(aig.mk_xor(a, a) == const_literal(false));
+      REQUIRE(aig.mk_ite(const_literal(true), a, b) == a);
+      REQUIRE(aig.mk_ite(a, b, b) == b);
+      REQUIRE(aig.size() == 2);
+    }
+
+    THEN("Operands of an AND should be simplified against its own operands")
+    {
+      literalt ab = aig.mk_and(a, b);
+      REQUIRE(aig.mk_and(ab, a) == ab);
+      REQUIRE(aig.mk_and(ab, neg(b)) == const_literal(false));
+      REQUIRE(aig.mk_and(neg(ab), neg(a)) == neg(a));
+      REQUIRE(aig.mk_and(neg(ab), a) == aig.mk_and(neg(b), a));
+    }
+
+    THEN("Asking for the same gate twice should give the same node")
+    {
+      literalt ab = aig.mk_and(a, b);
+      unsigned size = aig.size();
+      REQUIRE(aig.mk_and(b, a) == ab);
+      REQUIRE(aig.mk_xor(a, b) == aig.mk_xor(b, a));
+      REQUIRE(aig.mk_xor(neg(a), b) == neg(aig.mk_xor(a, b)));
+      // Only the xor is new: it reuses a & b
+      REQUIRE(aig.size() == size + 2);
+      REQUIRE(aig.shared_ands() > 0);
+    }
+  }
+}
+
+SCENARIO("aig_convt encodes only the polarities needed", "[core][solvers][aig]")
+{
+  GIVEN("An AND of two inputs")
+  {
+    brute_force_cnft cnf;
+    aig_convt conv(&cnf);
+    literalt a = conv.new_variable();
+    literalt b = conv.new_variable();
+    literalt ab = conv.land(a, b);
+
+    THEN("Asserting it should only make it imply its operands")
+    {
+      conv.assert_lit(ab);
+      // o -> a, o -> b, and the unit o
+      REQUIRE(cnf.clauses.size() == 3);
+      REQUIRE(cnf.clauses[0].size() == 2);
+      REQUIRE(cnf.clauses[1].size() == 2);
+
+      // The other polarity only adds the clause that was missing
+      conv.assert_lit(conv.lor(neg(ab), conv.new_variable()));
+      REQUIRE(cnf.clauses.size() == 3 + 3);
+      // Nothing new to encode the second time around
+      conv.assert_lit(ab);
+      REQUIRE(cnf.clauses.size() == 3 + 3 + 1);
+    }
+
+    THEN("Asserting its negation should only make the operands imply it")
+    {
+      conv.assert_lit(neg(ab));
+      REQUIRE(cnf.clauses.size() == 2);
+      REQUIRE(cnf.clauses[0].size() == 3);
+    }
+  }
+
+  GIVEN("An xor and an ite over three inputs")
+  {
+    brute_force_cnft cnf;
+    aig_convt conv(&cnf);
+    literalt a = conv.new_variable();
+    literalt b = conv.new_variable();
+    literalt c = conv.new_variable();
+    conv.assert_lit(conv.lxor(a, b));
+    conv.assert_lit(conv.lequal(conv.lselect(a, b, c), c));
+
+    THEN("Models should satisfy the circuit, not just the clauses")
+    {
+      REQUIRE(conv.solve({a}).is_true());
+      REQUIRE(conv.l_get(a).is_true());
+      REQUIRE(conv.l_get(b).is_false());
+      REQUIRE(conv.l_get(c).is_false());
+      REQUIRE(conv.l_get(conv.lxor(a, b)).is_true());
+
+      REQUIRE(conv.solve({neg(a)}).is_true());
+      REQUIRE(conv.l_get(b).is_true());
+    }
+
+    THEN("Contradictory assumptions should be unsatisfiable")
+    {
+      REQUIRE(conv.solve({a, b}).is_false());
+      REQUIRE(conv.solve({a, c}).is_false());
+      REQUIRE(conv.solve({const_literal(false)}).is_false());
+      REQUIRE(conv.solve({}).is_true());
+    }
+  }
+}
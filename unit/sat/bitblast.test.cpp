@@ -0,0 +1,292 @@
+/// \file Exhaustive tests of the bit-blasted bit-vector operations
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <solvers/sat/aig.h>
+#include <solvers/sat/bitblast_conv.h>
+#include <util/config.h>
+#include <util/context.h>
+#include <util/namespace.h>
+#include <util/options.h>
+#include <functional>
+#include <vector>
+
+namespace
+{
+const unsigned width = 4;
+const int modulus = 1 << width;
+
+// Builds the gates as an AIG, and solves by trying every value of the inputs
+// that the assumptions leave open. Fresh variables, such as the quotient and
+// remainder of a divider, are just more inputs.
+class brute_force_satt : public sat_iface
+{
+public:
+  literalt lnot(literalt a) override
+  {
+    return neg(a);
+  }
+
+  literalt lselect(literalt a, literalt b, literalt c) override
+  {
+    return aig.mk_ite(a, b, c);
+  }
+
+  literalt lequal(literalt a, literalt b) override
+  {
+    return aig.mk_eq(a, b);
+  }
+
+  literalt limplies(literalt a, literalt b) override
+  {
+    return aig.mk_implies(a, b);
+  }
+
+  literalt lxor(literalt a, literalt b) override
+  {
+    return aig.mk_xor(a, b);
+  }
+
+  literalt land(literalt a, literalt b) override
+  {
+    return aig.mk_and(a, b);
+  }
+
+  literalt lor(literalt a, literalt b) override
+  {
+    return aig.mk_or(a, b);
+  }
+
+  literalt new_variable() override
+  {
+    return aig.new_input();
+  }
+
+  void assert_lit(literalt a) override
+  {
+    asserted.push_back(a);
+  }
+
+  tvt solve(const bvt &assumptions) override
+  {
+    std::vector<int> fixed(aig.size(), -1);
+    for (literalt a : assumptions)
+    {
+      REQUIRE(aig.node(a.var_no()).is_input());
+      fixed[a.var_no()] = !a.sign();
+    }
+
+    std::vector<unsigned> open;
+    for (unsigned n = 0; n < aig.size(); n++)
+      if (aig.node(n).is_input() && fixed[n] < 0)
+        open.push_back(n);
+    REQUIRE(open.size() < 20);
+
+    for (unsigned m = 0; m < (1u << open.size()); m++)
+    {
+      for (unsigned i = 0; i < open.size(); i++)
+        fixed[open[i]] = (m >> i) & 1;
+      evaluate(fixed);
+
+      bool sat = true;
+      for (literalt a : asserted)
+        sat = sat && holds(a);
+      if (sat)
+        return tvt(true);
+    }
+    return tvt(false);
+  }
+
+  tvt l_get(literalt a) override
+  {
+    return tvt(holds(a));
+  }
+
+  aigt aig;
+  bvt asserted;
+
+private:
+  void evaluate(const std::vector<int> &inputs)
+  {
+    // Nodes come after their operands
+    values.resize(aig.size());
+    for (unsigned n = 0; n < aig.size(); n++)
+    {
+      const aigt::nodet &node = aig.node(n);
+      values[n] = node.is_input() ? inputs[n] == 1
+                                  : holds(node.a) && holds(node.b);
+    }
+  }
+
+  bool holds(literalt l) const
+  {
+    if (l.is_constant())
+      return l.is_true();
+    return values[l.var_no()] != l.sign();
+  }
+
+  std::vector<bool> values;
+};
+
+class test_blastert : public bitblast_convt
+{
+public:
+  test_blastert(const namespacet &ns, const optionst &options)
+    : bitblast_convt(ns, options, &sat)
+  {
+    boolean_sort = mk_bool_sort();
+  }
+
+  const std::string solver_text() override
+  {
+    return "brute force";
+  }
+
+  brute_force_satt sat;
+};
+
+typedef std::function<smt_astt(smt_convt &, smt_astt, smt_astt)> opt;
+
+// What an operation should give on two width-bit values, as unsigned
+typedef std::function<int(int, int)> referencet;
+
+int to_signed(int x)
+{
+  return x >= modulus / 2 ? x - modulus : x;
+}
+
+int wrap(int x)
+{
+  return ((x % modulus) + modulus) % modulus;
+}
+
+/* Checks op against ref on every pair of operands: once with both operands
+ * left to the solver, which exercises the general circuits, and once with
+ * the second one a constant, which takes the shortcuts for constants. */
+void check_binary(const opt &op, const referencet &ref)
+{
+  config.ansi_c.set_data_model(configt::ILP32);
+  contextt context;
+  namespacet ns(context);
+  optionst options;
+
+  {
+    test_blastert conv(ns, options);
+    smt_sortt sort = conv.mk_bv_sort(width);
+    smt_astt a = conv.mk_smt_symbol("a", sort);
+    smt_astt b = conv.mk_smt_symbol("b", sort);
+    smt_astt r = op(conv, a, b);
+
+    for (int x = 0; x < modulus; x++)
+      for (int y = 0; y < modulus; y++)
+      {
+        bvt assumptions;
+        for (unsigned i = 0; i < width; i++)
+        {
+          assumptions.push_back(
+            ((x >> i) & 1) ? conv.bits(a)[i] : neg(conv.bits(a)[i]));
+          assumptions.push_back(
+            ((y >> i) & 1) ? conv.bits(b)[i] : neg(conv.bits(b)[i]));
+        }
+        INFO("symbolic operands " << x << " and " << y);
+        REQUIRE(conv.sat.solve(assumptions).is_true());
+        REQUIRE(conv.get_bv(r, false) == ref(x, y));
+      }
+  }
+
+  for (int y = 0; y < modulus; y++)
+  {
+    test_blastert conv(ns, options);
+    smt_sortt sort = conv.mk_bv_sort(width);
+    smt_astt a = conv.mk_smt_symbol("a", sort);
+    smt_astt r = op(conv, a, conv.mk_smt_bv(BigInt(y), sort));
+
+    for (int x = 0; x < modulus; x++)
+    {
+      bvt assumptions;
+      for (unsigned i = 0; i < width; i++)
+        assumptions.push_back(
+          ((x >> i) & 1) ? conv.bits(a)[i] : neg(conv.bits(a)[i]));
+      INFO("symbolic operand " << x << " and constant " << y);
+      REQUIRE(conv.sat.solve(assumptions).is_true());
+      REQUIRE(conv.get_bv(r, false) == ref(x, y));
+    }
+  }
+}
+} // namespace
+
+SCENARIO("bit-blasted arithmetic is exact", "[core][solvers][bitblast]")
+{
+  THEN("Addition, subtraction and negation should wrap around")
+  {
+    check_binary(&smt_convt::mk_bvadd, [](int x, int y) { return wrap(x + y); });
+    check_binary(&smt_convt::mk_bvsub, [](int x, int y) { return wrap(x - y); });
+    check_binary(
+      [](smt_convt &c, smt_astt a, smt_astt) { return c.mk_bvneg(a); },
+      [](int x, int) { return wrap(-x); });
+  }
+
+  THEN("Multiplication should keep the low bits of the product")
+  {
+    check_binary(&smt_convt::mk_bvmul, [](int x, int y) { return wrap(x * y); });
+  }
+
+  THEN("Unsigned division by zero should give all ones and keep the dividend")
+  {
+    check_binary(&smt_convt::mk_bvudiv, [](int x, int y) {
+      return y == 0 ? modulus - 1 : x / y;
+    });
+    check_binary(
+      &smt_convt::mk_bvumod, [](int x, int y) { return y == 0 ? x : x % y; });
+  }
+
+  THEN("Signed division should truncate towards zero")
+  {
+    // INT_MIN / -1 overflows back to INT_MIN, with no remainder. Division by
+    // zero gives -1 for a non-negative dividend and 1 for a negative one.
+    check_binary(&smt_convt::mk_bvsdiv, [](int x, int y) {
+      int sx = to_signed(x), sy = to_signed(y);
+      if (sy == 0)
+        return wrap(sx < 0 ? 1 : -1);
+      return wrap(sx / sy);
+    });
+    check_binary(&smt_convt::mk_bvsmod, [](int x, int y) {
+      int sx = to_signed(x), sy = to_signed(y);
+      return wrap(sy == 0 ? sx : sx % sy);
+    });
+  }
+}
+
+SCENARIO("bit-blasted shifts are exact", "[core][solvers][bitblast]")
+{
+  THEN("Shifting by the width or more should shift everything out")
+  {
+    check_binary(&smt_convt::mk_bvshl, [](int x, int y) {
+      return y >= (int)width ? 0 : wrap(x << y);
+    });
+    check_binary(&smt_convt::mk_bvlshr, [](int x, int y) {
+      return y >= (int)width ? 0 : x >> y;
+    });
+    check_binary(&smt_convt::mk_bvashr, [](int x, int y) {
+      int sx = to_signed(x);
+      return wrap(y >= (int)width ? (sx < 0 ? -1 : 0) : sx >> y);
+    });
+  }
+}
+
+SCENARIO("bit-blasted comparisons are exact", "[core][solvers][bitblast]")
+{
+  THEN("Unsigned and signed orders should be told apart")
+  {
+    check_binary(&smt_convt::mk_bvult, [](int x, int y) { return x < y; });
+    check_binary(&smt_convt::mk_bvule, [](int x, int y) { return x <= y; });
+    check_binary(&smt_convt::mk_bvslt, [](int x, int y) {
+      return to_signed(x) < to_signed(y);
+    });
+    check_binary(&smt_convt::mk_bvsle, [](int x, int y) {
+      return to_signed(x) <= to_signed(y);
+    });
+    check_binary(&smt_convt::mk_eq, [](int x, int y) { return x == y; });
+    check_binary(&smt_convt::mk_neq, [](int x, int y) { return x != y; });
+  }
+}
@@ -186,7 +186,7 @@ program goto_factory::get_goto_functions(cmdlinet &cmd, optionst &opts)
 {
   goto_functionst goto_functions;
   language_uit lui(cmd);
-  migrate_namespace_lookup = new namespacet(lui.context);
+  set_migrate_namespace(new namespacet(lui.context));
   if (!goto_factory::parse(lui))
   {
     return program(lui.context, goto_functions);
@@ -0,0 +1,150 @@
+/// \file Tests for the on-disk verification cache
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <goto-symex/slice.h>
+#include <util/cache.h>
+#include <util/context.h>
+#include <util/filesystem.h>
+#include <util/namespace.h>
+#include <util/options.h>
+#include <irep2/irep2_utils.h>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <utility>
+
+namespace
+{
+/* A program with a function under test, whose claim is checked, and an
+ * unrelated function with a claim of its own. Symex numbers the L2 copies
+ * of each symbol from \p node, as a run that took another path before
+ * would. */
+class programt
+{
+public:
+  programt(unsigned node, int tested_value, int unrelated_value)
+    : eq(ns)
+  {
+    expr2tc x = next("x", node), y = next("y", node);
+    assign(x, gen_long(tested_value));
+    assign(y, gen_long(unrelated_value));
+    claim(equality2tc(x, gen_long(1)));
+    claim(equality2tc(y, gen_long(2)));
+  }
+
+  /// Key of the claim_nr-th claim, sliced for it as bmct does
+  std::string key(const verification_cachet &cache, size_t claim_nr) const
+  {
+    const auto &steps = std::as_const(eq.SSA_steps);
+    std::vector<bool> claim_ignore = eq.ignore_bits();
+    claim_slicer(claim_nr).run(steps, claim_ignore);
+    symex_slicet(options).run(steps, claim_ignore);
+    return cache.key(steps, claim_ignore);
+  }
+
+private:
+  static expr2tc gen_long(int v)
+  {
+    return constant_int2tc(get_int_type(32), BigInt(v));
+  }
+
+  static expr2tc next(const char *name, unsigned node)
+  {
+    return symbol2tc(
+      get_int_type(32), name, symbol2t::level2, 1, 2, 0, node + 1);
+  }
+
+  void assign(const expr2tc &lhs, const expr2tc &rhs)
+  {
+    symex_target_equationt::SSA_stept &step = eq.SSA_steps.emplace_back();
+    step.type = goto_trace_stept::ASSIGNMENT;
+    step.guard = gen_true_expr();
+    step.lhs = lhs;
+    step.original_lhs = lhs;
+    step.rhs = rhs;
+    step.cond = equality2tc(lhs, rhs);
+  }
+
+  void claim(const expr2tc &cond)
+  {
+    symex_target_equationt::SSA_stept &step = eq.SSA_steps.emplace_back();
+    step.type = goto_trace_stept::ASSERT;
+    step.guard = gen_true_expr();
+    step.cond = cond;
+  }
+
+  contextt context;
+  namespacet ns{context};
+  optionst options;
+  symex_target_equationt eq;
+};
+
+struct cache_dirt
+{
+  file_operations::tmp_path dir =
+    file_operations::create_tmp_dir("esbmc-cache-test-%%%%-%%%%");
+};
+} // namespace
+
+SCENARIO("the verification cache reuses verdicts", "[core][util][cache]")
+{
+  cache_dirt tmp;
+  optionst options;
+  verification_cachet cache(tmp.dir.path(), options);
+
+  GIVEN("A claim proven by a first run")
+  {
+    std::string key = programt(0, 1, 2).key(cache, 1);
+    REQUIRE(cache.lookup(key).is_unknown());
+    cache.store(key, true);
+
+    THEN("A second run of the same program should hit the cache")
+    {
+      // Another process, whose symex numbered the symbols differently
+      verification_cachet second(tmp.dir.path(), options);
+      std::string again = programt(10, 1, 2).key(second, 1);
+      REQUIRE(again == key);
+      REQUIRE(second.lookup(again).is_true());
+    }
+
+    THEN("Editing an unrelated function should keep the key")
+    {
+      REQUIRE(programt(0, 1, 3).key(cache, 1) == key);
+    }
+
+    THEN("Editing the cone of the claim should miss the cache")
+    {
+      std::string edited = programt(0, 5, 2).key(cache, 1);
+      REQUIRE(edited != key);
+      REQUIRE(cache.lookup(edited).is_unknown());
+    }
+
+    THEN("Changing an option that affects the encoding should miss the cache")
+    {
+      optionst other;
+      other.set_option("int-encoding", true);
+      verification_cachet ir(tmp.dir.path(), other);
+      std::string ir_key = programt(0, 1, 2).key(ir, 1);
+      REQUIRE(ir_key != key);
+      REQUIRE(ir.lookup(ir_key).is_unknown());
+    }
+  }
+
+  GIVEN("A corrupted entry")
+  {
+    std::string key = programt(0, 1, 2).key(cache, 1);
+    std::ofstream((boost::filesystem::path(tmp.dir.path()) / key).string())
+      << "garbage\n";
+
+    THEN("It should be ignored")
+    {
+      REQUIRE(cache.lookup(key).is_unknown());
+    }
+
+    THEN("Storing the verdict again should replace it")
+    {
+      cache.store(key, false);
+      REQUIRE(cache.lookup(key).is_false());
+    }
+  }
+}
@@ -0,0 +1,131 @@
+/// \file Tests for the chunked, copy-on-write sequence
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/chunked_vector.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Small chunks, so that a few elements already span several of them
+typedef chunked_vectort<std::string, 2> vectort;
+
+vectort make(unsigned n)
+{
+  vectort v;
+  for (unsigned i = 0; i < n; i++)
+    v.push_back(std::to_string(i));
+  return v;
+}
+
+std::vector<std::string> contents(const vectort &v)
+{
+  return std::vector<std::string>(v.begin(), v.end());
+}
+} // namespace
+
+SCENARIO("chunked_vectort behaves like a vector", "[core][util][chunked]")
+{
+  GIVEN("A sequence spanning several chunks")
+  {
+    vectort v = make(10);
+    const std::string *first = &v[0];
+
+    THEN("Indexing and iteration should agree")
+    {
+      REQUIRE(v.size() == 10);
+      REQUIRE(v.front() == "0");
+      REQUIRE(v.back() == "9");
+      for (unsigned i = 0; i < 10; i++)
+      {
+        REQUIRE(v[i] == std::to_string(i));
+        REQUIRE(*(v.begin() + i) == v[i]);
+      }
+      REQUIRE(v.end() - v.begin() == 10);
+      REQUIRE(std::distance(v.begin(), v.end()) == 10);
+    }
+
+    THEN("Growing it should not move the elements")
+    {
+      for (unsigned i = 0; i < 100; i++)
+        v.emplace_back("x");
+      REQUIRE(&v[0] == first);
+      REQUIRE(v.size() == 110);
+    }
+
+    THEN("Erasing should shift the elements after it")
+    {
+      v.erase(v.begin() + 2, v.begin() + 7);
+      REQUIRE(
+        contents(v) == std::vector<std::string>{"0", "1", "7", "8", "9"});
+      v.erase(v.begin());
+      v.erase(v.end() - 1);
+      REQUIRE(contents(v) == std::vector<std::string>{"1", "7", "8"});
+    }
+
+    THEN("The standard algorithms should work on it")
+    {
+      v.erase(
+        std::remove_if(
+          v.begin(),
+          v.end(),
+          [](const std::string &s) { return (s[0] - '0') % 2 == 0; }),
+        v.end());
+      REQUIRE(
+        contents(v) == std::vector<std::string>{"1", "3", "5", "7", "9"});
+      std::reverse(v.begin(), v.end());
+      REQUIRE(v.front() == "9");
+    }
+
+    THEN("Popping every element should leave it empty")
+    {
+      while (!v.empty())
+        v.pop_back();
+      REQUIRE(v.size() == 0);
+      v.push_back("again");
+      REQUIRE(contents(v) == std::vector<std::string>{"again"});
+    }
+  }
+}
+
+SCENARIO("chunked_vectort copies share chunks", "[core][util][chunked]")
+{
+  GIVEN("A sequence and a copy of it")
+  {
+    vectort v = make(10);
+    vectort copy = v;
+
+    THEN("Reading the copy should not duplicate anything")
+    {
+      const vectort &c = copy;
+      REQUIRE(&c[5] == &std::as_const(v)[5]);
+      REQUIRE(&*c.begin() == &*std::as_const(v).begin());
+    }
+
+    THEN("Writing to the copy should only duplicate the chunk written to")
+    {
+      copy[5] = "five";
+      REQUIRE(v[5] == "5");
+      REQUIRE(copy[5] == "five");
+      REQUIRE(&std::as_const(copy)[0] == &std::as_const(v)[0]);
+      REQUIRE(&std::as_const(copy)[5] != &std::as_const(v)[5]);
+    }
+
+    THEN("Growing and shrinking the copy should not change the original")
+    {
+      copy.push_back("10");
+      copy.pop_back();
+      copy.pop_back();
+      copy.erase(copy.begin());
+      v.push_back("more");
+      REQUIRE(copy.size() == 8);
+      REQUIRE(copy.front() == "1");
+      REQUIRE(v.size() == 11);
+      REQUIRE(v[8] == "8");
+      REQUIRE(v[9] == "9");
+    }
+  }
+}
@@ -0,0 +1,68 @@
+/// \file Tests for the symbol table
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/context.h>
+#include <util/namespace.h>
+#include <util/rename.h>
+
+namespace
+{
+symbolt make_symbol(const std::string &id)
+{
+  symbolt s;
+  s.id = id;
+  s.name = id;
+  return s;
+}
+} // namespace
+
+SCENARIO("contextt::get_max finds numbered names", "[core][util][context]")
+{
+  GIVEN("A context with some numbered symbols")
+  {
+    contextt context;
+    for (const char *id : {"x", "x_1", "x_12", "x_3", "y_7", "x_4_z", "x_"})
+      REQUIRE(!context.add(make_symbol(id)));
+
+    THEN("The largest number after a prefix should be found")
+    {
+      REQUIRE(context.get_max("x_") == 12);
+      REQUIRE(context.get_max("x_1") == 2);
+      REQUIRE(context.get_max("y_") == 7);
+      REQUIRE(context.get_max("z_") == 0);
+      REQUIRE(context.get_max("x_4_") == 0);
+    }
+
+    THEN("Erasing symbols should be taken into account")
+    {
+      context.erase_symbol("x_12");
+      REQUIRE(context.get_max("x_") == 3);
+      REQUIRE(context.get_max("x_1") == 0);
+      context.erase_symbol("y_7");
+      REQUIRE(context.get_max("y_") == 0);
+    }
+
+    THEN("Moved symbols should be indexed too")
+    {
+      symbolt s = make_symbol("x_40");
+      REQUIRE(!context.move(s));
+      REQUIRE(context.get_max("x_") == 40);
+    }
+
+    THEN("Fresh names should not clash")
+    {
+      namespacet ns(context);
+      irep_idt name = "x";
+      get_new_name(name, ns);
+      REQUIRE(name == "x_13");
+      REQUIRE(!context.find_symbol(name));
+    }
+
+    THEN("Clearing the context should clear the index")
+    {
+      context.clear();
+      REQUIRE(context.get_max("x_") == 0);
+    }
+  }
+}
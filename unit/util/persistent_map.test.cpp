@@ -0,0 +1,156 @@
+/// \file Tests for the structurally shared hash map
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/persistent_map.h>
+#include <map>
+#include <random>
+
+namespace
+{
+typedef persistent_mapt<unsigned, unsigned> mapt;
+
+// Every key collides, which exercises the collision lists
+struct bad_hash
+{
+  size_t operator()(unsigned) const
+  {
+    return 42;
+  }
+};
+
+template <class Map>
+std::map<unsigned, unsigned> contents(const Map &m)
+{
+  std::map<unsigned, unsigned> result;
+  for (const auto &[k, v] : m)
+    result.emplace(k, v);
+  return result;
+}
+
+template <class Map>
+std::map<unsigned, std::pair<int, int>> differences(const Map &a, const Map &b)
+{
+  std::map<unsigned, std::pair<int, int>> result;
+  a.for_each_difference(
+    b, [&result](unsigned k, const unsigned *x, const unsigned *y) {
+      result.emplace(k, std::make_pair(x ? int(*x) : -1, y ? int(*y) : -1));
+    });
+  return result;
+}
+} // namespace
+
+SCENARIO("persistent_mapt behaves like a map", "[core][util][persistent_map]")
+{
+  GIVEN("A map and a reference map under random updates")
+  {
+    mapt m;
+    std::map<unsigned, unsigned> reference;
+    std::mt19937 gen(1);
+
+    for (unsigned i = 0; i < 20000; i++)
+    {
+      unsigned k = gen() % 2000;
+      switch (gen() % 3)
+      {
+      case 0:
+        m[k] = i;
+        reference[k] = i;
+        break;
+      case 1:
+        REQUIRE(m.insert({k, i}).second == reference.emplace(k, i).second);
+        break;
+      case 2:
+        REQUIRE(m.erase(k) == reference.erase(k));
+        break;
+      }
+    }
+
+    THEN("They should hold the same entries")
+    {
+      REQUIRE(m.size() == reference.size());
+      REQUIRE(contents(m) == reference);
+      for (unsigned k = 0; k < 2000; k++)
+      {
+        auto it = m.find(k);
+        REQUIRE((it != m.end()) == (reference.count(k) == 1));
+        if (it != m.end())
+          REQUIRE(it->second == reference[k]);
+      }
+    }
+  }
+
+  GIVEN("A map whose keys all collide")
+  {
+    persistent_mapt<unsigned, unsigned, bad_hash> m;
+    for (unsigned k = 0; k < 10; k++)
+      m[k] = k;
+    m.erase(3);
+
+    THEN("Lookups should still find the right entries")
+    {
+      REQUIRE(m.size() == 9);
+      REQUIRE(m.count(3) == 0);
+      REQUIRE(m.find(7)->second == 7);
+      REQUIRE(contents(m).size() == 9);
+    }
+  }
+}
+
+SCENARIO(
+  "persistent_mapt copies share structure",
+  "[core][util][persistent_map]")
+{
+  GIVEN("A map and a copy of it")
+  {
+    mapt m;
+    for (unsigned k = 0; k < 1000; k++)
+      m[k] = k;
+    mapt copy = m;
+
+    THEN("Writing to the copy should not change the original")
+    {
+      copy[5] = 500;
+      copy.erase(6);
+      copy[2000] = 1;
+      REQUIRE(m.find(5)->second == 5);
+      REQUIRE(m.count(6) == 1);
+      REQUIRE(m.count(2000) == 0);
+      REQUIRE(m.size() == 1000);
+      REQUIRE(copy.size() == 1000);
+    }
+
+    THEN("Differences should only report what was written")
+    {
+      REQUIRE(differences(m, copy).empty());
+
+      copy[5] = 500;
+      copy.erase(6);
+      copy[2000] = 1;
+      auto diff = differences(m, copy);
+      REQUIRE(diff.size() == 3);
+      REQUIRE(diff[5] == std::make_pair(5, 500));
+      REQUIRE(diff[6] == std::make_pair(6, -1));
+      REQUIRE(diff[2000] == std::make_pair(-1, 1));
+    }
+  }
+
+  GIVEN("Two maps built separately")
+  {
+    mapt a, b;
+    for (unsigned k = 0; k < 100; k++)
+    {
+      a[k] = k;
+      b[k + 50] = k + 50;
+    }
+
+    THEN("Differences should cover every key but with matching values")
+    {
+      auto diff = differences(a, b);
+      REQUIRE(diff.size() == 150);
+      REQUIRE(diff[10] == std::make_pair(10, -1));
+      REQUIRE(diff[60] == std::make_pair(60, 60));
+      REQUIRE(diff[120] == std::make_pair(-1, 120));
+    }
+  }
+}
@@ -0,0 +1,92 @@
+/// \file Tests for the state hashing fingerprints
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <util/state_fingerprint.h>
+#include <random>
+#include <set>
+#include <utility>
+
+SCENARIO(
+  "state_fingerprintt sums are updated incrementally",
+  "[core][util][fingerprint]")
+{
+  GIVEN("The fingerprints of a few variables")
+  {
+    state_fingerprintt x1 = state_fingerprintt::of(1, 10);
+    state_fingerprintt x2 = state_fingerprintt::of(1, 20);
+    state_fingerprintt y1 = state_fingerprintt::of(2, 10);
+
+    THEN("Swapping key and value should give a different fingerprint")
+    {
+      REQUIRE(state_fingerprintt::of(10, 1) != x1);
+      REQUIRE(x1 != x2);
+      REQUIRE(x1 != y1);
+    }
+
+    THEN("The sum shouldn't depend on the order of the assignments")
+    {
+      state_fingerprintt a, b;
+      a += x1;
+      a += y1;
+      b += y1;
+      b += x1;
+      REQUIRE(a == b);
+    }
+
+    THEN("Replacing a value should match assigning it in the first place")
+    {
+      state_fingerprintt a, b;
+      a += x1;
+      a += y1;
+      a -= x1;
+      a += x2;
+      b += y1;
+      b += x2;
+      REQUIRE(a == b);
+    }
+  }
+}
+
+SCENARIO("fingerprint_sett behaves like a set", "[core][util][fingerprint]")
+{
+  GIVEN("A set and a reference set under random insertions")
+  {
+    fingerprint_sett s;
+    std::set<std::pair<uint64_t, uint64_t>> reference;
+    std::mt19937_64 gen(1);
+
+    for (unsigned i = 0; i < 20000; i++)
+    {
+      state_fingerprintt f = state_fingerprintt::of(gen() % 5000, 0);
+      bool inserted = reference.emplace(f.lo, f.hi).second;
+      REQUIRE(s.insert(f) == inserted);
+    }
+
+    THEN("They should hold the same fingerprints")
+    {
+      REQUIRE(s.size() == reference.size());
+      for (uint64_t k = 0; k < 10000; k++)
+      {
+        state_fingerprintt f = state_fingerprintt::of(k, 0);
+        REQUIRE(s.contains(f) == (reference.count({f.lo, f.hi}) == 1));
+      }
+    }
+  }
+
+  GIVEN("An empty set")
+  {
+    fingerprint_sett s;
+
+    THEN("The zero fingerprint should be stored like any other")
+    {
+      REQUIRE(!s.contains(state_fingerprintt()));
+      REQUIRE(s.insert(state_fingerprintt()));
+      REQUIRE(!s.insert(state_fingerprintt()));
+      REQUIRE(s.contains(state_fingerprintt()));
+      REQUIRE(s.size() == 1);
+      s.clear();
+      REQUIRE(!s.contains(state_fingerprintt()));
+    }
+  }
+}